@@ -3,18 +3,46 @@
 #include "Dispatchable.h"
 
 #include <Babylon/JsRuntime.h>
+#include <Babylon/StartupTrace.h>
 
 #include <napi/utilities.h>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 #include <functional>
 #include <exception>
 
 namespace Babylon
 {
+    class PooledAllocator;
+    class GCRecorder;
+    class InterruptQueue;
+
     class AppRuntime final
     {
     public:
+        // A dispatched callback that ran longer than Options::LongTaskThreshold.
+        struct LongTask
+        {
+            // Time from the start of the callback until it and the microtasks it
+            // queued finished.
+            std::chrono::nanoseconds Duration{};
+
+            // JavaScript stack captured once the threshold was crossed. Empty when
+            // the engine can't be interrupted (only V8 and QuickJS can) or no script
+            // was running at that point.
+            std::string Stack{};
+
+            // Whether the callback was stopped for exceeding
+            // Options::ExecutionTimeLimit.
+            bool Terminated{};
+        };
+
         class Options
         {
         public:
@@ -26,6 +54,224 @@ namespace Babylon
 
             // Waits for the debugger to be attached before the execution of any script. Only implemented for V8.
             bool WaitForDebugger{false};
+
+            // Engine tuning. A value of zero (or an empty string) keeps the engine's
+            // default. Each setting lists the engines that honor it; the others
+            // ignore it. The JSI build ignores all of them, since v8jsi creates
+            // and configures its isolate itself.
+
+            // Initial size of the garbage-collected heap, in bytes. V8 and Hermes.
+            size_t InitialHeapSize{0};
+
+            // Maximum size of the garbage-collected heap, in bytes. V8, Hermes, QuickJS
+            // (enforced by the runtime's allocator) and Chakra (as the runtime memory
+            // limit).
+            size_t MaxHeapSize{0};
+
+            // Bytes allocated between garbage collections. QuickJS.
+            size_t GCThreshold{0};
+
+            // Maximum stack size of the JavaScript thread, in bytes. Must not exceed
+            // the thread's actual stack. V8 and QuickJS.
+            size_t MaxStackSize{0};
+
+            // Flags for v8::V8::SetFlagsFromString, e.g. "--max-lazy". V8 flags are
+            // process-wide and frozen once V8 is initialized, so only the first
+            // AppRuntime created in a process applies them.
+            std::string V8Flags{};
+
+            // Whether the engine may generate native code. Disabling it trades speed
+            // for lower memory use and startup cost. V8 (--jitless, process-wide
+            // like V8Flags) and Chakra.
+            bool EnableJIT{true};
+
+            // Whether Atomics.wait may block the JavaScript thread, which is how a
+            // runtime waits on memory shared with others through SharedMemory.
+            // Runtimes whose thread must stay responsive can turn it off, making
+            // Atomics.wait throw. V8 and QuickJS; the other engines don't expose
+            // SharedArrayBuffers over shared memory.
+            bool AllowAtomicsWait{true};
+
+            // Called when the heap is about to exceed its limit, with the current and
+            // initial limits in bytes. Returns the new limit: a larger value lets the
+            // allocation proceed, while returning the current limit lets the engine
+            // fail it (V8 aborts the process, QuickJS throws an out-of-memory error).
+            // Runs on the JavaScript thread in the middle of an allocation, so it must
+            // not call into JavaScript. V8, and QuickJS when MaxHeapSize is set.
+            std::function<size_t(size_t currentLimit, size_t initialLimit)> NearHeapLimitCallback{};
+
+            // Idle-time garbage collection. Once nothing has been dispatched for
+            // IdleGCInterval, the engine gets up to IdleGCBudget to collect garbage,
+            // and does so again only after more work has been dispatched. Zero
+            // disables it. V8 runs its idle-time GC tasks (idle task support is
+            // process-wide like V8Flags), Chakra runs JsIdle, and the other engines
+            // run a regular collection, which ignores the budget.
+            std::chrono::milliseconds IdleGCInterval{0};
+            std::chrono::milliseconds IdleGCBudget{10};
+
+            // Long-task watchdog. Dispatched callbacks running longer than
+            // LongTaskThreshold are reported to LongTaskHandler on the JavaScript
+            // thread once they finish. Callbacks still running after
+            // ExecutionTimeLimit are terminated (V8, QuickJS and Chakra), which
+            // surfaces as an error through UnhandledExceptionHandler; the runtime
+            // keeps running later work. Zero disables either limit.
+            std::chrono::milliseconds LongTaskThreshold{0};
+            std::function<void(const LongTask&)> LongTaskHandler{};
+            std::chrono::milliseconds ExecutionTimeLimit{0};
+
+            // Records the timings returned by GetDispatchMetrics. Off by default to
+            // keep clock reads out of every dispatch.
+            bool EnableDispatchMetrics{false};
+        };
+
+        enum class MemoryPressureLevel
+        {
+            // Reclaim memory that is cheap to give back.
+            Moderate,
+            // Reclaim as much memory as possible, even at the cost of a long pause.
+            Critical,
+        };
+
+        // Counters for the runtime's pooled allocator. On V8 it backs ArrayBuffer
+        // storage, except in builds with the V8 sandbox (64-bit, other than
+        // Android), which need V8's own allocator; on QuickJS it serves every
+        // allocation the runtime makes. The other engines manage this memory
+        // themselves and report zeros.
+        struct AllocatorStatistics
+        {
+            // Bytes currently allocated, and the most there have been at once.
+            size_t BytesInUse{};
+            size_t PeakBytesInUse{};
+
+            // Bytes held in free lists, ready to be reused.
+            size_t BytesPooled{};
+
+            // Number of allocations, and how many of those reused a pooled block.
+            uint64_t Allocations{};
+            uint64_t PoolHits{};
+        };
+
+        // Garbage collection events. V8 and Hermes report every collection, Chakra
+        // only reports that a collection is starting, and QuickJS only reports the
+        // collections AppRuntime itself requests (memory pressure, idle time).
+        // JavaScriptCore reports none.
+        enum class GCKind
+        {
+            // Young-generation collection.
+            Minor,
+            // Full or old-generation collection.
+            Major,
+            // Any other pause the engine reports, e.g. finishing incremental marking.
+            Other,
+        };
+
+        enum class GCPhase
+        {
+            Start,
+            End,
+        };
+
+        struct GCEvent
+        {
+            GCPhase Phase{};
+            GCKind Kind{};
+            // Length of the pause. Only set for End events.
+            std::chrono::nanoseconds Duration{};
+        };
+
+        struct GCStatistics
+        {
+            static constexpr size_t PauseBucketCount{12};
+
+            // Upper bounds of the pause histogram buckets. The last bucket counts
+            // the pauses longer than the last bound.
+            static constexpr std::array<std::chrono::microseconds, PauseBucketCount - 1> PauseBucketBounds{
+                std::chrono::microseconds{100},
+                std::chrono::microseconds{250},
+                std::chrono::microseconds{500},
+                std::chrono::milliseconds{1},
+                std::chrono::milliseconds{2},
+                std::chrono::milliseconds{4},
+                std::chrono::milliseconds{8},
+                std::chrono::milliseconds{16},
+                std::chrono::milliseconds{32},
+                std::chrono::milliseconds{64},
+                std::chrono::milliseconds{128},
+            };
+
+            // Collections that have started.
+            uint64_t Collections{};
+
+            // Pauses that have ended, by duration.
+            std::array<uint64_t, PauseBucketCount> PauseHistogram{};
+            std::chrono::nanoseconds TotalPause{};
+            std::chrono::nanoseconds LongestPause{};
+        };
+
+        // Histogram of durations with power-of-two buckets: bucket i counts
+        // durations under 2^i microseconds that didn't fit an earlier bucket, and
+        // the last bucket counts everything longer.
+        struct DurationHistogram
+        {
+            static constexpr size_t BucketCount{24};
+
+            std::array<uint64_t, BucketCount> Buckets{};
+            uint64_t Count{};
+            std::chrono::nanoseconds Total{};
+            std::chrono::nanoseconds Max{};
+
+            // Estimates a percentile (0 to 100) as the upper bound of the bucket it
+            // falls in, capped at Max. Zero when the histogram is empty.
+            std::chrono::nanoseconds Percentile(double percentile) const;
+        };
+
+        struct DispatchMetrics
+        {
+            // From Dispatch until the callback starts running.
+            DurationHistogram QueueLatency{};
+            // Running the callback itself.
+            DurationHistogram Execution{};
+            // Draining the microtasks the callback queued (only QuickJS and Hermes
+            // drain explicitly; on the other engines this is near zero).
+            DurationHistogram MicrotaskDrain{};
+
+            // Dispatched callbacks that haven't started yet, and the most there
+            // have been at once.
+            size_t QueueDepth{};
+            size_t MaxQueueDepth{};
+        };
+
+    private:
+        class ContextState;
+        class ContextLink;
+
+    public:
+        // Another JavaScript environment hosted by this runtime: a global object
+        // and polyfill state of its own, sharing the engine instance (the V8
+        // isolate or QuickJS runtime), its heap and compiled code, and the
+        // JavaScript thread. Callbacks dispatched to it are queued with the
+        // runtime's own, in order. Should be destroyed before the runtime; the
+        // ones that aren't are torn down with it, and destroying or
+        // dispatching to them afterwards does nothing.
+        class Context final
+        {
+        public:
+            // Tears the environment down on the JavaScript thread, after what
+            // was dispatched to it. Callbacks dispatched to it later are dropped.
+            ~Context();
+
+            Context(const Context&) = delete;
+            Context& operator=(const Context&) = delete;
+
+            void Dispatch(Dispatchable<void(Napi::Env)> callback);
+
+        private:
+            friend class AppRuntime;
+
+            Context(AppRuntime& runtime);
+
+            std::shared_ptr<ContextLink> m_link;
+            std::shared_ptr<ContextState> m_state;
         };
 
         AppRuntime();
@@ -45,6 +291,60 @@ namespace Babylon
 
         void Dispatch(Dispatchable<void(Napi::Env)> callback);
 
+        // Runs `callback` on the JavaScript thread as soon as possible, without
+        // waiting for the script that is currently running to return. V8 and
+        // QuickJS run it at the next safe point inside the script, so it must not
+        // run JavaScript itself; the other engines run it like a dispatched
+        // callback, after the work already queued. Safe to call from any thread.
+        void RequestInterrupt(Dispatchable<void(Napi::Env)> callback);
+
+        // Starts shutting the runtime down without waiting for it: queued
+        // callbacks are dropped, and the script that is currently running is
+        // aborted like one that exceeds Options::ExecutionTimeLimit, so that
+        // destroying the runtime afterwards doesn't wait on it. Only V8 and
+        // QuickJS can abort running script, and Chakra when ExecutionTimeLimit
+        // is set. Nothing can be dispatched to the runtime afterwards. Safe to
+        // call from any thread.
+        void Terminate();
+
+        // Safe to call from any thread.
+        AllocatorStatistics GetAllocatorStatistics() const;
+
+        // Asks the runtime to give memory back, e.g. when the host is running low.
+        // Once the current callback finishes, the engine collects garbage on the
+        // JavaScript thread and pooled allocator blocks are released.
+        // Safe to call from any thread.
+        void NotifyMemoryPressure(MemoryPressureLevel level);
+
+        // Registers a handler for GC events and returns an id for unsubscribing.
+        // Handlers may run on an engine GC thread in the middle of a collection, so
+        // they must be quick and must not call into JavaScript. Pauses are also
+        // traced as GC::Minor, GC::Major and GC::Other regions when tracing is
+        // enabled (see PerfTrace). Safe to call from any thread.
+        uint32_t SubscribeToGCEvents(std::function<void(const GCEvent&)> handler);
+        void UnsubscribeFromGCEvents(uint32_t subscription);
+
+        // Safe to call from any thread.
+        GCStatistics GetGCStatistics() const;
+
+        // Empty unless Options::EnableDispatchMetrics is set. Safe to call from any
+        // thread.
+        DispatchMetrics GetDispatchMetrics() const;
+
+        // How long each startup phase took: engine initialization, context
+        // creation, JsRuntime::CreateForJavaScript, and then every polyfill
+        // initialization and ScriptLoader fetch and evaluation recorded for the
+        // environment (see StartupTrace). Safe to call from any thread.
+        std::vector<StartupTrace::Phase> GetStartupReport() const;
+
+        // Whether CreateContext is supported by the engine: V8 and QuickJS.
+        static bool BABYLON_API SupportsContexts();
+
+        // Creates a Context, which is ready for callbacks to be dispatched to it
+        // right away. Throws on engines that don't support it. Safe to call from
+        // any thread.
+        std::unique_ptr<Context> CreateContext();
+
         // Default unhandled exception handler that outputs the error message to the program output.
         static void BABYLON_API DefaultUnhandledExceptionHandler(const Napi::Error& error);
 
@@ -76,8 +376,58 @@ namespace Babylon
         // queue explicitly (Napi::DrainJobs / JS_ExecutePendingJob).
         void DrainMicrotasks(Napi::Env env);
 
+        // Engine-specific hook called on the JavaScript thread by
+        // NotifyMemoryPressure to run the engine's garbage collector.
+        void ReclaimMemory(Napi::Env env, MemoryPressureLevel level);
+
+        // Engine-specific hook called on the JavaScript thread once the dispatch
+        // queue has been idle for Options::IdleGCInterval. Should return within
+        // `budget` where the engine allows it.
+        void CollectIdleGarbage(Napi::Env env, std::chrono::milliseconds budget);
+
+        // Engine-specific hook called by the watchdog from an interrupt, while
+        // script is running on the JavaScript thread. Reads the running frames
+        // from the engine rather than through an Error, so no JavaScript runs.
+        // Only V8 and QuickJS can be interrupted; the others return nothing.
+        static std::string CaptureStack(Napi::Env env);
+
+        // Engine-specific hooks for Context, called on the JavaScript thread.
+        // CreateEnvironment creates another environment on the engine instance
+        // behind `env`, and DestroyEnvironment frees it. Enter/ExitEnvironment
+        // bracket every callback running in one, for engines (V8) that create
+        // objects in whichever context was entered last.
+        Napi::Env CreateEnvironment(Napi::Env env);
+        void DestroyEnvironment(Napi::Env env);
+        void EnterEnvironment(Napi::Env env);
+        void ExitEnvironment(Napi::Env env);
+
+        // Queues `callback` to run in the environment of a Context.
+        void DispatchToContext(std::shared_ptr<ContextState> state, Dispatchable<void(Napi::Env)> callback);
+
+        // Body of the thread that schedules idle-time garbage collection.
+        void WatchForIdle();
+
         Options m_options;
 
+        // Outlives the engine's teardown (V8 frees backing stores while
+        // disposing the isolate). V8 shares it with every backing store it
+        // allocates, since a transferred buffer can outlive the runtime.
+        std::shared_ptr<PooledAllocator> m_allocator;
+
+        // Receives GC notifications from the engine, possibly on its GC threads.
+        std::unique_ptr<GCRecorder> m_gcRecorder;
+
+        std::unique_ptr<InterruptQueue> m_interrupts;
+
+        class Watchdog;
+        std::unique_ptr<Watchdog> m_watchdog;
+
+        class DispatchRecorder;
+        std::unique_ptr<DispatchRecorder> m_dispatchRecorder;
+
+        class StartupRecorder;
+        std::unique_ptr<StartupRecorder> m_startup;
+
         class Impl;
         std::unique_ptr<Impl> m_impl;
     };
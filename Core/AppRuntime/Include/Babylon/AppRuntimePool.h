@@ -0,0 +1,144 @@
+#pragma once
+
+#include "AppRuntime.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace Babylon
+{
+    // Keeps runtimes warmed up ahead of time, so work doesn't wait on engine
+    // and polyfill initialization. A runtime can be leased for exclusive use
+    // (e.g. one per request), and work that doesn't need a runtime of its own
+    // can be dispatched to whichever idle runtime has the least queued.
+    class AppRuntimePool final
+    {
+    public:
+        class Options
+        {
+        public:
+            // Options of every runtime in the pool.
+            AppRuntime::Options RuntimeOptions{};
+
+            // Warm runtimes the pool keeps ready. Runtimes that are retired are
+            // replaced to keep this many.
+            size_t Size{1};
+
+            // Most runtimes alive at once, leased or not. When every one is
+            // leased, Acquire waits for one to be released. Zero for no limit,
+            // in which case Acquire warms up an extra runtime instead.
+            size_t MaxSize{0};
+
+            // Sets up a new runtime: installs polyfills, evaluates base scripts,
+            // etc. The runtime only counts as warm once `ready` is called, which
+            // may be from any thread, e.g. from a callback dispatched after the
+            // scripts through ScriptLoader::Dispatch; calls after the runtime is
+            // gone are ignored. When empty, a runtime is warm as soon as its
+            // engine is running. If it throws, the runtime is discarded and the
+            // exception reaches the call that was starting it.
+            std::function<void(AppRuntime& runtime, std::function<void()> ready)> Initialize{};
+
+            // Runs on the JavaScript thread of a runtime that is released, before
+            // it is leased again, to clear what the previous lease left behind.
+            std::function<void(Napi::Env)> Reset{};
+
+            // Leases after which a runtime is retired and replaced by a fresh
+            // one, bounding how much state and garbage one runtime accumulates.
+            // Zero to keep runtimes for the life of the pool.
+            uint32_t MaxLeasesPerRuntime{0};
+        };
+
+        struct Statistics
+        {
+            // Acquire calls, and how many found a warm runtime waiting.
+            uint64_t Acquisitions{};
+            uint64_t Hits{};
+
+            // Runtimes that finished warming up, the time that took in total
+            // (from creation until `ready`), and the longest one.
+            uint64_t WarmUps{};
+            std::chrono::nanoseconds TotalWarmUp{};
+            std::chrono::nanoseconds LongestWarmUp{};
+
+            // Runtimes retired after MaxLeasesPerRuntime leases.
+            uint64_t Retired{};
+
+            // Runtimes currently warm and not leased, leased, and warming up (or
+            // being reset).
+            size_t Idle{};
+            size_t Leased{};
+            size_t WarmingUp{};
+        };
+
+    private:
+        class Entry;
+        class Impl;
+
+    public:
+        // Exclusive use of one runtime until destroyed or moved from. Must not
+        // be released on the runtime's own JavaScript thread, and the pool must
+        // outlive it.
+        class Lease
+        {
+        public:
+            Lease() = default;
+            ~Lease();
+
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            Lease(Lease&& other) noexcept;
+            Lease& operator=(Lease&& other) noexcept;
+
+            AppRuntime& Runtime() const;
+
+            void Dispatch(Dispatchable<void(Napi::Env)> callback) const
+            {
+                Runtime().Dispatch(std::move(callback));
+            }
+
+            // Hands the runtime back to the pool.
+            void Release();
+
+        private:
+            friend class AppRuntimePool;
+
+            Lease(Impl& pool, Entry& entry);
+
+            Impl* m_pool{};
+            Entry* m_entry{};
+        };
+
+        AppRuntimePool();
+        AppRuntimePool(Options options);
+        ~AppRuntimePool();
+
+        AppRuntimePool(const AppRuntimePool&) = delete;
+        AppRuntimePool& operator=(const AppRuntimePool&) = delete;
+
+        // Leases a warm runtime, waiting for one to be ready if none is. Safe to
+        // call from any thread but the JavaScript threads of the pool.
+        Lease Acquire();
+
+        // Runs `callback` on the idle runtime with the fewest callbacks still
+        // pending from earlier Dispatch calls. When none is warm, a runtime that
+        // is warming up is used; the callback then runs after what Initialize
+        // dispatched, but possibly before asynchronous work such as a script
+        // still being fetched. Leased runtimes are never used: when every
+        // runtime is leased, another one is started, or once the pool is at
+        // MaxSize, this waits for a lease to be released. Safe to call from any
+        // thread but the JavaScript threads of the pool.
+        void Dispatch(Dispatchable<void(Napi::Env)> callback);
+
+        // Safe to call from any thread.
+        Statistics GetStatistics() const;
+
+    private:
+        // Shared with the `ready` callbacks handed to Options::Initialize, which
+        // may outlive the pool.
+        std::shared_ptr<Impl> m_impl;
+    };
+}
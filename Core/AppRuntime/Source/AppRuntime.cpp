@@ -1,13 +1,25 @@
 #include "AppRuntime.h"
+#include "PooledAllocator.h"
+#include "DispatchRecorder.h"
+#include "GCRecorder.h"
+#include "InterruptQueue.h"
+#include "StartupRecorder.h"
+#include "Watchdog.h"
 
 #include <arcana/threading/cancellation.h>
 #include <arcana/threading/dispatcher.h>
+#include <arcana/tracing/trace_region.h>
 
+#include <algorithm>
 #include <cassert>
+#include <condition_variable>
 #include <optional>
 #include <mutex>
+#include <stdexcept>
 #include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Babylon
 {
@@ -31,11 +43,135 @@ namespace Babylon
             }
         }
 
+        // Bookkeeping for idle-time GC, only done when it is enabled.
+        void BeginWork()
+        {
+            if (m_idleEnabled)
+            {
+                {
+                    std::scoped_lock lock{m_idleMutex};
+                    ++m_pending;
+                    ++m_activity;
+                }
+                m_idleCondition.notify_one();
+            }
+        }
+
+        void EndWork()
+        {
+            if (m_idleEnabled)
+            {
+                {
+                    std::scoped_lock lock{m_idleMutex};
+                    --m_pending;
+                    ++m_activity;
+                }
+                m_idleCondition.notify_one();
+            }
+        }
+
+        bool IsBusy()
+        {
+            std::scoped_lock lock{m_idleMutex};
+            return m_pending != 0;
+        }
+
         std::optional<Napi::Env> m_env{};
         std::optional<std::scoped_lock<std::mutex>> m_suspensionLock{};
         arcana::cancellation_source m_cancelSource{};
         arcana::manual_dispatcher<128> m_dispatcher{};
         std::thread m_thread;
+
+        bool m_idleEnabled{};
+        std::mutex m_idleMutex{};
+        std::condition_variable m_idleCondition{};
+        // Dispatched callbacks that are queued or running.
+        size_t m_pending{};
+        // Bumped whenever a dispatched callback is queued or finishes.
+        uint64_t m_activity{};
+        bool m_idleStopped{};
+        std::thread m_idleThread{};
+
+        // Contexts whose environment exists. Only used on the JavaScript thread.
+        std::vector<std::shared_ptr<ContextState>> m_contexts{};
+
+        // Shared with the Context objects, which can outlive the runtime.
+        std::shared_ptr<ContextLink> m_contextLink{};
+    };
+
+    // Lets a Context reach its runtime for as long as the runtime exists.
+    class AppRuntime::ContextLink
+    {
+    public:
+        explicit ContextLink(AppRuntime& runtime)
+            : m_runtime{&runtime}
+        {
+        }
+
+        // Calls `callback` with the runtime, unless it is being destroyed
+        // already, holding it off until the callback returns.
+        template<typename CallableT>
+        void With(CallableT&& callback)
+        {
+            std::scoped_lock lock{m_mutex};
+            if (m_runtime != nullptr)
+            {
+                callback(*m_runtime);
+            }
+        }
+
+        void Unlink()
+        {
+            std::scoped_lock lock{m_mutex};
+            m_runtime = nullptr;
+        }
+
+    private:
+        std::mutex m_mutex{};
+        AppRuntime* m_runtime;
+    };
+
+    class AppRuntime::ContextState
+    {
+    public:
+        // Runs `callback` in the environment, unless it is gone already.
+        template<typename CallableT>
+        void Run(AppRuntime& runtime, CallableT&& callback)
+        {
+            if (!Env.has_value())
+            {
+                return;
+            }
+
+            const Napi::Env env = Env.value();
+            runtime.EnterEnvironment(env);
+
+            struct ExitOnReturn
+            {
+                ~ExitOnReturn()
+                {
+                    Runtime.ExitEnvironment(Env);
+                }
+
+                AppRuntime& Runtime;
+                Napi::Env Env;
+            } exitOnReturn{runtime, env};
+
+            Napi::HandleScope scope{env};
+            callback(env);
+        }
+
+        void Destroy(AppRuntime& runtime)
+        {
+            if (Env.has_value())
+            {
+                runtime.DestroyEnvironment(Env.value());
+                Env.reset();
+            }
+        }
+
+        // Set on the JavaScript thread while the environment exists.
+        std::optional<Napi::Env> Env{};
     };
 
     AppRuntime::AppRuntime() :
@@ -45,17 +181,48 @@ namespace Babylon
 
     AppRuntime::AppRuntime(Options options)
         : m_options{std::move(options)}
+        , m_allocator{std::make_shared<PooledAllocator>()}
+        , m_gcRecorder{std::make_unique<GCRecorder>()}
+        , m_interrupts{std::make_unique<InterruptQueue>(m_options.UnhandledExceptionHandler)}
+        , m_watchdog{std::make_unique<Watchdog>(m_options, *m_interrupts)}
+        , m_dispatchRecorder{std::make_unique<DispatchRecorder>(m_options.EnableDispatchMetrics)}
+        , m_startup{std::make_unique<StartupRecorder>()}
         , m_impl{std::make_unique<Impl>()}
     {
-        m_impl->m_thread = std::thread{[this] { RunPlatformTier(); }};
+        m_impl->m_contextLink = std::make_shared<ContextLink>(*this);
+
+        m_impl->m_thread = std::thread{[this] {
+            m_allocator->BindToCurrentThread();
+            RunPlatformTier();
+        }};
+
+        if (m_options.IdleGCInterval.count() > 0)
+        {
+            m_impl->m_idleEnabled = true;
+            m_impl->m_idleThread = std::thread{[this] { WatchForIdle(); }};
+        }
 
         Dispatch([this](Napi::Env env) {
+            StartupTrace::Scope phase{env, "JsRuntime::CreateForJavaScript"};
             JsRuntime::CreateForJavaScript(env, [this](auto func) { Dispatch(std::move(func)); });
         });
     }
 
     AppRuntime::~AppRuntime()
     {
+        // Contexts still around from here on are torn down with the runtime.
+        m_impl->m_contextLink->Unlink();
+
+        if (m_impl->m_idleThread.joinable())
+        {
+            {
+                std::scoped_lock lock{m_impl->m_idleMutex};
+                m_impl->m_idleStopped = true;
+            }
+            m_impl->m_idleCondition.notify_one();
+            m_impl->m_idleThread.join();
+        }
+
         if (m_impl->m_suspensionLock.has_value())
         {
             m_impl->m_suspensionLock.reset();
@@ -76,9 +243,17 @@ namespace Babylon
         m_impl->m_thread.join();
     }
 
+    void AppRuntime::Terminate()
+    {
+        m_impl->m_cancelSource.cancel();
+        m_impl->Append([](Napi::Env) {});
+        m_interrupts->RequestTermination();
+    }
+
     void AppRuntime::Run(Napi::Env env)
     {
         m_impl->m_env = std::make_optional(env);
+        m_startup->Attach(env);
 
         m_impl->m_dispatcher.set_affinity(std::this_thread::get_id());
 
@@ -89,6 +264,67 @@ namespace Babylon
 
         // The dispatcher can be non-empty if something is dispatched after cancellation.
         m_impl->m_dispatcher.clear();
+
+        // Lets finalizers run script while the environments are torn down, in
+        // case the loop was stopped by Terminate.
+        if (m_interrupts->TerminationRequested())
+        {
+            m_interrupts->ResumeExecution();
+        }
+
+        // The engine instance can only be torn down once every environment on
+        // it is gone (QuickJS asserts it has no contexts left).
+        for (const auto& context : std::exchange(m_impl->m_contexts, {}))
+        {
+            context->Destroy(*this);
+        }
+
+        m_startup->Detach();
+    }
+
+    void AppRuntime::WatchForIdle()
+    {
+        std::unique_lock lock{m_impl->m_idleMutex};
+
+        // Allows a collection after the runtime's own startup work.
+        uint64_t collectedAt = UINT64_MAX;
+        while (!m_impl->m_idleStopped)
+        {
+            const uint64_t activity = m_impl->m_activity;
+            const auto changed = [this, activity] {
+                return m_impl->m_idleStopped || m_impl->m_activity != activity;
+            };
+
+            if (m_impl->m_pending != 0 || activity == collectedAt)
+            {
+                // Busy, or already collected since the last dispatched callback.
+                m_impl->m_idleCondition.wait(lock, changed);
+            }
+            else if (!m_impl->m_idleCondition.wait_for(lock, m_options.IdleGCInterval, changed))
+            {
+                collectedAt = activity;
+                lock.unlock();
+
+                // Appended directly rather than dispatched so it doesn't count as
+                // activity itself.
+                m_impl->Append([this](Napi::Env env) {
+                    // Work dispatched after this was queued runs first; skip the
+                    // collection if the runtime is no longer idle.
+                    if (m_impl->IsBusy())
+                    {
+                        return;
+                    }
+
+                    Execute([this, env]() {
+                        arcana::trace_region region{"AppRuntime::IdleGC"};
+                        Napi::HandleScope scope{env};
+                        CollectIdleGarbage(env, m_options.IdleGCBudget);
+                    });
+                });
+
+                lock.lock();
+            }
+        }
     }
 
     void AppRuntime::Suspend()
@@ -105,10 +341,120 @@ namespace Babylon
         m_impl->m_suspensionLock.reset();
     }
 
+    AppRuntime::AllocatorStatistics AppRuntime::GetAllocatorStatistics() const
+    {
+        return m_allocator->GetStatistics();
+    }
+
+    void AppRuntime::NotifyMemoryPressure(MemoryPressureLevel level)
+    {
+        m_impl->Append([this, level](Napi::Env env) {
+            Execute([this, env, level]() {
+                Napi::HandleScope scope{env};
+                ReclaimMemory(env, level);
+            });
+
+            // After the collection, which may have returned blocks to the pool.
+            // The pool's free lists belong to this thread.
+            m_allocator->Trim();
+        });
+    }
+
+    void AppRuntime::RequestInterrupt(Dispatchable<void(Napi::Env)> callback)
+    {
+        m_interrupts->Push(std::move(callback));
+
+        // Also queued as regular work, which runs the callback promptly when no
+        // script is running or the engine can't be interrupted.
+        m_impl->Append([this](Napi::Env env) {
+            Execute([this, env]() {
+                m_interrupts->Run(env);
+            });
+        });
+    }
+
+    uint32_t AppRuntime::SubscribeToGCEvents(std::function<void(const GCEvent&)> handler)
+    {
+        return m_gcRecorder->Subscribe(std::move(handler));
+    }
+
+    void AppRuntime::UnsubscribeFromGCEvents(uint32_t subscription)
+    {
+        m_gcRecorder->Unsubscribe(subscription);
+    }
+
+    AppRuntime::GCStatistics AppRuntime::GetGCStatistics() const
+    {
+        return m_gcRecorder->GetStatistics();
+    }
+
+    AppRuntime::DispatchMetrics AppRuntime::GetDispatchMetrics() const
+    {
+        return m_dispatchRecorder->GetMetrics();
+    }
+
+    std::vector<StartupTrace::Phase> AppRuntime::GetStartupReport() const
+    {
+        return m_startup->GetReport();
+    }
+
+    std::unique_ptr<AppRuntime::Context> AppRuntime::CreateContext()
+    {
+        if (!SupportsContexts())
+        {
+            throw std::runtime_error{"AppRuntime::CreateContext is not supported by this JavaScript engine"};
+        }
+
+        return std::unique_ptr<Context>{new Context{*this}};
+    }
+
+    AppRuntime::Context::Context(AppRuntime& runtime)
+        : m_link{runtime.m_impl->m_contextLink}
+        , m_state{std::make_shared<ContextState>()}
+    {
+        runtime.Dispatch([&runtime, state = m_state](Napi::Env env) {
+            state->Env = runtime.CreateEnvironment(env);
+            runtime.m_impl->m_contexts.push_back(state);
+
+            state->Run(runtime, [&runtime, &state](Napi::Env contextEnv) {
+                JsRuntime::CreateForJavaScript(contextEnv, [&runtime, state](auto func) { runtime.DispatchToContext(state, std::move(func)); });
+            });
+        });
+    }
+
+    AppRuntime::Context::~Context()
+    {
+        m_link->With([this](AppRuntime& runtime) {
+            runtime.Dispatch([&runtime, state = std::move(m_state)](Napi::Env) {
+                auto& contexts = runtime.m_impl->m_contexts;
+                contexts.erase(std::remove(contexts.begin(), contexts.end(), state), contexts.end());
+                state->Destroy(runtime);
+            });
+        });
+    }
+
+    void AppRuntime::Context::Dispatch(Dispatchable<void(Napi::Env)> callback)
+    {
+        m_link->With([this, &callback](AppRuntime& runtime) {
+            runtime.DispatchToContext(m_state, std::move(callback));
+        });
+    }
+
+    void AppRuntime::DispatchToContext(std::shared_ptr<ContextState> state, Dispatchable<void(Napi::Env)> callback)
+    {
+        Dispatch([this, state = std::move(state), callback = std::move(callback)](Napi::Env) mutable {
+            state->Run(*this, callback);
+        });
+    }
+
     void AppRuntime::Dispatch(Dispatchable<void(Napi::Env)> func)
     {
-        m_impl->Append([this, func{std::move(func)}](Napi::Env env) mutable {
-            Execute([this, env, func{std::move(func)}]() mutable {
+        m_impl->BeginWork();
+        const auto enqueued = m_dispatchRecorder->Enqueued();
+        m_impl->Append([this, enqueued, func{std::move(func)}](Napi::Env env) mutable {
+            Execute([this, env, enqueued, func{std::move(func)}]() mutable {
+                const auto started = m_dispatchRecorder->Started();
+
                 // Some engines (notably Hermes) require an open NAPI handle
                 // scope before any napi_* call that materializes a value.
                 // The other engines (V8/Chakra/JSC) already provide an outer
@@ -116,6 +462,8 @@ namespace Babylon
                 // scope is harmless there but mandatory for Hermes.
                 Napi::HandleScope scope{env};
 
+                m_watchdog->TaskStarted();
+
                 try
                 {
                     func(env);
@@ -130,12 +478,19 @@ namespace Babylon
                     std::abort();
                 }
 
+                const auto executed = m_dispatchRecorder->Executed();
+
                 // Drain engine-level microtasks/jobs queued during the
                 // callback (Promise continuations, queueMicrotask, etc.) so
                 // they run before the next top-level Dispatch.  No-op for
                 // engines that drain automatically; Hermes needs an explicit
                 // pump.
                 DrainMicrotasks(env);
+
+                m_dispatchRecorder->Drained(enqueued, started, executed);
+
+                m_watchdog->TaskFinished();
+                m_impl->EndWork();
             });
         });
     }
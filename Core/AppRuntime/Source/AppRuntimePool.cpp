@@ -0,0 +1,436 @@
+#include "AppRuntimePool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <initializer_list>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Babylon
+{
+    class AppRuntimePool::Entry
+    {
+    public:
+        enum class State
+        {
+            // The runtime is being created and Options::Initialize is running;
+            // nothing else may use it yet.
+            Starting,
+            WarmingUp,
+            Idle,
+            Leased,
+            // Options::Reset is running after a lease.
+            Resetting,
+        };
+
+        uint64_t Id{};
+        State CurrentState{State::Starting};
+        std::unique_ptr<AppRuntime> Runtime{};
+        std::chrono::steady_clock::time_point Created{};
+        uint32_t Leases{};
+
+        // Callbacks from AppRuntimePool::Dispatch that haven't finished yet.
+        std::atomic<size_t> Pending{};
+    };
+
+    class AppRuntimePool::Impl : public std::enable_shared_from_this<AppRuntimePool::Impl>
+    {
+        using State = Entry::State;
+
+    public:
+        Impl(Options options)
+            : m_options{std::move(options)}
+        {
+        }
+
+        void Start()
+        {
+            std::unique_lock lock{m_mutex};
+            for (size_t i = 0; i < m_options.Size; ++i)
+            {
+                StartWarmUp(lock);
+            }
+        }
+
+        void Shutdown()
+        {
+            std::vector<std::unique_ptr<Entry>> entries{};
+            {
+                std::scoped_lock lock{m_mutex};
+                entries = std::move(m_entries);
+                m_entries.clear();
+            }
+
+            // Destroyed outside the lock, since their threads may be calling Ready.
+            entries.clear();
+        }
+
+        Entry& Acquire()
+        {
+            std::unique_lock lock{m_mutex};
+            ++m_statistics.Acquisitions;
+
+            bool hit{true};
+            ++m_waiting;
+            while (true)
+            {
+                if (Entry* entry = LeastLoaded({State::Idle}))
+                {
+                    --m_waiting;
+                    if (hit)
+                    {
+                        ++m_statistics.Hits;
+                    }
+                    entry->CurrentState = State::Leased;
+                    ++entry->Leases;
+                    return *entry;
+                }
+
+                hit = false;
+                if (NeedsWarmUp())
+                {
+                    try
+                    {
+                        StartWarmUp(lock);
+                    }
+                    catch (...)
+                    {
+                        --m_waiting;
+                        throw;
+                    }
+                }
+                else
+                {
+                    m_condition.wait(lock);
+                }
+            }
+        }
+
+        void Return(Entry& entry)
+        {
+            std::unique_ptr<Entry> retired{};
+            {
+                std::unique_lock lock{m_mutex};
+                // Not while callbacks from Dispatch are queued on it, which would
+                // be dropped; it is retired after a later lease instead.
+                if (m_options.MaxLeasesPerRuntime != 0 && entry.Leases >= m_options.MaxLeasesPerRuntime && entry.Pending == 0)
+                {
+                    const auto it = std::find_if(m_entries.begin(), m_entries.end(), [&entry](const auto& other) { return other.get() == &entry; });
+                    assert(it != m_entries.end());
+                    retired = std::move(*it);
+                    m_entries.erase(it);
+                    ++m_statistics.Retired;
+
+                    if (NeedsWarmUp())
+                    {
+                        StartWarmUp(lock);
+                    }
+                }
+                else if (m_options.Reset)
+                {
+                    entry.CurrentState = State::Resetting;
+                    entry.Runtime->Dispatch([reset = m_options.Reset, pool = weak_from_this(), id = entry.Id](Napi::Env env) {
+                        // Idle again even if the reset throws, which is reported
+                        // like the error of any dispatched callback.
+                        struct ReadyOnExit
+                        {
+                            ~ReadyOnExit()
+                            {
+                                if (auto impl = Pool.lock())
+                                {
+                                    impl->Ready(Id);
+                                }
+                            }
+
+                            const std::weak_ptr<Impl>& Pool;
+                            uint64_t Id;
+                        } readyOnExit{pool, id};
+
+                        reset(env);
+                    });
+                }
+                else
+                {
+                    entry.CurrentState = State::Idle;
+                }
+            }
+            m_condition.notify_all();
+
+            // Destroyed outside the lock, since that waits for its thread.
+            retired.reset();
+        }
+
+        void Dispatch(Dispatchable<void(Napi::Env)> callback)
+        {
+            std::unique_lock lock{m_mutex};
+
+            // Never a leased runtime, which is for the exclusive use of its lease.
+            Entry* entry{};
+            while ((entry = LeastLoaded({State::Idle})) == nullptr &&
+                   (entry = LeastLoaded({State::WarmingUp, State::Resetting})) == nullptr)
+            {
+                // Every runtime is leased or still starting, or there are none
+                // yet. Another one is started if none is on its way and the pool
+                // may grow; otherwise wait for one to be released or to start.
+                if (LeastLoaded({State::Starting}) == nullptr && (m_options.MaxSize == 0 || m_entries.size() < m_options.MaxSize))
+                {
+                    StartWarmUp(lock);
+                }
+                else
+                {
+                    m_condition.wait(lock);
+                }
+            }
+
+            // Dispatched under the lock, so the runtime can't be retired meanwhile.
+            ++entry->Pending;
+            entry->Runtime->Dispatch([&pending = entry->Pending, callback = std::move(callback)](Napi::Env env) mutable {
+                struct DecrementOnExit
+                {
+                    ~DecrementOnExit()
+                    {
+                        --Pending;
+                    }
+
+                    std::atomic<size_t>& Pending;
+                } decrementOnExit{pending};
+
+                callback(env);
+            });
+        }
+
+        Statistics GetStatistics() const
+        {
+            std::scoped_lock lock{m_mutex};
+            Statistics statistics{m_statistics};
+            for (const auto& entry : m_entries)
+            {
+                switch (entry->CurrentState)
+                {
+                    case State::Idle:
+                        ++statistics.Idle;
+                        break;
+                    case State::Leased:
+                        ++statistics.Leased;
+                        break;
+                    default:
+                        ++statistics.WarmingUp;
+                        break;
+                }
+            }
+            return statistics;
+        }
+
+    private:
+        // Must be called with m_mutex held, through `lock`. Releases it while the
+        // runtime is created and initialized, since that takes a while and
+        // `ready` may be called right away. Holds it again when returning, also
+        // by throwing, in which case the runtime is dropped from the pool.
+        void StartWarmUp(std::unique_lock<std::mutex>& lock)
+        {
+            Entry& entry = *m_entries.emplace_back(std::make_unique<Entry>());
+            entry.Id = ++m_lastId;
+            entry.Created = std::chrono::steady_clock::now();
+
+            lock.unlock();
+
+            try
+            {
+                entry.Runtime = std::make_unique<AppRuntime>(m_options.RuntimeOptions);
+                auto ready = [pool = weak_from_this(), id = entry.Id]() {
+                    if (auto impl = pool.lock())
+                    {
+                        impl->Ready(id);
+                    }
+                };
+
+                if (m_options.Initialize)
+                {
+                    m_options.Initialize(*entry.Runtime, std::move(ready));
+                }
+                else
+                {
+                    entry.Runtime->Dispatch([ready = std::move(ready)](Napi::Env) { ready(); });
+                }
+            }
+            catch (...)
+            {
+                lock.lock();
+                std::unique_ptr<Entry> failed{};
+                const auto it = std::find_if(m_entries.begin(), m_entries.end(), [&entry](const auto& other) { return other.get() == &entry; });
+                if (it != m_entries.end())
+                {
+                    failed = std::move(*it);
+                    m_entries.erase(it);
+                }
+                m_condition.notify_all();
+
+                // Destroyed outside the lock, since that waits for its thread.
+                lock.unlock();
+                failed.reset();
+                lock.lock();
+                throw;
+            }
+
+            lock.lock();
+
+            // Unless `ready` was already called.
+            if (entry.CurrentState == State::Starting)
+            {
+                entry.CurrentState = State::WarmingUp;
+            }
+            m_condition.notify_all();
+        }
+
+        void Ready(uint64_t id)
+        {
+            {
+                std::scoped_lock lock{m_mutex};
+                const auto it = std::find_if(m_entries.begin(), m_entries.end(), [id](const auto& entry) { return entry->Id == id; });
+                if (it == m_entries.end())
+                {
+                    return;
+                }
+
+                Entry& entry = **it;
+                if (entry.CurrentState == State::Starting || entry.CurrentState == State::WarmingUp)
+                {
+                    const auto warmUp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - entry.Created);
+                    ++m_statistics.WarmUps;
+                    m_statistics.TotalWarmUp += warmUp;
+                    m_statistics.LongestWarmUp = std::max(m_statistics.LongestWarmUp, warmUp);
+                }
+                else if (entry.CurrentState != State::Resetting)
+                {
+                    return;
+                }
+
+                entry.CurrentState = State::Idle;
+            }
+            m_condition.notify_all();
+        }
+
+        // Whether a runtime should start warming up: the pool is below its size,
+        // or Acquire calls are waiting that the runtimes already warming up
+        // won't cover. Must be called with m_mutex held.
+        bool NeedsWarmUp() const
+        {
+            if (m_options.MaxSize != 0 && m_entries.size() >= m_options.MaxSize)
+            {
+                return false;
+            }
+
+            size_t warming{};
+            for (const auto& entry : m_entries)
+            {
+                if (entry->CurrentState != State::Idle && entry->CurrentState != State::Leased)
+                {
+                    ++warming;
+                }
+            }
+            return m_entries.size() < m_options.Size || warming < m_waiting;
+        }
+
+        // Must be called with m_mutex held.
+        Entry* LeastLoaded(std::initializer_list<State> states) const
+        {
+            Entry* result{};
+            for (const auto& entry : m_entries)
+            {
+                if (std::find(states.begin(), states.end(), entry->CurrentState) != states.end() &&
+                    (result == nullptr || entry->Pending < result->Pending))
+                {
+                    result = entry.get();
+                }
+            }
+            return result;
+        }
+
+        const Options m_options;
+
+        mutable std::mutex m_mutex{};
+        std::condition_variable m_condition{};
+        std::vector<std::unique_ptr<Entry>> m_entries{};
+        Statistics m_statistics{};
+        uint64_t m_lastId{};
+        // Acquire calls waiting for a runtime.
+        size_t m_waiting{};
+    };
+
+    AppRuntimePool::Lease::Lease(Impl& pool, Entry& entry)
+        : m_pool{&pool}
+        , m_entry{&entry}
+    {
+    }
+
+    AppRuntimePool::Lease::~Lease()
+    {
+        Release();
+    }
+
+    AppRuntimePool::Lease::Lease(Lease&& other) noexcept
+        : m_pool{std::exchange(other.m_pool, nullptr)}
+        , m_entry{std::exchange(other.m_entry, nullptr)}
+    {
+    }
+
+    AppRuntimePool::Lease& AppRuntimePool::Lease::operator=(Lease&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            m_pool = std::exchange(other.m_pool, nullptr);
+            m_entry = std::exchange(other.m_entry, nullptr);
+        }
+        return *this;
+    }
+
+    AppRuntime& AppRuntimePool::Lease::Runtime() const
+    {
+        assert(m_entry != nullptr);
+        return *m_entry->Runtime;
+    }
+
+    void AppRuntimePool::Lease::Release()
+    {
+        if (m_entry != nullptr)
+        {
+            m_pool->Return(*std::exchange(m_entry, nullptr));
+            m_pool = nullptr;
+        }
+    }
+
+    AppRuntimePool::AppRuntimePool()
+        : AppRuntimePool{Options{}}
+    {
+    }
+
+    AppRuntimePool::AppRuntimePool(Options options)
+        : m_impl{std::make_shared<Impl>(std::move(options))}
+    {
+        m_impl->Start();
+    }
+
+    AppRuntimePool::~AppRuntimePool()
+    {
+        m_impl->Shutdown();
+    }
+
+    AppRuntimePool::Lease AppRuntimePool::Acquire()
+    {
+        return {*m_impl, m_impl->Acquire()};
+    }
+
+    void AppRuntimePool::Dispatch(Dispatchable<void(Napi::Env)> callback)
+    {
+        m_impl->Dispatch(std::move(callback));
+    }
+
+    AppRuntimePool::Statistics AppRuntimePool::GetStatistics() const
+    {
+        return m_impl->GetStatistics();
+    }
+}
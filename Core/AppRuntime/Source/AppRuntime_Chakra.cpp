@@ -1,4 +1,7 @@
 #include "AppRuntime.h"
+#include "GCRecorder.h"
+#include "InterruptQueue.h"
+#include "StartupRecorder.h"
 #include <napi/env.h>
 
 #define USE_EDGEMODE_JSRT
@@ -33,8 +36,38 @@ namespace Babylon
                 });
             }};
 
+        auto enginePhase = m_startup->Begin("AppRuntime::InitializeEngine");
         JsRuntimeHandle jsRuntime;
-        ThrowIfFailed(JsCreateRuntime(JsRuntimeAttributeNone, nullptr, &jsRuntime));
+        JsRuntimeAttributes attributes = JsRuntimeAttributeNone;
+        if (!m_options.EnableJIT)
+        {
+            attributes = static_cast<JsRuntimeAttributes>(attributes | JsRuntimeAttributeDisableNativeCodeGeneration);
+        }
+        if (m_options.IdleGCInterval.count() > 0)
+        {
+            attributes = static_cast<JsRuntimeAttributes>(attributes | JsRuntimeAttributeEnableIdleProcessing);
+        }
+        if (m_options.ExecutionTimeLimit.count() > 0)
+        {
+            attributes = static_cast<JsRuntimeAttributes>(attributes | JsRuntimeAttributeAllowScriptInterrupt);
+        }
+        ThrowIfFailed(JsCreateRuntime(attributes, nullptr, &jsRuntime));
+        if (m_options.MaxHeapSize != 0)
+        {
+            ThrowIfFailed(JsSetRuntimeMemoryLimit(jsRuntime, m_options.MaxHeapSize));
+        }
+
+        // Chakra only says when a collection is about to start, so its pauses
+        // can't be timed.
+        ThrowIfFailed(JsSetRuntimeBeforeCollectCallback(
+            jsRuntime,
+            m_gcRecorder.get(),
+            [](void* callbackState) {
+                static_cast<GCRecorder*>(callbackState)->Start(GCKind::Major, false);
+            }));
+        enginePhase.End();
+
+        auto contextPhase = m_startup->Begin("AppRuntime::CreateContext");
         JsContextRef context;
         ThrowIfFailed(JsCreateContext(jsRuntime, &context));
         ThrowIfFailed(JsSetCurrentContext(context));
@@ -62,9 +95,27 @@ namespace Babylon
         }
 
         Napi::Env env = Napi::Attach();
+        contextPhase.End();
+
+        // Chakra can stop script from another thread but can't run callbacks
+        // inside it.
+        if (m_options.ExecutionTimeLimit.count() > 0)
+        {
+            m_interrupts->Attach(
+                env,
+                {},
+                [jsRuntime]() {
+                    JsDisableRuntimeExecution(jsRuntime);
+                },
+                [jsRuntime]() {
+                    JsEnableRuntimeExecution(jsRuntime);
+                });
+        }
 
         Run(env);
 
+        m_interrupts->Detach();
+
         ThrowIfFailed(JsSetCurrentContext(JS_INVALID_REFERENCE));
         ThrowIfFailed(JsDisposeRuntime(jsRuntime));
 
@@ -78,4 +129,48 @@ namespace Babylon
         // JsSetPromiseContinuationCallback hook (see RunEnvironmentTier).
         // No explicit pump needed here.
     }
+
+    void AppRuntime::CollectIdleGarbage(Napi::Env, std::chrono::milliseconds)
+    {
+        // Chakra sizes its own idle work; the returned next idle tick is only a
+        // hint and the dispatcher already decides when to come back.
+        unsigned int nextIdleTick;
+        ThrowIfFailed(JsIdle(&nextIdleTick));
+    }
+
+    void AppRuntime::ReclaimMemory(Napi::Env, MemoryPressureLevel)
+    {
+        JsContextRef context;
+        ThrowIfFailed(JsGetCurrentContext(&context));
+        JsRuntimeHandle jsRuntime;
+        ThrowIfFailed(JsGetRuntime(context, &jsRuntime));
+        ThrowIfFailed(JsCollectGarbage(jsRuntime));
+    }
+
+    bool BABYLON_API AppRuntime::SupportsContexts()
+    {
+        return false;
+    }
+
+    Napi::Env AppRuntime::CreateEnvironment(Napi::Env)
+    {
+        throw std::runtime_error{"AppRuntime::CreateContext is not supported by Chakra"};
+    }
+
+    void AppRuntime::DestroyEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::EnterEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::ExitEnvironment(Napi::Env)
+    {
+    }
+
+    std::string AppRuntime::CaptureStack(Napi::Env)
+    {
+        return {};
+    }
 }
@@ -1,6 +1,10 @@
 #include "AppRuntime.h"
+#include "GCRecorder.h"
+#include "StartupRecorder.h"
 #include <napi/env.h>
 
+#include <stdexcept>
+
 namespace Babylon
 {
     void AppRuntime::RunEnvironmentTier(const char*)
@@ -9,7 +13,22 @@ namespace Babylon
         // library's env_hermes.cc (see Napi::Attach/Detach).  Keeping the
         // engine-specific machinery there avoids dragging Hermes headers into
         // AppRuntime's translation unit.
-        Napi::Env env = Napi::Attach();
+        auto gcEventCallback = [recorder = m_gcRecorder.get()](bool start, bool young) {
+            const GCKind kind = young ? GCKind::Minor : GCKind::Major;
+            if (start)
+            {
+                recorder->Start(kind);
+            }
+            else
+            {
+                recorder->End(kind);
+            }
+        };
+
+        // Attach creates the runtime and its context in one go.
+        auto contextPhase = m_startup->Begin("AppRuntime::CreateContext");
+        Napi::Env env = Napi::Attach(m_options.InitialHeapSize, m_options.MaxHeapSize, std::move(gcEventCallback));
+        contextPhase.End();
 
         Run(env);
 
@@ -25,4 +44,42 @@ namespace Babylon
         // observes the same "between turns" semantics it gets on V8/Chakra.
         Napi::DrainJobs(env);
     }
+
+    void AppRuntime::CollectIdleGarbage(Napi::Env env, std::chrono::milliseconds)
+    {
+        // Hermes exposes no incremental step, so idle time runs a full collection.
+        Napi::CollectGarbage(env);
+    }
+
+    void AppRuntime::ReclaimMemory(Napi::Env env, MemoryPressureLevel)
+    {
+        Napi::CollectGarbage(env);
+    }
+
+    bool BABYLON_API AppRuntime::SupportsContexts()
+    {
+        return false;
+    }
+
+    Napi::Env AppRuntime::CreateEnvironment(Napi::Env)
+    {
+        throw std::runtime_error{"AppRuntime::CreateContext is not supported by Hermes"};
+    }
+
+    void AppRuntime::DestroyEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::EnterEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::ExitEnvironment(Napi::Env)
+    {
+    }
+
+    std::string AppRuntime::CaptureStack(Napi::Env)
+    {
+        return {};
+    }
 }
@@ -1,9 +1,12 @@
 #include "AppRuntime.h"
+#include "StartupRecorder.h"
 
 #include <napi/env.h>
 #include <V8JsiRuntime.h>
 #include <ScriptStore.h>
 
+#include <stdexcept>
+
 namespace
 {
     class TaskRunnerAdapter : public v8runtime::JSITaskRunner
@@ -34,12 +37,16 @@ namespace Babylon
 {
     void AppRuntime::RunEnvironmentTier(const char*)
     {
+        // The engine tuning options (heap and stack sizes, V8 flags, JIT) are
+        // not applied here: v8jsi sets up the isolate itself.
         v8runtime::V8RuntimeArgs args{};
         args.inspectorPort = 5643;
         args.foreground_task_runner = std::make_shared<TaskRunnerAdapter>(*this);
+        auto contextPhase = m_startup->Begin("AppRuntime::CreateContext");
         const auto runtime = v8runtime::makeV8Runtime(std::move(args));
 
         const auto env = Napi::Attach(*runtime);
+        contextPhase.End();
 
         Run(env);
 
@@ -50,4 +57,41 @@ namespace Babylon
     {
         // JSI/V8 backed JSI auto-drains microtasks per scope.
     }
+
+    void AppRuntime::CollectIdleGarbage(Napi::Env, std::chrono::milliseconds)
+    {
+        // JSI offers no portable way to request a collection.
+    }
+
+    void AppRuntime::ReclaimMemory(Napi::Env, MemoryPressureLevel)
+    {
+        // JSI offers no portable way to request a collection.
+    }
+
+    bool BABYLON_API AppRuntime::SupportsContexts()
+    {
+        return false;
+    }
+
+    Napi::Env AppRuntime::CreateEnvironment(Napi::Env)
+    {
+        throw std::runtime_error{"AppRuntime::CreateContext is not supported by JSI"};
+    }
+
+    void AppRuntime::DestroyEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::EnterEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::ExitEnvironment(Napi::Env)
+    {
+    }
+
+    std::string AppRuntime::CaptureStack(Napi::Env)
+    {
+        return {};
+    }
 }
@@ -1,10 +1,16 @@
 #include "AppRuntime.h"
+#include "StartupRecorder.h"
 #include <napi/env.h>
 
+#include <stdexcept>
+
 namespace Babylon
 {
     void AppRuntime::RunEnvironmentTier(const char*)
     {
+        // JavaScriptCore exposes no public API for heap, stack or JIT limits, so
+        // the engine tuning options are ignored here.
+        auto contextPhase = m_startup->Begin("AppRuntime::CreateContext");
         auto globalContext = JSGlobalContextCreateInGroup(nullptr, nullptr);
 
 #if __APPLE__
@@ -15,6 +21,7 @@ namespace Babylon
 #endif
 
         Napi::Env env = Napi::Attach(globalContext);
+        contextPhase.End();
 
         Run(env);
 
@@ -28,4 +35,41 @@ namespace Babylon
     {
         // JavaScriptCore drains microtasks automatically at script boundaries.
     }
+
+    void AppRuntime::CollectIdleGarbage(Napi::Env env, std::chrono::milliseconds)
+    {
+        JSGarbageCollect(Napi::GetContext(env));
+    }
+
+    void AppRuntime::ReclaimMemory(Napi::Env env, MemoryPressureLevel)
+    {
+        JSGarbageCollect(Napi::GetContext(env));
+    }
+
+    bool BABYLON_API AppRuntime::SupportsContexts()
+    {
+        return false;
+    }
+
+    Napi::Env AppRuntime::CreateEnvironment(Napi::Env)
+    {
+        throw std::runtime_error{"AppRuntime::CreateContext is not supported by JavaScriptCore"};
+    }
+
+    void AppRuntime::DestroyEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::EnterEnvironment(Napi::Env)
+    {
+    }
+
+    void AppRuntime::ExitEnvironment(Napi::Env)
+    {
+    }
+
+    std::string AppRuntime::CaptureStack(Napi::Env)
+    {
+        return {};
+    }
 }
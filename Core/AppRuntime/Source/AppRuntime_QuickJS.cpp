@@ -1,4 +1,8 @@
 #include "AppRuntime.h"
+#include "PooledAllocator.h"
+#include "GCRecorder.h"
+#include "InterruptQueue.h"
+#include "StartupRecorder.h"
 #include <napi/env.h>
 
 #ifdef _WIN32
@@ -18,18 +22,189 @@
 #pragma warning(pop)
 #endif
 
+#include <cstddef>
+#include <cstring>
+#include <functional>
+
 namespace Babylon
 {
+    namespace
+    {
+        // State behind the allocation functions below. QuickJS checks its own
+        // memory limit before calling them, which would leave no chance to raise
+        // it, so MaxHeapSize and the near-limit callback are applied here instead.
+        struct PooledMallocState
+        {
+            PooledAllocator& Pool;
+            size_t Limit;
+            const size_t InitialLimit;
+            const std::function<size_t(size_t, size_t)>& NearLimit;
+
+            // Returns whether `additional` bytes fit under the limit, giving the
+            // near-limit callback a chance to raise it first.
+            bool Reserve(size_t additional)
+            {
+                if (Limit == 0)
+                {
+                    return true;
+                }
+
+                while (Pool.BytesInUse() + additional > Limit)
+                {
+                    const size_t limit = NearLimit ? NearLimit(Limit, InitialLimit) : Limit;
+                    if (limit <= Limit)
+                    {
+                        return false;
+                    }
+                    Limit = limit;
+                }
+                return true;
+            }
+        };
+
+        // QuickJS polls this periodically while running script. Returning
+        // nonzero aborts the script with an uncatchable error.
+        int PollInterrupts(JSRuntime*, void* opaque)
+        {
+            auto& interrupts = *static_cast<InterruptQueue*>(opaque);
+            if (interrupts.TerminationRequested())
+            {
+                return 1;
+            }
+            if (interrupts.Pending())
+            {
+                interrupts.RunAttached();
+            }
+            return 0;
+        }
+
+        // Routes every QuickJS allocation through the runtime's pool. QuickJS
+        // frees without a size, so each block starts with a header holding the
+        // requested size (padded to keep the payload maximally aligned).
+        struct PooledMallocFunctions
+        {
+            static constexpr size_t HeaderSize{alignof(std::max_align_t)};
+
+            static size_t& RequestedSize(void* ptr)
+            {
+                return *reinterpret_cast<size_t*>(static_cast<char*>(ptr) - HeaderSize);
+            }
+
+            static void* AllocateBlock(PooledMallocState& state, size_t size)
+            {
+                auto* block = static_cast<char*>(state.Pool.Allocate(HeaderSize + size));
+                if (block == nullptr)
+                {
+                    return nullptr;
+                }
+
+                *reinterpret_cast<size_t*>(block) = size;
+                return block + HeaderSize;
+            }
+
+            static void* Malloc(void* opaque, size_t size)
+            {
+                auto& state = *static_cast<PooledMallocState*>(opaque);
+                return state.Reserve(HeaderSize + size) ? AllocateBlock(state, size) : nullptr;
+            }
+
+            static void* Calloc(void* opaque, size_t count, size_t size)
+            {
+                if (size != 0 && count > SIZE_MAX / size)
+                {
+                    return nullptr;
+                }
+
+                void* ptr = Malloc(opaque, count * size);
+                if (ptr != nullptr)
+                {
+                    std::memset(ptr, 0, count * size);
+                }
+                return ptr;
+            }
+
+            static void Free(void* opaque, void* ptr)
+            {
+                if (ptr != nullptr)
+                {
+                    static_cast<PooledMallocState*>(opaque)->Pool.Free(static_cast<char*>(ptr) - HeaderSize, HeaderSize + RequestedSize(ptr));
+                }
+            }
+
+            static void* Realloc(void* opaque, void* ptr, size_t size)
+            {
+                if (ptr == nullptr)
+                {
+                    return size == 0 ? nullptr : Malloc(opaque, size);
+                }
+
+                if (size == 0)
+                {
+                    Free(opaque, ptr);
+                    return nullptr;
+                }
+
+                auto& state = *static_cast<PooledMallocState*>(opaque);
+                const size_t oldSize = RequestedSize(ptr);
+                if (size > oldSize && !state.Reserve(size - oldSize))
+                {
+                    return nullptr;
+                }
+
+                auto* block = static_cast<char*>(state.Pool.Reallocate(static_cast<char*>(ptr) - HeaderSize, HeaderSize + oldSize, HeaderSize + size));
+                if (block == nullptr)
+                {
+                    return nullptr;
+                }
+
+                *reinterpret_cast<size_t*>(block) = size;
+                return block + HeaderSize;
+            }
+
+            static size_t UsableSize(const void* ptr)
+            {
+                return RequestedSize(const_cast<void*>(ptr));
+            }
+
+            static JSMallocFunctions Functions()
+            {
+                JSMallocFunctions functions{};
+                functions.js_calloc = &Calloc;
+                functions.js_malloc = &Malloc;
+                functions.js_free = &Free;
+                functions.js_realloc = &Realloc;
+                functions.js_malloc_usable_size = &UsableSize;
+                return functions;
+            }
+        };
+    }
+
     void AppRuntime::RunEnvironmentTier(const char* /*executablePath*/)
     {
         // Create the runtime.
-        JSRuntime* runtime = JS_NewRuntime();
+        auto enginePhase = m_startup->Begin("AppRuntime::InitializeEngine");
+        PooledMallocState mallocState{*m_allocator, m_options.MaxHeapSize, m_options.MaxHeapSize, m_options.NearHeapLimitCallback};
+        const JSMallocFunctions mallocFunctions = PooledMallocFunctions::Functions();
+        JSRuntime* runtime = JS_NewRuntime2(&mallocFunctions, &mallocState);
         if (!runtime)
         {
             throw std::runtime_error{"Failed to create QuickJS runtime"};
         }
 
+        if (m_options.GCThreshold != 0)
+        {
+            JS_SetGCThreshold(runtime, m_options.GCThreshold);
+        }
+        if (m_options.MaxStackSize != 0)
+        {
+            JS_SetMaxStackSize(runtime, m_options.MaxStackSize);
+        }
+        JS_SetCanBlock(runtime, m_options.AllowAtomicsWait);
+
+        enginePhase.End();
+
         // Create the context.
+        auto contextPhase = m_startup->Begin("AppRuntime::CreateContext");
         JSContext* context = JS_NewContext(runtime);
         if (!context)
         {
@@ -40,9 +215,18 @@ namespace Babylon
         // Use the context within a scope.
         {
             Napi::Env env = Napi::Attach(context);
+            contextPhase.End();
+
+            // Nothing to trigger: PollInterrupts checks the flags that pushing a
+            // callback or requesting termination set.
+            m_interrupts->Attach(env, [] {}, [] {});
+            JS_SetInterruptHandler(runtime, &PollInterrupts, m_interrupts.get());
 
             Run(env);
 
+            JS_SetInterruptHandler(runtime, nullptr, nullptr);
+            m_interrupts->Detach();
+
             Napi::Detach(env);
         }
 
@@ -64,4 +248,80 @@ namespace Babylon
         {
         }
     }
+
+    void AppRuntime::CollectIdleGarbage(Napi::Env env, std::chrono::milliseconds)
+    {
+        // QuickJS has no GC callbacks, so only the collections requested here
+        // are recorded.
+        m_gcRecorder->Start(GCKind::Major);
+        JS_RunGC(JS_GetRuntime(Napi::GetContext(env)));
+        m_gcRecorder->End(GCKind::Major);
+    }
+
+    void AppRuntime::ReclaimMemory(Napi::Env env, MemoryPressureLevel)
+    {
+        m_gcRecorder->Start(GCKind::Major);
+        JS_RunGC(JS_GetRuntime(Napi::GetContext(env)));
+        m_gcRecorder->End(GCKind::Major);
+    }
+
+    bool BABYLON_API AppRuntime::SupportsContexts()
+    {
+        return true;
+    }
+
+    Napi::Env AppRuntime::CreateEnvironment(Napi::Env env)
+    {
+        JSContext* context = JS_NewContext(JS_GetRuntime(Napi::GetContext(env)));
+        if (!context)
+        {
+            throw std::runtime_error{"Failed to create QuickJS context"};
+        }
+        return Napi::Attach(context);
+    }
+
+    void AppRuntime::DestroyEnvironment(Napi::Env env)
+    {
+        JSContext* context = Napi::GetContext(env);
+        Napi::Detach(env);
+        JS_FreeContext(context);
+    }
+
+    void AppRuntime::EnterEnvironment(Napi::Env)
+    {
+        // Every QuickJS call names its context.
+    }
+
+    void AppRuntime::ExitEnvironment(Napi::Env)
+    {
+    }
+
+    std::string AppRuntime::CaptureStack(Napi::Env env)
+    {
+        // JS_NewError records the backtrace of the running frames natively (only
+        // a script-defined Error.prepareStackTrace would run JavaScript).
+        JSContext* context = Napi::GetContext(env);
+        JSValue error = JS_NewError(context);
+        JSValue stackValue = JS_GetPropertyStr(context, error, "stack");
+
+        std::string stack{};
+        if (JS_IsString(stackValue))
+        {
+            size_t length{};
+            const char* data = JS_ToCStringLen(context, &length, stackValue);
+            if (data != nullptr)
+            {
+                stack.assign(data, length);
+                JS_FreeCString(context, data);
+            }
+        }
+        else if (JS_IsException(stackValue))
+        {
+            JS_FreeValue(context, JS_GetException(context));
+        }
+
+        JS_FreeValue(context, stackValue);
+        JS_FreeValue(context, error);
+        return stack;
+    }
 }
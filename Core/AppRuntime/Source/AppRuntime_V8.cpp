@@ -1,4 +1,8 @@
 #include "AppRuntime.h"
+#include "PooledAllocator.h"
+#include "GCRecorder.h"
+#include "InterruptQueue.h"
+#include "StartupRecorder.h"
 #include <napi/env.h>
 
 #include <libplatform/libplatform.h>
@@ -7,6 +11,7 @@
 #include <V8InspectorAgent.h>
 #endif
 
+#include <memory>
 #include <optional>
 
 namespace Babylon
@@ -16,11 +21,25 @@ namespace Babylon
         class Module final
         {
         public:
-            Module(const char* executablePath)
+            Module(const char* executablePath, const AppRuntime::Options& options)
             {
                 v8::V8::InitializeICUDefaultLocation(executablePath);
                 v8::V8::InitializeExternalStartupData(executablePath);
-                m_platform = v8::platform::NewDefaultPlatform();
+
+                // Flags are frozen by V8::Initialize, so they can only be set here.
+                if (!options.EnableJIT)
+                {
+                    v8::V8::SetFlagsFromString("--jitless");
+                }
+                if (!options.V8Flags.empty())
+                {
+                    v8::V8::SetFlagsFromString(options.V8Flags.c_str(), options.V8Flags.size());
+                }
+
+                // Idle tasks pile up unless something runs them, so they are only
+                // enabled for idle-time GC.
+                m_idleTasks = options.IdleGCInterval.count() > 0;
+                m_platform = v8::platform::NewDefaultPlatform(0, m_idleTasks ? v8::platform::IdleTaskSupport::kEnabled : v8::platform::IdleTaskSupport::kDisabled);
                 v8::V8::InitializePlatform(m_platform.get());
                 v8::V8::Initialize();
             }
@@ -31,11 +50,11 @@ namespace Babylon
                 v8::V8::DisposePlatform();
             }
 
-            static void Initialize(const char* executablePath)
+            static void Initialize(const char* executablePath, const AppRuntime::Options& options)
             {
                 if (s_module == nullptr)
                 {
-                    s_module = std::make_unique<Module>(executablePath);
+                    s_module = std::make_unique<Module>(executablePath, options);
                 }
             }
 
@@ -54,32 +73,148 @@ namespace Babylon
                 return *m_platform;
             }
 
+            bool IdleTasksEnabled() const
+            {
+                return m_idleTasks;
+            }
+
         private:
             std::unique_ptr<v8::Platform> m_platform;
+            bool m_idleTasks{};
 
             static std::unique_ptr<Module> s_module;
         };
 
         std::unique_ptr<Module> Module::s_module;
+
+        AppRuntime::GCKind ToGCKind(v8::GCType type)
+        {
+            if ((type & v8::kGCTypeScavenge) != 0)
+            {
+                return AppRuntime::GCKind::Minor;
+            }
+            if ((type & v8::kGCTypeMarkSweepCompact) != 0)
+            {
+                return AppRuntime::GCKind::Major;
+            }
+            return AppRuntime::GCKind::Other;
+        }
+
+        void GCPrologue(v8::Isolate*, v8::GCType type, v8::GCCallbackFlags, void* data)
+        {
+            static_cast<GCRecorder*>(data)->Start(ToGCKind(type));
+        }
+
+        void GCEpilogue(v8::Isolate*, v8::GCType type, v8::GCCallbackFlags, void* data)
+        {
+            static_cast<GCRecorder*>(data)->End(ToGCKind(type));
+        }
+
+        void RunInterrupts(v8::Isolate*, void* data)
+        {
+            static_cast<InterruptQueue*>(data)->RunAttached();
+        }
+
+        size_t NearHeapLimit(void* data, size_t currentHeapLimit, size_t initialHeapLimit)
+        {
+            const auto& callback = *static_cast<const std::function<size_t(size_t, size_t)>*>(data);
+            return callback(currentHeapLimit, initialHeapLimit);
+        }
+
+#ifndef V8_ENABLE_SANDBOX
+        class PooledArrayBufferAllocator final : public v8::ArrayBuffer::Allocator
+        {
+        public:
+            PooledArrayBufferAllocator(std::shared_ptr<PooledAllocator> pool)
+                : m_pool{std::move(pool)}
+            {
+            }
+
+            void* Allocate(size_t length) override
+            {
+                return m_pool->AllocateZeroed(length);
+            }
+
+            void* AllocateUninitialized(size_t length) override
+            {
+                return m_pool->Allocate(length);
+            }
+
+            void Free(void* data, size_t length) override
+            {
+                m_pool->Free(data, length);
+            }
+
+        private:
+            const std::shared_ptr<PooledAllocator> m_pool;
+        };
+#endif
     }
 
     void AppRuntime::RunEnvironmentTier(const char* executablePath)
     {
         // Create the isolate.
-        Module::Initialize(executablePath);
+        auto enginePhase = m_startup->Begin("AppRuntime::InitializeEngine");
+        Module::Initialize(executablePath, m_options);
 
+        // Shared rather than owned by this frame: every backing store the
+        // isolate allocates keeps the allocator alive, and a store transferred
+        // to another runtime can outlive the isolate. With the sandbox enabled,
+        // ArrayBuffer memory has to come from inside it, which only V8's own
+        // allocator provides, so the pool isn't used there.
         v8::Isolate::CreateParams create_params;
-        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+#ifdef V8_ENABLE_SANDBOX
+        create_params.array_buffer_allocator_shared = std::shared_ptr<v8::ArrayBuffer::Allocator>{v8::ArrayBuffer::Allocator::NewDefaultAllocator()};
+#else
+        create_params.array_buffer_allocator_shared = std::make_shared<PooledArrayBufferAllocator>(m_allocator);
+#endif
+        if (m_options.InitialHeapSize != 0 || m_options.MaxHeapSize != 0)
+        {
+            create_params.constraints.ConfigureDefaultsFromHeapSize(m_options.InitialHeapSize, m_options.MaxHeapSize);
+        }
         v8::Isolate* isolate = v8::Isolate::New(create_params);
 
+        if (m_options.NearHeapLimitCallback)
+        {
+            isolate->AddNearHeapLimitCallback(&NearHeapLimit, &m_options.NearHeapLimitCallback);
+        }
+
+        isolate->AddGCPrologueCallback(&GCPrologue, m_gcRecorder.get());
+        isolate->AddGCEpilogueCallback(&GCEpilogue, m_gcRecorder.get());
+
+        isolate->SetAllowAtomicsWait(m_options.AllowAtomicsWait);
+
+        // V8 takes the stack limit as an address, measured down from the current
+        // frame since this function sits at the bottom of the JavaScript thread.
+        if (m_options.MaxStackSize != 0)
+        {
+            const uintptr_t stackPosition = reinterpret_cast<uintptr_t>(&create_params);
+            isolate->SetStackLimit(stackPosition > m_options.MaxStackSize ? stackPosition - m_options.MaxStackSize : 0);
+        }
+        enginePhase.End();
+
         // Use the isolate within a scope.
         {
             v8::Isolate::Scope isolate_scope{isolate};
             v8::HandleScope isolate_handle_scope{isolate};
+            auto contextPhase = m_startup->Begin("AppRuntime::CreateContext");
             v8::Local<v8::Context> context = v8::Context::New(isolate);
             v8::Context::Scope context_scope{context};
 
             Napi::Env env = Napi::Attach(context);
+            contextPhase.End();
+
+            m_interrupts->Attach(
+                env,
+                [isolate, interrupts = m_interrupts.get()]() {
+                    isolate->RequestInterrupt(&RunInterrupts, interrupts);
+                },
+                [isolate]() {
+                    isolate->TerminateExecution();
+                },
+                [isolate]() {
+                    isolate->CancelTerminateExecution();
+                });
 
 #ifdef ENABLE_V8_INSPECTOR
             std::optional<V8InspectorAgent> agent;
@@ -97,6 +232,8 @@ namespace Babylon
 
             Run(env);
 
+            m_interrupts->Detach();
+
 #ifdef ENABLE_V8_INSPECTOR
             if (agent.has_value())
             {
@@ -108,8 +245,12 @@ namespace Babylon
         }
 
         // Destroy the isolate.
-        // todo : GetArrayBufferAllocator not available?
-        // delete isolate->GetArrayBufferAllocator();
+        isolate->RemoveGCPrologueCallback(&GCPrologue, m_gcRecorder.get());
+        isolate->RemoveGCEpilogueCallback(&GCEpilogue, m_gcRecorder.get());
+        if (m_options.NearHeapLimitCallback)
+        {
+            isolate->RemoveNearHeapLimitCallback(&NearHeapLimit, 0);
+        }
         isolate->Dispose();
     }
 
@@ -118,4 +259,96 @@ namespace Babylon
         // V8 auto-drains microtasks at the end of each script/callback when
         // using the default MicrotasksPolicy.  No explicit pump needed.
     }
+
+    void AppRuntime::CollectIdleGarbage(Napi::Env env, std::chrono::milliseconds budget)
+    {
+        v8::Platform& platform = Module::Instance().Platform();
+        v8::Isolate* isolate = Napi::GetContext(env)->GetIsolate();
+        const double deadline = platform.MonotonicallyIncreasingTime() + std::chrono::duration<double>{budget}.count();
+
+        // Pending foreground tasks (GC finalization among them) go first, then
+        // idle tasks get whatever time is left.
+        while (platform.MonotonicallyIncreasingTime() < deadline && v8::platform::PumpMessageLoop(&platform, isolate))
+        {
+        }
+
+        const double remaining = deadline - platform.MonotonicallyIncreasingTime();
+        if (Module::Instance().IdleTasksEnabled() && remaining > 0)
+        {
+            v8::platform::RunIdleTasks(&platform, isolate, remaining);
+        }
+    }
+
+    void AppRuntime::ReclaimMemory(Napi::Env env, MemoryPressureLevel level)
+    {
+        v8::Isolate* isolate = Napi::GetContext(env)->GetIsolate();
+        if (level == MemoryPressureLevel::Critical)
+        {
+            // Runs full collections until no more memory is freed.
+            isolate->LowMemoryNotification();
+        }
+        else
+        {
+            isolate->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+        }
+    }
+
+    bool BABYLON_API AppRuntime::SupportsContexts()
+    {
+        return true;
+    }
+
+    Napi::Env AppRuntime::CreateEnvironment(Napi::Env env)
+    {
+        v8::Isolate* isolate = Napi::GetContext(env)->GetIsolate();
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope{context};
+        return Napi::Attach(context);
+    }
+
+    void AppRuntime::DestroyEnvironment(Napi::Env env)
+    {
+        // Finalizers run by Detach create objects in the entered context.
+        v8::Context::Scope context_scope{Napi::GetContext(env)};
+        Napi::Detach(env);
+    }
+
+    void AppRuntime::EnterEnvironment(Napi::Env env)
+    {
+        Napi::GetContext(env)->Enter();
+    }
+
+    void AppRuntime::ExitEnvironment(Napi::Env env)
+    {
+        Napi::GetContext(env)->Exit();
+    }
+
+    std::string AppRuntime::CaptureStack(Napi::Env env)
+    {
+        constexpr int MaxFrames{64};
+
+        v8::Isolate* isolate = Napi::GetContext(env)->GetIsolate();
+        v8::HandleScope scope{isolate};
+        v8::Local<v8::StackTrace> trace = v8::StackTrace::CurrentStackTrace(isolate, MaxFrames);
+
+        // Formatted like the frames of Error.prototype.stack.
+        std::string stack{};
+        for (int index = 0; index < trace->GetFrameCount(); ++index)
+        {
+            v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, index);
+            const v8::String::Utf8Value function{isolate, frame->GetFunctionName()};
+            const v8::String::Utf8Value script{isolate, frame->GetScriptName()};
+
+            if (!stack.empty())
+            {
+                stack += '\n';
+            }
+            stack += "    at ";
+            stack += function.length() > 0 ? *function : "<anonymous>";
+            stack += " (";
+            stack += script.length() > 0 ? *script : "<anonymous>";
+            stack += ':' + std::to_string(frame->GetLineNumber()) + ':' + std::to_string(frame->GetColumn()) + ')';
+        }
+        return stack;
+    }
 }
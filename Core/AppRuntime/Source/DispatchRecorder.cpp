@@ -0,0 +1,110 @@
+#include "DispatchRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Babylon
+{
+    namespace
+    {
+        void Add(AppRuntime::DurationHistogram& histogram, std::chrono::nanoseconds duration)
+        {
+            const auto microseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+            size_t bucket = 0;
+            while (bucket + 1 < AppRuntime::DurationHistogram::BucketCount && (uint64_t{1} << bucket) <= microseconds)
+            {
+                ++bucket;
+            }
+
+            ++histogram.Buckets[bucket];
+            ++histogram.Count;
+            histogram.Total += duration;
+            histogram.Max = std::max(histogram.Max, duration);
+        }
+    }
+
+    std::chrono::nanoseconds AppRuntime::DurationHistogram::Percentile(double percentile) const
+    {
+        if (Count == 0)
+        {
+            return {};
+        }
+
+        const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(Count)));
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket + 1 < BucketCount; ++bucket)
+        {
+            seen += Buckets[bucket];
+            if (seen >= rank)
+            {
+                return std::min<std::chrono::nanoseconds>(std::chrono::microseconds{uint64_t{1} << bucket}, Max);
+            }
+        }
+        return Max;
+    }
+
+    AppRuntime::DispatchRecorder::DispatchRecorder(bool enabled)
+        : m_enabled{enabled}
+    {
+    }
+
+    AppRuntime::DispatchRecorder::TimePoint AppRuntime::DispatchRecorder::Enqueued()
+    {
+        if (!m_enabled)
+        {
+            return {};
+        }
+
+        const size_t depth = ++m_queueDepth;
+        size_t maxDepth = m_maxQueueDepth;
+        while (depth > maxDepth && !m_maxQueueDepth.compare_exchange_weak(maxDepth, depth))
+        {
+        }
+
+        return std::chrono::steady_clock::now();
+    }
+
+    AppRuntime::DispatchRecorder::TimePoint AppRuntime::DispatchRecorder::Started()
+    {
+        if (!m_enabled)
+        {
+            return {};
+        }
+
+        --m_queueDepth;
+        return std::chrono::steady_clock::now();
+    }
+
+    AppRuntime::DispatchRecorder::TimePoint AppRuntime::DispatchRecorder::Executed()
+    {
+        return m_enabled ? std::chrono::steady_clock::now() : TimePoint{};
+    }
+
+    void AppRuntime::DispatchRecorder::Drained(TimePoint enqueued, TimePoint started, TimePoint executed)
+    {
+        if (!m_enabled)
+        {
+            return;
+        }
+
+        const TimePoint drained = std::chrono::steady_clock::now();
+
+        std::scoped_lock lock{m_mutex};
+        Add(m_metrics.QueueLatency, started - enqueued);
+        Add(m_metrics.Execution, executed - started);
+        Add(m_metrics.MicrotaskDrain, drained - executed);
+    }
+
+    AppRuntime::DispatchMetrics AppRuntime::DispatchRecorder::GetMetrics() const
+    {
+        DispatchMetrics metrics{};
+        {
+            std::scoped_lock lock{m_mutex};
+            metrics = m_metrics;
+        }
+
+        metrics.QueueDepth = m_queueDepth;
+        metrics.MaxQueueDepth = m_maxQueueDepth;
+        return metrics;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "AppRuntime.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace Babylon
+{
+    // Collects DispatchMetrics. Every method returns immediately (without
+    // reading the clock) when metrics are disabled.
+    class AppRuntime::DispatchRecorder final
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        DispatchRecorder(bool enabled);
+
+        // Called from Dispatch, on any thread.
+        TimePoint Enqueued();
+
+        // Called on the JavaScript thread when the callback starts, once it
+        // returns, and once its microtasks are drained.
+        TimePoint Started();
+        TimePoint Executed();
+        void Drained(TimePoint enqueued, TimePoint started, TimePoint executed);
+
+        DispatchMetrics GetMetrics() const;
+
+    private:
+        const bool m_enabled;
+
+        std::atomic<size_t> m_queueDepth{};
+        std::atomic<size_t> m_maxQueueDepth{};
+
+        mutable std::mutex m_mutex{};
+        DispatchMetrics m_metrics{};
+    };
+}
@@ -0,0 +1,97 @@
+#include "GCRecorder.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Babylon
+{
+    namespace
+    {
+        constexpr std::array<const char*, 3> RegionNames{"GC::Minor", "GC::Major", "GC::Other"};
+    }
+
+    void GCRecorder::Start(AppRuntime::GCKind kind, bool timed)
+    {
+        const auto index = static_cast<size_t>(kind);
+        {
+            std::scoped_lock lock{m_mutex};
+            ++m_statistics.Collections;
+            if (timed)
+            {
+                m_starts[index] = std::chrono::steady_clock::now();
+                m_regions[index].emplace(RegionNames[index]);
+            }
+        }
+
+        Publish({AppRuntime::GCPhase::Start, kind, {}});
+    }
+
+    void GCRecorder::End(AppRuntime::GCKind kind)
+    {
+        const auto index = static_cast<size_t>(kind);
+        std::chrono::nanoseconds duration{};
+        {
+            std::scoped_lock lock{m_mutex};
+            if (!m_starts[index].has_value())
+            {
+                return;
+            }
+
+            duration = std::chrono::steady_clock::now() - *m_starts[index];
+            m_starts[index].reset();
+            m_regions[index].reset();
+
+            const auto& bounds = AppRuntime::GCStatistics::PauseBucketBounds;
+            const auto bucket = std::upper_bound(bounds.begin(), bounds.end(), duration) - bounds.begin();
+            ++m_statistics.PauseHistogram[bucket];
+            m_statistics.TotalPause += duration;
+            m_statistics.LongestPause = std::max(m_statistics.LongestPause, duration);
+        }
+
+        Publish({AppRuntime::GCPhase::End, kind, duration});
+    }
+
+    uint32_t GCRecorder::Subscribe(std::function<void(const AppRuntime::GCEvent&)> handler)
+    {
+        std::scoped_lock lock{m_mutex};
+        const uint32_t subscription = m_nextSubscription++;
+        m_handlers.emplace(subscription, std::move(handler));
+        return subscription;
+    }
+
+    void GCRecorder::Unsubscribe(uint32_t subscription)
+    {
+        std::scoped_lock lock{m_mutex};
+        m_handlers.erase(subscription);
+    }
+
+    AppRuntime::GCStatistics GCRecorder::GetStatistics() const
+    {
+        std::scoped_lock lock{m_mutex};
+        return m_statistics;
+    }
+
+    void GCRecorder::Publish(const AppRuntime::GCEvent& event)
+    {
+        // Handlers run outside the lock so they can unsubscribe.
+        std::vector<std::function<void(const AppRuntime::GCEvent&)>> handlers;
+        {
+            std::scoped_lock lock{m_mutex};
+            if (m_handlers.empty())
+            {
+                return;
+            }
+
+            handlers.reserve(m_handlers.size());
+            for (const auto& [subscription, handler] : m_handlers)
+            {
+                handlers.push_back(handler);
+            }
+        }
+
+        for (const auto& handler : handlers)
+        {
+            handler(event);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "AppRuntime.h"
+
+#include <arcana/tracing/trace_region.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace Babylon
+{
+    // Turns the engine's GC notifications into GCEvents, GCStatistics and trace
+    // regions. Engines may report from their own GC threads, and may run a minor
+    // collection while a major one is in progress, so each kind is timed on its
+    // own.
+    class GCRecorder final
+    {
+    public:
+        // `timed` is false for engines that only report the start of a collection;
+        // such starts are counted and published but not timed or traced.
+        void Start(AppRuntime::GCKind kind, bool timed = true);
+        void End(AppRuntime::GCKind kind);
+
+        uint32_t Subscribe(std::function<void(const AppRuntime::GCEvent&)> handler);
+        void Unsubscribe(uint32_t subscription);
+
+        AppRuntime::GCStatistics GetStatistics() const;
+
+    private:
+        static constexpr size_t KindCount{3};
+
+        void Publish(const AppRuntime::GCEvent& event);
+
+        mutable std::mutex m_mutex{};
+        std::map<uint32_t, std::function<void(const AppRuntime::GCEvent&)>> m_handlers{};
+        uint32_t m_nextSubscription{1};
+
+        std::array<std::optional<std::chrono::steady_clock::time_point>, KindCount> m_starts{};
+        std::array<std::optional<arcana::trace_region>, KindCount> m_regions{};
+        AppRuntime::GCStatistics m_statistics{};
+    };
+}
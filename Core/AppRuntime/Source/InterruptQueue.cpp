@@ -0,0 +1,125 @@
+#include "InterruptQueue.h"
+
+#include <cassert>
+
+namespace Babylon
+{
+    InterruptQueue::InterruptQueue(const std::function<void(const Napi::Error&)>& unhandledExceptionHandler)
+        : m_unhandledExceptionHandler{unhandledExceptionHandler}
+    {
+    }
+
+    void InterruptQueue::Attach(Napi::Env env, std::function<void()> trigger, std::function<void()> terminate, std::function<void()> resume)
+    {
+        m_env.emplace(env);
+
+        std::scoped_lock lock{m_mutex};
+        m_trigger = std::move(trigger);
+        m_terminate = std::move(terminate);
+        m_resume = std::move(resume);
+    }
+
+    void InterruptQueue::Detach()
+    {
+        {
+            std::scoped_lock lock{m_mutex};
+            m_trigger = {};
+            m_terminate = {};
+            m_resume = {};
+        }
+
+        m_env.reset();
+    }
+
+    void InterruptQueue::Push(Dispatchable<void(Napi::Env)> callback)
+    {
+        // The trigger is called under the lock so Detach can't tear the engine
+        // down while it runs.
+        std::scoped_lock lock{m_mutex};
+        m_callbacks.push_back(std::move(callback));
+        m_pending.store(true, std::memory_order_release);
+        if (m_trigger)
+        {
+            m_trigger();
+        }
+    }
+
+    bool InterruptQueue::TryPush(Dispatchable<void(Napi::Env)> callback)
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_trigger)
+        {
+            return false;
+        }
+
+        m_callbacks.push_back(std::move(callback));
+        m_pending.store(true, std::memory_order_release);
+        m_trigger();
+        return true;
+    }
+
+    bool InterruptQueue::RequestTermination()
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_terminate)
+        {
+            return false;
+        }
+
+        m_terminationRequested.store(true, std::memory_order_release);
+        m_terminate();
+        return true;
+    }
+
+    void InterruptQueue::ResumeExecution()
+    {
+        std::scoped_lock lock{m_mutex};
+        m_terminationRequested.store(false, std::memory_order_release);
+        if (m_resume)
+        {
+            m_resume();
+        }
+    }
+
+    void InterruptQueue::Run(Napi::Env env)
+    {
+        std::vector<Dispatchable<void(Napi::Env)>> callbacks;
+        {
+            std::scoped_lock lock{m_mutex};
+            if (m_callbacks.empty())
+            {
+                return;
+            }
+
+            callbacks.swap(m_callbacks);
+            m_pending.store(false, std::memory_order_release);
+        }
+
+        for (auto& callback : callbacks)
+        {
+            Napi::HandleScope scope{env};
+
+            try
+            {
+                callback(env);
+            }
+            catch (const Napi::Error& error)
+            {
+                m_unhandledExceptionHandler(error);
+            }
+            catch (...)
+            {
+                assert(false);
+                std::abort();
+            }
+        }
+    }
+
+    void InterruptQueue::RunAttached()
+    {
+        if (m_env.has_value())
+        {
+            Run(*m_env);
+        }
+    }
+}
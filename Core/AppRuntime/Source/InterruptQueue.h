@@ -0,0 +1,75 @@
+#pragma once
+
+#include "AppRuntime.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Babylon
+{
+    // Callbacks passed to RequestInterrupt. They are drained either by the
+    // engine at its next safe point (when the engine tier has attached a
+    // trigger) or by a regular dispatch, whichever comes first. Also carries
+    // the engine's means of terminating running script, used by the watchdog.
+    class InterruptQueue final
+    {
+    public:
+        InterruptQueue(const std::function<void(const Napi::Error&)>& unhandledExceptionHandler);
+
+        // Called by engine tiers that can interrupt or terminate running script.
+        // `trigger` asks the engine to call RunAttached at its next safe point and
+        // `terminate` asks it to abort the running script; both may be called from
+        // any thread until Detach returns. `resume` is called on the JavaScript
+        // thread once a terminated callback has unwound. Any of them may be empty.
+        void Attach(Napi::Env env, std::function<void()> trigger, std::function<void()> terminate = {}, std::function<void()> resume = {});
+        void Detach();
+
+        // Safe to call from any thread.
+        void Push(Dispatchable<void(Napi::Env)> callback);
+
+        // Like Push, but only queues the callback when the engine can run it at a
+        // safe point, and returns whether it did. Safe to call from any thread.
+        bool TryPush(Dispatchable<void(Napi::Env)> callback);
+
+        // Returns whether the engine could be asked to terminate. Safe to call
+        // from any thread.
+        bool RequestTermination();
+
+        // Checked by engines that poll for termination.
+        bool TerminationRequested() const
+        {
+            return m_terminationRequested.load(std::memory_order_acquire);
+        }
+
+        // Lets script run again after a termination. Called on the JavaScript
+        // thread once the terminated callback has returned.
+        void ResumeExecution();
+
+        // Cheap check for engines that poll for interrupts.
+        bool Pending() const
+        {
+            return m_pending.load(std::memory_order_acquire);
+        }
+
+        // Runs the queued callbacks on the JavaScript thread.
+        void Run(Napi::Env env);
+        void RunAttached();
+
+    private:
+        const std::function<void(const Napi::Error&)>& m_unhandledExceptionHandler;
+
+        std::mutex m_mutex{};
+        std::vector<Dispatchable<void(Napi::Env)>> m_callbacks{};
+        std::function<void()> m_trigger{};
+        std::function<void()> m_terminate{};
+        std::function<void()> m_resume{};
+        std::atomic<bool> m_pending{};
+        std::atomic<bool> m_terminationRequested{};
+
+        // Only touched on the JavaScript thread.
+        std::optional<Napi::Env> m_env{};
+    };
+}
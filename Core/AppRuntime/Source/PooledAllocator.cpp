@@ -0,0 +1,281 @@
+#include "PooledAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace Babylon
+{
+    namespace
+    {
+        template<typename BlockT>
+        void FreeAll(BlockT* block)
+        {
+            while (block != nullptr)
+            {
+                BlockT* next = block->Next;
+                std::free(block);
+                block = next;
+            }
+        }
+    }
+
+    PooledAllocator::~PooledAllocator()
+    {
+        for (auto& sizeClass : m_classes)
+        {
+            FreeAll(sizeClass.Head);
+            FreeAll(sizeClass.Remote.load());
+        }
+    }
+
+    void PooledAllocator::BindToCurrentThread()
+    {
+        m_owner = std::this_thread::get_id();
+    }
+
+    void* PooledAllocator::Allocate(size_t size)
+    {
+        void* data = Take(size);
+        if (data != nullptr)
+        {
+            Track(size);
+        }
+        return data;
+    }
+
+    void* PooledAllocator::AllocateZeroed(size_t size)
+    {
+        if (size > ClassSize(ClassCount - 1))
+        {
+            // Large blocks are never pooled; calloc can hand out pages that are
+            // already zero instead of clearing them here.
+            void* data = std::calloc(1, size);
+            if (data != nullptr)
+            {
+                Track(size);
+            }
+            return data;
+        }
+
+        void* data = Allocate(size);
+        if (data != nullptr)
+        {
+            std::memset(data, 0, size);
+        }
+        return data;
+    }
+
+    void PooledAllocator::Free(void* data, size_t size)
+    {
+        if (data == nullptr)
+        {
+            return;
+        }
+
+        m_bytesInUse -= size;
+
+        const size_t index = ClassIndex(size);
+        if (index < ClassCount)
+        {
+            const size_t classSize = ClassSize(index);
+            auto& sizeClass = m_classes[index];
+            auto* block = static_cast<FreeBlock*>(data);
+
+            if (!OnOwnerThread())
+            {
+                if (sizeClass.RemoteCount.fetch_add(1, std::memory_order_relaxed) < MaxCachedBytesPerClass / classSize)
+                {
+                    block->Next = sizeClass.Remote.load(std::memory_order_relaxed);
+                    while (!sizeClass.Remote.compare_exchange_weak(block->Next, block, std::memory_order_release, std::memory_order_relaxed))
+                    {
+                    }
+                    m_bytesPooled += classSize;
+                    return;
+                }
+
+                sizeClass.RemoteCount.fetch_sub(1, std::memory_order_relaxed);
+                std::free(data);
+                return;
+            }
+
+            if ((sizeClass.Count + 1) * classSize <= MaxCachedBytesPerClass)
+            {
+                block->Next = sizeClass.Head;
+                sizeClass.Head = block;
+                ++sizeClass.Count;
+                m_bytesPooled += classSize;
+                return;
+            }
+        }
+
+        std::free(data);
+    }
+
+    void* PooledAllocator::Reallocate(void* data, size_t oldSize, size_t newSize)
+    {
+        const size_t oldIndex = ClassIndex(oldSize);
+        const size_t newIndex = ClassIndex(newSize);
+        if (oldIndex < ClassCount && oldIndex == newIndex)
+        {
+            TrackResize(oldSize, newSize);
+            return data;
+        }
+
+        if (oldIndex >= ClassCount && newIndex >= ClassCount)
+        {
+            // Neither size is pooled, so realloc may grow or shrink the block
+            // without copying it.
+            void* resized = std::realloc(data, newSize);
+            if (resized != nullptr)
+            {
+                TrackResize(oldSize, newSize);
+            }
+            return resized;
+        }
+
+        void* resized = Allocate(newSize);
+        if (resized != nullptr)
+        {
+            std::memcpy(resized, data, std::min(oldSize, newSize));
+            Free(data, oldSize);
+        }
+        return resized;
+    }
+
+    void PooledAllocator::Trim()
+    {
+        for (size_t index = 0; index < ClassCount; ++index)
+        {
+            auto& sizeClass = m_classes[index];
+            FreeBlock* remote = sizeClass.Remote.exchange(nullptr, std::memory_order_acquire);
+            size_t remoteCount = 0;
+            for (FreeBlock* block = remote; block != nullptr; block = block->Next)
+            {
+                ++remoteCount;
+            }
+            sizeClass.RemoteCount.fetch_sub(remoteCount, std::memory_order_relaxed);
+            const size_t count = sizeClass.Count + remoteCount;
+
+            FreeAll(sizeClass.Head);
+            FreeAll(remote);
+            sizeClass.Head = nullptr;
+            sizeClass.Count = 0;
+            m_bytesPooled -= count * ClassSize(index);
+        }
+    }
+
+    AppRuntime::AllocatorStatistics PooledAllocator::GetStatistics() const
+    {
+        AppRuntime::AllocatorStatistics statistics{};
+        statistics.BytesInUse = m_bytesInUse;
+        statistics.PeakBytesInUse = m_peakBytesInUse;
+        statistics.BytesPooled = m_bytesPooled;
+        statistics.Allocations = m_allocations;
+        statistics.PoolHits = m_poolHits;
+        return statistics;
+    }
+
+    size_t PooledAllocator::ClassIndex(size_t size)
+    {
+        size_t shift = MinClassShift;
+        while ((size_t{1} << shift) < size && shift <= MaxClassShift)
+        {
+            ++shift;
+        }
+        return shift - MinClassShift;
+    }
+
+    size_t PooledAllocator::ClassSize(size_t index)
+    {
+        return size_t{1} << (index + MinClassShift);
+    }
+
+    bool PooledAllocator::OnOwnerThread() const
+    {
+        return std::this_thread::get_id() == m_owner;
+    }
+
+    void* PooledAllocator::Take(size_t size)
+    {
+        const size_t index = ClassIndex(size);
+        if (index >= ClassCount)
+        {
+            return std::malloc(size);
+        }
+
+        if (OnOwnerThread())
+        {
+            auto& sizeClass = m_classes[index];
+            if (sizeClass.Head == nullptr)
+            {
+                Reclaim(index);
+            }
+
+            if (sizeClass.Head != nullptr)
+            {
+                FreeBlock* block = sizeClass.Head;
+                sizeClass.Head = block->Next;
+                --sizeClass.Count;
+                m_bytesPooled -= ClassSize(index);
+                ++m_poolHits;
+                return block;
+            }
+        }
+
+        // Always a whole size class, so the block can be pooled once freed.
+        return std::malloc(ClassSize(index));
+    }
+
+    void PooledAllocator::Reclaim(size_t index)
+    {
+        const size_t classSize = ClassSize(index);
+        auto& sizeClass = m_classes[index];
+        FreeBlock* block = sizeClass.Remote.exchange(nullptr, std::memory_order_acquire);
+        size_t remoteCount = 0;
+        while (block != nullptr)
+        {
+            ++remoteCount;
+            FreeBlock* next = block->Next;
+            if ((sizeClass.Count + 1) * classSize <= MaxCachedBytesPerClass)
+            {
+                block->Next = sizeClass.Head;
+                sizeClass.Head = block;
+                ++sizeClass.Count;
+            }
+            else
+            {
+                std::free(block);
+                m_bytesPooled -= classSize;
+            }
+            block = next;
+        }
+        sizeClass.RemoteCount.fetch_sub(remoteCount, std::memory_order_relaxed);
+    }
+
+    void PooledAllocator::Track(size_t size)
+    {
+        ++m_allocations;
+        UpdatePeak(m_bytesInUse += size);
+    }
+
+    void PooledAllocator::TrackResize(size_t oldSize, size_t newSize)
+    {
+        if (newSize > oldSize)
+        {
+            UpdatePeak(m_bytesInUse += newSize - oldSize);
+        }
+        else
+        {
+            m_bytesInUse -= oldSize - newSize;
+        }
+    }
+
+    void PooledAllocator::UpdatePeak(size_t inUse)
+    {
+        size_t peak = m_peakBytesInUse;
+        while (inUse > peak && !m_peakBytesInUse.compare_exchange_weak(peak, inUse))
+        {
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "AppRuntime.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace Babylon
+{
+    // Size-class allocator that keeps recently freed blocks for reuse. Sizes are
+    // rounded up to a power of two between 16 bytes and 64 KiB, and each class
+    // caches up to 512 KiB of freed blocks; larger requests go straight to the
+    // system allocator.
+    //
+    // The free lists belong to the thread the pool is bound to (the JavaScript
+    // thread) and are used there without locking. Engines may free backing
+    // stores from their GC threads: those blocks are pushed onto a lock-free
+    // list per size class that the owning thread takes over the next time it
+    // runs out of blocks of that size, up to the same limit per class.
+    // Allocations from other threads bypass the pool. The pool can outlive
+    // its thread, as V8 keeps it alive for buffers transferred to another
+    // runtime; their blocks then wait on those lists until it is destroyed.
+    class PooledAllocator final
+    {
+    public:
+        PooledAllocator() = default;
+        ~PooledAllocator();
+
+        PooledAllocator(const PooledAllocator&) = delete;
+        PooledAllocator& operator=(const PooledAllocator&) = delete;
+
+        // Makes the calling thread the owner of the free lists. Called once, on
+        // the JavaScript thread, before the engine starts.
+        void BindToCurrentThread();
+
+        // Returns uninitialized memory, or nullptr when out of memory.
+        void* Allocate(size_t size);
+
+        // Returns zero-filled memory, or nullptr when out of memory.
+        void* AllocateZeroed(size_t size);
+
+        // `size` must be the size that was passed when the block was allocated.
+        void Free(void* data, size_t size);
+
+        // Like realloc: resizes in place while `newSize` stays in the block's
+        // size class, hands blocks too large to pool to realloc, and otherwise
+        // moves the contents to a new block. Returns nullptr (leaving the block
+        // untouched) when out of memory.
+        void* Reallocate(void* data, size_t oldSize, size_t newSize);
+
+        // Returns every pooled block to the system allocator. Called on the
+        // owning thread.
+        void Trim();
+
+        size_t BytesInUse() const
+        {
+            return m_bytesInUse;
+        }
+
+        AppRuntime::AllocatorStatistics GetStatistics() const;
+
+    private:
+        static constexpr size_t MinClassShift{4};
+        static constexpr size_t MaxClassShift{16};
+        static constexpr size_t ClassCount{MaxClassShift - MinClassShift + 1};
+        static constexpr size_t MaxCachedBytesPerClass{512 * 1024};
+
+        // Freed blocks are linked through their first bytes.
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        struct SizeClass
+        {
+            FreeBlock* Head{};
+            size_t Count{};
+
+            // Blocks freed on other threads. They are only ever pushed one at a
+            // time and taken all at once, so a compare-and-swap push is safe.
+            // Capped like the owner's list, as the owner may never take them.
+            std::atomic<FreeBlock*> Remote{};
+            std::atomic<size_t> RemoteCount{};
+        };
+
+        static size_t ClassIndex(size_t size);
+        static size_t ClassSize(size_t index);
+
+        bool OnOwnerThread() const;
+        void* Take(size_t size);
+        void Reclaim(size_t index);
+        void Track(size_t size);
+        void TrackResize(size_t oldSize, size_t newSize);
+        void UpdatePeak(size_t inUse);
+
+        std::thread::id m_owner{};
+        std::array<SizeClass, ClassCount> m_classes{};
+
+        std::atomic<size_t> m_bytesInUse{};
+        std::atomic<size_t> m_peakBytesInUse{};
+        std::atomic<size_t> m_bytesPooled{};
+        std::atomic<uint64_t> m_allocations{};
+        std::atomic<uint64_t> m_poolHits{};
+    };
+}
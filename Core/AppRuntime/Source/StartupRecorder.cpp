@@ -0,0 +1,69 @@
+#include "StartupRecorder.h"
+
+namespace Babylon
+{
+    AppRuntime::StartupRecorder::Phase::Phase(StartupRecorder& recorder, const char* name)
+        : m_recorder{&recorder}
+        , m_name{name}
+        , m_start{StartupTrace::Clock::now()}
+        , m_region{std::in_place, name}
+    {
+    }
+
+    AppRuntime::StartupRecorder::Phase::~Phase()
+    {
+        End();
+    }
+
+    void AppRuntime::StartupRecorder::Phase::End()
+    {
+        if (!m_region.has_value())
+        {
+            return;
+        }
+
+        m_region.reset();
+        const auto end = StartupTrace::Clock::now();
+
+        std::scoped_lock lock{m_recorder->m_mutex};
+        if (m_recorder->m_env.has_value())
+        {
+            StartupTrace::Record(m_recorder->m_env.value(), m_name, {}, m_start, end);
+        }
+        else
+        {
+            m_recorder->m_pending.push_back({m_name, {}, m_start, end - m_start});
+        }
+    }
+
+    void AppRuntime::StartupRecorder::Attach(Napi::Env env)
+    {
+        std::scoped_lock lock{m_mutex};
+        for (auto& phase : m_pending)
+        {
+            StartupTrace::Record(env, std::move(phase.Name), std::move(phase.Detail), phase.Start, phase.Start + phase.Duration);
+        }
+        m_pending.clear();
+        m_env.emplace(env);
+    }
+
+    void AppRuntime::StartupRecorder::Detach()
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_env.has_value())
+        {
+            StartupTrace::Clear(m_env.value());
+            m_env.reset();
+        }
+    }
+
+    std::vector<StartupTrace::Phase> AppRuntime::StartupRecorder::GetReport() const
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_env.has_value())
+        {
+            return StartupTrace::GetReport(m_env.value());
+        }
+        return m_pending;
+    }
+}
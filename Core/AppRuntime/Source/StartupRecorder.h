@@ -0,0 +1,57 @@
+#pragma once
+
+#include "AppRuntime.h"
+
+#include <arcana/tracing/trace_region.h>
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Babylon
+{
+    // Times the startup phases that run before the environment exists (engine
+    // and context creation) and hands them to the environment's StartupTrace
+    // once it does.
+    class AppRuntime::StartupRecorder final
+    {
+    public:
+        // Times a phase from construction until End (or destruction), and traces
+        // it under the same name.
+        class Phase final
+        {
+        public:
+            Phase(StartupRecorder& recorder, const char* name);
+            ~Phase();
+
+            Phase(const Phase&) = delete;
+            Phase& operator=(const Phase&) = delete;
+
+            void End();
+
+        private:
+            StartupRecorder* m_recorder;
+            const char* m_name;
+            StartupTrace::Clock::time_point m_start;
+            std::optional<arcana::trace_region> m_region;
+        };
+
+        Phase Begin(const char* name)
+        {
+            return {*this, name};
+        }
+
+        // Called on the JavaScript thread once the environment is created, and
+        // before it is torn down.
+        void Attach(Napi::Env env);
+        void Detach();
+
+        // Safe to call from any thread.
+        std::vector<StartupTrace::Phase> GetReport() const;
+
+    private:
+        mutable std::mutex m_mutex{};
+        std::vector<StartupTrace::Phase> m_pending{};
+        std::optional<Napi::Env> m_env{};
+    };
+}
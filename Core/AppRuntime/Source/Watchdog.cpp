@@ -0,0 +1,130 @@
+#include "Watchdog.h"
+#include "InterruptQueue.h"
+
+namespace Babylon
+{
+    AppRuntime::Watchdog::Watchdog(const Options& options, InterruptQueue& interrupts)
+        : m_options{options}
+        , m_interrupts{interrupts}
+        , m_enabled{options.LongTaskThreshold.count() > 0 || options.ExecutionTimeLimit.count() > 0}
+    {
+        if (m_enabled)
+        {
+            m_thread = std::thread{[this] { Watch(); }};
+        }
+    }
+
+    AppRuntime::Watchdog::~Watchdog()
+    {
+        if (m_thread.joinable())
+        {
+            {
+                std::scoped_lock lock{m_mutex};
+                m_stopped = true;
+            }
+            m_condition.notify_one();
+            m_thread.join();
+        }
+    }
+
+    void AppRuntime::Watchdog::TaskStarted()
+    {
+        if (!m_enabled)
+        {
+            return;
+        }
+
+        {
+            std::scoped_lock lock{m_mutex};
+            m_running = true;
+            ++m_task;
+            m_start = std::chrono::steady_clock::now();
+            m_stackRequested = false;
+            m_terminationHandled = false;
+            m_terminated = false;
+            m_stack.clear();
+        }
+        m_condition.notify_one();
+    }
+
+    void AppRuntime::Watchdog::TaskFinished()
+    {
+        if (!m_enabled)
+        {
+            return;
+        }
+
+        LongTask task{};
+        {
+            std::scoped_lock lock{m_mutex};
+            m_running = false;
+            task.Duration = std::chrono::steady_clock::now() - m_start;
+            task.Stack = std::move(m_stack);
+            task.Terminated = m_terminated;
+        }
+        m_condition.notify_one();
+
+        // Holding the lock above kept the watchdog from terminating this task
+        // after it finished, so a termination seen here belongs to it.
+        if (task.Terminated)
+        {
+            m_interrupts.ResumeExecution();
+        }
+
+        if (m_options.LongTaskThreshold.count() > 0 && task.Duration >= m_options.LongTaskThreshold && m_options.LongTaskHandler)
+        {
+            m_options.LongTaskHandler(task);
+        }
+    }
+
+    void AppRuntime::Watchdog::Watch()
+    {
+        std::unique_lock lock{m_mutex};
+        while (!m_stopped)
+        {
+            if (!m_running)
+            {
+                m_condition.wait(lock, [this] { return m_stopped || m_running; });
+                continue;
+            }
+
+            // The next limit the running callback hasn't crossed yet.
+            const bool stackDue = m_options.LongTaskThreshold.count() > 0 && !m_stackRequested;
+            const bool terminationDue = m_options.ExecutionTimeLimit.count() > 0 && !m_terminationHandled;
+            if (!stackDue && !terminationDue)
+            {
+                const uint64_t task = m_task;
+                m_condition.wait(lock, [this, task] { return m_stopped || !m_running || m_task != task; });
+                continue;
+            }
+
+            const bool stackFirst = stackDue && (!terminationDue || m_options.LongTaskThreshold < m_options.ExecutionTimeLimit);
+            const auto deadline = m_start + (stackFirst ? m_options.LongTaskThreshold : m_options.ExecutionTimeLimit);
+            const uint64_t task = m_task;
+            if (m_condition.wait_until(lock, deadline, [this, task] { return m_stopped || !m_running || m_task != task; }))
+            {
+                continue;
+            }
+
+            if (stackFirst)
+            {
+                m_stackRequested = true;
+                m_interrupts.TryPush([this, task](Napi::Env env) {
+                    std::string stack = AppRuntime::CaptureStack(env);
+
+                    // Serviced late, after the long task already finished.
+                    std::scoped_lock taskLock{m_mutex};
+                    if (m_running && m_task == task)
+                    {
+                        m_stack = std::move(stack);
+                    }
+                });
+            }
+            else
+            {
+                m_terminationHandled = true;
+                m_terminated = m_interrupts.RequestTermination();
+            }
+        }
+    }
+}
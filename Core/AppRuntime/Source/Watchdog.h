@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AppRuntime.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Babylon
+{
+    // Times dispatched callbacks on behalf of Options::LongTaskThreshold and
+    // Options::ExecutionTimeLimit. A thread wakes when the running callback
+    // crosses either limit: at the threshold it asks the engine for a stack
+    // through the interrupt queue, and at the hard limit it asks the engine to
+    // terminate the script.
+    class AppRuntime::Watchdog final
+    {
+    public:
+        Watchdog(const Options& options, InterruptQueue& interrupts);
+        ~Watchdog();
+
+        Watchdog(const Watchdog&) = delete;
+        Watchdog& operator=(const Watchdog&) = delete;
+
+        // Bracket each dispatched callback; called on the JavaScript thread.
+        void TaskStarted();
+        void TaskFinished();
+
+    private:
+        void Watch();
+
+        const Options& m_options;
+        InterruptQueue& m_interrupts;
+        const bool m_enabled;
+
+        std::mutex m_mutex{};
+        std::condition_variable m_condition{};
+        bool m_stopped{};
+
+        // State of the running callback.
+        bool m_running{};
+        uint64_t m_task{};
+        std::chrono::steady_clock::time_point m_start{};
+        bool m_stackRequested{};
+        bool m_terminationHandled{};
+        bool m_terminated{};
+        std::string m_stack{};
+
+        std::thread m_thread{};
+    };
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "PerfTrace.h"
+#include <napi/env.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Babylon
+{
+    // Breaks down how long it takes an environment to start up. AppRuntime records
+    // engine and context creation, and the JsRuntime, polyfill and ScriptLoader
+    // phases that follow are recorded as they run, so a host can tell which one
+    // regressed. Each timed phase is also traced (see PerfTrace).
+    namespace StartupTrace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct Phase
+        {
+            // What ran, e.g. "Polyfills::Console::Initialize".
+            std::string Name;
+
+            // What it ran on, e.g. the url of a script. Usually empty.
+            std::string Detail;
+
+            Clock::time_point Start;
+            std::chrono::nanoseconds Duration;
+        };
+
+        // Only the first MaxPhases phases of an environment are kept, since
+        // ScriptLoader keeps reporting scripts loaded long after startup.
+        constexpr size_t MaxPhases{256};
+
+        // Times a phase from construction to destruction. Must stay on the
+        // JavaScript thread of `env`.
+        class Scope
+        {
+        public:
+            Scope(Napi::Env env, const char* name, std::string detail = {});
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Napi::Env m_env;
+            const char* m_name;
+            std::string m_detail;
+            Clock::time_point m_start;
+            PerfTrace::Handle m_trace;
+        };
+
+        // Records a phase that has already finished, e.g. one that ran on another
+        // thread before the environment could be reached. Safe to call from any thread.
+        void Record(Napi::Env env, std::string name, std::string detail, Clock::time_point start, Clock::time_point end);
+
+        // The phases recorded for `env` so far, ordered by start time. Safe to call
+        // from any thread while `env` is alive.
+        std::vector<Phase> GetReport(Napi::Env env);
+
+        // Drops everything recorded for `env`. Called when it is torn down.
+        void Clear(Napi::Env env);
+    }
+}
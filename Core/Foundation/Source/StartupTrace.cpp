@@ -0,0 +1,66 @@
+#include "StartupTrace.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    std::mutex g_mutex;
+    std::unordered_map<napi_env, std::vector<Babylon::StartupTrace::Phase>> g_phases;
+}
+
+namespace Babylon
+{
+    namespace StartupTrace
+    {
+        Scope::Scope(Napi::Env env, const char* name, std::string detail)
+            : m_env{env}
+            , m_name{name}
+            , m_detail{std::move(detail)}
+            , m_start{Clock::now()}
+            , m_trace{PerfTrace::Trace(name)}
+        {
+        }
+
+        Scope::~Scope()
+        {
+            Record(m_env, m_name, std::move(m_detail), m_start, Clock::now());
+        }
+
+        void Record(Napi::Env env, std::string name, std::string detail, Clock::time_point start, Clock::time_point end)
+        {
+            std::scoped_lock lock{g_mutex};
+            auto& phases = g_phases[env];
+            if (phases.size() < MaxPhases)
+            {
+                phases.push_back({std::move(name), std::move(detail), start, end - start});
+            }
+        }
+
+        std::vector<Phase> GetReport(Napi::Env env)
+        {
+            std::vector<Phase> phases{};
+            {
+                std::scoped_lock lock{g_mutex};
+                auto it = g_phases.find(env);
+                if (it != g_phases.end())
+                {
+                    phases = it->second;
+                }
+            }
+
+            // Phases are recorded as they finish, so enclosing phases come after
+            // the ones nested in them.
+            std::stable_sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) {
+                return a.Start < b.Start;
+            });
+            return phases;
+        }
+
+        void Clear(Napi::Env env)
+        {
+            std::scoped_lock lock{g_mutex};
+            g_phases.erase(env);
+        }
+    }
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <napi/napi.h>
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace Babylon
+{
+    // Return type of a fire-and-forget coroutine, for native code that hops
+    // between its own threads and the JavaScript thread with co_await (see
+    // JsRuntimeScheduler) and waits on promises without a chain of
+    // continuations: the whole operation lives in a single coroutine frame.
+    //
+    // The coroutine starts running right away, in the caller, and frees itself
+    // once it finishes, including when an exception escapes it. Such an
+    // exception is rethrown, after the frame is gone, from the Resumer that
+    // resumed it, i.e. in the dispatched callback (or promise reaction) it was
+    // resumed from, as a Napi::Error so that it reaches the runtime's
+    // UnhandledExceptionHandler; one thrown before its first suspension is
+    // dropped, as nothing has resumed the coroutine yet to rethrow it. When
+    // the work it waits on is dropped, e.g. because the runtime is shutting
+    // down, the coroutine is destroyed without resuming, like a dispatched
+    // callback.
+    class Coroutine final
+    {
+    public:
+        struct promise_type
+        {
+            Coroutine get_return_object() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                // Letting it escape from here would leave the frame alive at
+                // its final suspension point, so it is handed to the Resumer.
+                if (Escaped != nullptr)
+                {
+                    *Escaped = std::current_exception();
+                }
+            }
+
+            // Where the Resumer resuming the coroutine takes what escapes it.
+            std::exception_ptr* Escaped{};
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        // Resumes a suspended coroutine at most once, later calls doing
+        // nothing, and destroys it instead if dropped before that. Awaiters
+        // hand one to the work that completes the awaited operation.
+        class Resumer final
+        {
+        public:
+            explicit Resumer(Handle coroutine)
+                : m_coroutine{coroutine}
+            {
+            }
+
+            ~Resumer()
+            {
+                if (m_coroutine)
+                {
+                    m_coroutine.destroy();
+                }
+            }
+
+            Resumer(const Resumer&) = delete;
+            Resumer& operator=(const Resumer&) = delete;
+
+            void Resume()
+            {
+                if (!m_coroutine)
+                {
+                    return;
+                }
+
+                // Cleared before resuming, as the coroutine may be gone by the
+                // time resume returns.
+                const auto coroutine = std::exchange(m_coroutine, {});
+
+                std::exception_ptr escaped{};
+                coroutine.promise().Escaped = &escaped;
+                coroutine.resume();
+
+                if (escaped)
+                {
+                    std::rethrow_exception(escaped);
+                }
+            }
+
+            // Like Resume, on the JavaScript thread of `env`. Any other exception
+            // escaping the coroutine is rethrown as a Napi::Error, so that it
+            // reaches the runtime's unhandled exception handler rather than
+            // terminating the process.
+            void Resume(Napi::Env env)
+            {
+                try
+                {
+                    Resume();
+                }
+                catch (const Napi::Error&)
+                {
+                    throw;
+                }
+                catch (const std::exception& exception)
+                {
+                    throw Napi::Error::New(env, exception.what());
+                }
+                catch (...)
+                {
+                    throw Napi::Error::New(env, "Unknown exception escaped a coroutine");
+                }
+            }
+
+        private:
+            Handle m_coroutine;
+        };
+    };
+}
+
+namespace Napi
+{
+    // `co_await promise` in a Babylon::Coroutine on the JavaScript thread
+    // resumes it there once the promise settles, returning the value it was
+    // resolved with or throwing a Napi::Error with the reason it was rejected
+    // with. Like any Napi::Value, the result is only valid until the coroutine
+    // suspends again.
+    class PromiseAwaiter final
+    {
+    public:
+        explicit PromiseAwaiter(Napi::Promise promise)
+            : m_promise{promise}
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(Babylon::Coroutine::Handle coroutine)
+        {
+            const Napi::Env env = m_promise.Env();
+            auto resumer = std::make_shared<Babylon::Coroutine::Resumer>(coroutine);
+
+            const auto onFulfilled = Napi::Function::New(env, [this, resumer](const Napi::CallbackInfo& info) {
+                m_result = info[0];
+                resumer->Resume(info.Env());
+            });
+
+            const auto onRejected = Napi::Function::New(env, [this, resumer](const Napi::CallbackInfo& info) {
+                m_result = info[0];
+                m_rejected = true;
+                resumer->Resume(info.Env());
+            });
+
+            m_promise.Get("then").As<Napi::Function>().Call(m_promise, {onFulfilled, onRejected});
+        }
+
+        Napi::Value await_resume() const
+        {
+            if (m_rejected)
+            {
+                throw Napi::Error{m_promise.Env(), m_result};
+            }
+
+            return m_result;
+        }
+
+    private:
+        Napi::Promise m_promise;
+        Napi::Value m_result{};
+        bool m_rejected{};
+    };
+
+    inline PromiseAwaiter operator co_await(Napi::Promise promise)
+    {
+        return PromiseAwaiter{promise};
+    }
+}
@@ -1,16 +1,52 @@
 #pragma once
 
+#include "Coroutine.h"
 #include "JsRuntime.h"
 
+#include <optional>
+
 namespace Babylon
 {
     /**
      * Scheduler that invokes continuations via JsRuntime::Dispatch.
-     * Intended to be consumed by arcana.cpp tasks.
+     * Intended to be consumed by arcana.cpp tasks, or awaited from a
+     * Babylon::Coroutine: `Napi::Env env = co_await scheduler;` resumes
+     * the coroutine on the JavaScript thread.
      */
     class JsRuntimeScheduler
     {
     public:
+        class Awaiter
+        {
+        public:
+            explicit Awaiter(JsRuntime& runtime)
+                : m_runtime{runtime}
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(Coroutine::Handle coroutine)
+            {
+                m_runtime.Dispatch([this, resumer = std::make_shared<Coroutine::Resumer>(coroutine)](Napi::Env env) {
+                    m_env.emplace(env);
+                    resumer->Resume(env);
+                });
+            }
+
+            Napi::Env await_resume() const
+            {
+                return m_env.value();
+            }
+
+        private:
+            JsRuntime& m_runtime;
+            std::optional<Napi::Env> m_env{};
+        };
+
         explicit JsRuntimeScheduler(JsRuntime& runtime)
             : m_runtime{runtime}
         {
@@ -24,6 +60,11 @@ namespace Babylon
             });
         }
 
+        Awaiter operator co_await() const
+        {
+            return Awaiter{m_runtime};
+        }
+
     private:
         JsRuntime& m_runtime;
     };
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <napi/napi.h>
+#include <Babylon/Api.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace Babylon
+{
+    // Memory that several runtimes can use at once, each from its own thread.
+    // Every runtime gets its own view of it: a SharedArrayBuffer over the same
+    // bytes, so writes are seen everywhere without copying and Atomics.wait and
+    // Atomics.notify work across runtimes. On engines that can't expose host
+    // memory as a SharedArrayBuffer (JavaScriptCore, Chakra and Hermes) the
+    // views are ordinary ArrayBuffers over the memory, which share the bytes but
+    // can't be waited on. JSI can't expose host memory at all.
+    //
+    // The memory stays alive while the host holds a reference or any view is
+    // alive, and structuredClone passes views between runtimes as references to
+    // the same memory.
+    class SharedMemory final : public std::enable_shared_from_this<SharedMemory>
+    {
+    public:
+        // Allocates zeroed memory. `env` may be any runtime's; the memory isn't
+        // tied to it.
+        static std::shared_ptr<SharedMemory> BABYLON_API Create(Napi::Env env, size_t byteLength);
+
+        // The memory `value` is a view of, or null if it isn't a view created by
+        // CreateView.
+        static std::shared_ptr<SharedMemory> BABYLON_API GetFromJavaScript(Napi::Value value);
+
+        ~SharedMemory();
+
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+
+        // Creates a view of the memory in the runtime running in `env`. Must be
+        // called on its JavaScript thread.
+        Napi::Object BABYLON_API CreateView(Napi::Env env);
+
+        // Reads and writes from the host race with the runtimes unless they are
+        // synchronized, e.g. with std::atomic_ref or Atomics.
+        std::byte* Data() const
+        {
+            return m_data;
+        }
+
+        size_t ByteLength() const
+        {
+            return m_byteLength;
+        }
+
+    private:
+        SharedMemory(std::byte* data, size_t byteLength, size_t allocationLength);
+
+        std::byte* m_data;
+        size_t m_byteLength;
+        size_t m_allocationLength;
+    };
+}
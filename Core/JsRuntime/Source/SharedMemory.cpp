@@ -0,0 +1,108 @@
+#include "SharedMemory.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace Babylon
+{
+    namespace
+    {
+        // Live shared memory by address, to find the memory behind a view.
+        struct Registry
+        {
+            std::mutex Mutex{};
+            std::unordered_map<const std::byte*, std::weak_ptr<SharedMemory>> Memory{};
+        };
+
+        Registry& GetRegistry()
+        {
+            // Never deleted: memory may still be released while the process exits.
+            static Registry* registry{new Registry{}};
+            return *registry;
+        }
+    }
+
+    std::shared_ptr<SharedMemory> SharedMemory::Create(Napi::Env env, size_t byteLength)
+    {
+        // Always allocate something, so every memory has an address of its own.
+        const size_t allocationLength = std::max<size_t>(byteLength, 1);
+        auto* data = static_cast<std::byte*>(Napi::SharedArrayBuffer::AllocateMemory(env, allocationLength));
+
+        std::shared_ptr<SharedMemory> memory{new SharedMemory{data, byteLength, allocationLength}};
+
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{registry.Mutex};
+        registry.Memory[data] = memory;
+        return memory;
+    }
+
+    std::shared_ptr<SharedMemory> SharedMemory::GetFromJavaScript(Napi::Value value)
+    {
+        const std::byte* data{};
+        size_t byteLength{};
+        if (value.IsSharedArrayBuffer())
+        {
+            const auto buffer = value.As<Napi::SharedArrayBuffer>();
+            data = static_cast<const std::byte*>(buffer.Data());
+            byteLength = buffer.ByteLength();
+        }
+        else if (value.IsArrayBuffer())
+        {
+            const auto buffer = value.As<Napi::ArrayBuffer>();
+            data = static_cast<const std::byte*>(buffer.Data());
+            byteLength = buffer.ByteLength();
+        }
+
+        if (data == nullptr)
+        {
+            return {};
+        }
+
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{registry.Mutex};
+        const auto it = registry.Memory.find(data);
+        if (it == registry.Memory.end())
+        {
+            return {};
+        }
+
+        auto memory = it->second.lock();
+        if (memory == nullptr || memory->m_byteLength != byteLength)
+        {
+            return {};
+        }
+        return memory;
+    }
+
+    SharedMemory::SharedMemory(std::byte* data, size_t byteLength, size_t allocationLength)
+        : m_data{data}
+        , m_byteLength{byteLength}
+        , m_allocationLength{allocationLength}
+    {
+    }
+
+    SharedMemory::~SharedMemory()
+    {
+        {
+            // The memory is only freed below, so no other memory can have taken
+            // this address yet.
+            auto& registry = GetRegistry();
+            std::scoped_lock lock{registry.Mutex};
+            registry.Memory.erase(m_data);
+        }
+
+        Napi::SharedArrayBuffer::FreeMemory(m_data, m_allocationLength);
+    }
+
+    Napi::Object SharedMemory::CreateView(Napi::Env env)
+    {
+        // Each view keeps the memory alive. Its finalizer may run on another
+        // thread once the runtime is gone, so it only drops the reference.
+        auto reference = std::make_unique<std::shared_ptr<SharedMemory>>(shared_from_this());
+        auto view = Napi::SharedArrayBuffer::New(
+            env, m_data, m_byteLength, [](Napi::Env, void*, std::shared_ptr<SharedMemory>* reference) { delete reference; }, reference.get());
+        reference.release();
+        return view;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Babylon/Coroutine.h>
+#include <Babylon/JsRuntimeScheduler.h>
+
+#include <arcana/threading/task.h>
+
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace Babylon
+{
+    // Awaits an arcana task from a Coroutine, e.g.
+    // `const auto result = co_await TaskAwaiter{scheduler, request.SendAsync()};`.
+    // The coroutine resumes on the JavaScript thread once the task completes,
+    // with its result (or the exception it failed with) as an arcana::expected,
+    // through a single continuation rather than one per step. Exceptions
+    // escaping the coroutine after that are dropped, like those of a
+    // continuation.
+    template<typename ResultT>
+    class TaskAwaiter final
+    {
+    public:
+        using ExpectedT = arcana::expected<ResultT, std::exception_ptr>;
+
+        TaskAwaiter(JsRuntimeScheduler scheduler, arcana::task<ResultT, std::exception_ptr> task)
+            : m_scheduler{scheduler}
+            , m_task{std::move(task)}
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(Coroutine::Handle coroutine)
+        {
+            // arcana::task::then holds the scheduler by reference; it is a member
+            // of this awaiter, which lives in the suspended coroutine's frame.
+            m_task.then(m_scheduler, arcana::cancellation::none(), [this, resumer = std::make_shared<Coroutine::Resumer>(coroutine)](const ExpectedT& result) {
+                m_result.emplace(result);
+                resumer->Resume();
+            });
+        }
+
+        ExpectedT await_resume()
+        {
+            return std::move(m_result.value());
+        }
+
+    private:
+        JsRuntimeScheduler m_scheduler;
+        arcana::task<ResultT, std::exception_ptr> m_task;
+        std::optional<ExpectedT> m_result{};
+    };
+}
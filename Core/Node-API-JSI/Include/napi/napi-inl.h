@@ -13,7 +13,9 @@
 #include <stdexcept>
 #include <locale>
 #include <codecvt>
+#include <cstdlib>
 #include <cstring>
+#include <new>
 
 namespace Napi {
 
@@ -240,6 +242,19 @@ inline bool Value::IsArrayBuffer() const {
   return object.isArrayBuffer(_env->rt);
 }
 
+inline bool Value::IsSharedArrayBuffer() const {
+  if (!_value.isObject()) {
+      return false;
+  }
+
+  jsi::Value constructor{_env->rt.global().getProperty(_env->rt, "SharedArrayBuffer")};
+  if (!constructor.isObject() || !constructor.getObject(_env->rt).isFunction(_env->rt)) {
+      return false;
+  }
+
+  return _value.getObject(_env->rt).instanceOf(_env->rt, constructor.getObject(_env->rt).getFunction(_env->rt));
+}
+
 inline bool Value::IsTypedArray() const {
     if (!_value.isObject()) {
         return false;
@@ -463,6 +478,30 @@ inline std::u16string String::Utf16Value() const {
   throw std::runtime_error("TODO");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// StringView class
+////////////////////////////////////////////////////////////////////////////////
+
+inline StringView::StringView(const String& value)
+  : _value{value.Utf8Value()} {
+}
+
+inline StringView::operator std::string_view() const {
+  return _value;
+}
+
+inline std::string_view StringView::Value() const {
+  return _value;
+}
+
+inline const char* StringView::Data() const {
+  return _value.data();
+}
+
+inline size_t StringView::Size() const {
+  return _value.size();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Symbol class
 ////////////////////////////////////////////////////////////////////////////////
@@ -500,6 +539,104 @@ inline Symbol::Symbol(napi_env env, jsi::Value value)
   : Name(env, std::move(value)) {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// PropertyKey class
+////////////////////////////////////////////////////////////////////////////////
+
+inline PropertyKey PropertyKey::New(napi_env env, const char* utf8name) {
+  return New(env, std::string{utf8name});
+}
+
+inline PropertyKey PropertyKey::New(napi_env env, const std::string& utf8name) {
+  return {env, jsi::PropNameID::forUtf8(env->rt, utf8name), jsi::String::createFromUtf8(env->rt, utf8name)};
+}
+
+inline PropertyKey::PropertyKey()
+  : _env{nullptr} {
+}
+
+inline PropertyKey::PropertyKey(napi_env env, jsi::PropNameID id, jsi::String string)
+  : _env{env}, _name{std::make_shared<const Name>(Name{std::move(id), std::move(string)})} {
+}
+
+inline PropertyKey::operator const jsi::PropNameID&() const {
+  return _name->id;
+}
+
+inline PropertyKey::operator const jsi::String&() const {
+  return _name->string;
+}
+
+inline Napi::Env PropertyKey::Env() const {
+  return _env;
+}
+
+inline bool PropertyKey::IsEmpty() const {
+  return _name == nullptr;
+}
+
+inline String PropertyKey::Value() const {
+  return {_env, jsi::Value{_env->rt, _name->string}};
+}
+
+namespace details {
+  // Defines writable, enumerable and configurable data properties on `object`.
+  // JSI has no define-own-property call, so this goes through
+  // Object.defineProperty with one descriptor whose value changes between
+  // definitions.
+  inline void DefineOwnDataProperties(napi_env env, const jsi::Value& object, const PropertyKey* keys, const Value* values, size_t count) {
+    jsi::Runtime& rt = env->rt;
+    jsi::Object descriptor{rt};
+    descriptor.setProperty(rt, "writable", true);
+    descriptor.setProperty(rt, "enumerable", true);
+    descriptor.setProperty(rt, "configurable", true);
+
+    const auto valueName = jsi::PropNameID::forAscii(rt, "value");
+    for (size_t i = 0; i < count; ++i) {
+      descriptor.setProperty(rt, valueName, static_cast<const jsi::Value&>(values[i]));
+      env->define_property_func.call(rt, object, static_cast<const jsi::String&>(keys[i]), descriptor);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ObjectTemplate class
+////////////////////////////////////////////////////////////////////////////////
+
+inline ObjectTemplate ObjectTemplate::New(napi_env env, const std::initializer_list<PropertyKey>& keys) {
+  return {env, std::vector<PropertyKey>{keys}};
+}
+
+inline ObjectTemplate::ObjectTemplate()
+  : _env{nullptr} {
+}
+
+inline ObjectTemplate::ObjectTemplate(napi_env env, std::vector<PropertyKey> keys)
+  : _env{env}, _keys{std::move(keys)} {
+}
+
+inline Napi::Env ObjectTemplate::Env() const {
+  return _env;
+}
+
+inline bool ObjectTemplate::IsEmpty() const {
+  return _env == nullptr;
+}
+
+inline size_t ObjectTemplate::Size() const {
+  return _keys.size();
+}
+
+inline Object ObjectTemplate::NewInstance(const std::initializer_list<Value>& values) const {
+  if (values.size() != _keys.size()) {
+    throw std::invalid_argument("ObjectTemplate::NewInstance: expected one value per template key");
+  }
+
+  Object object = Object::New(_env);
+  details::DefineOwnDataProperties(_env, object, _keys.data(), values.begin(), _keys.size());
+  return object;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Automagic value creation
 ////////////////////////////////////////////////////////////////////////////////
@@ -696,6 +833,10 @@ inline bool Object::Has(const std::string& utf8name) const {
   return Has(utf8name.c_str());
 }
 
+inline bool Object::Has(const PropertyKey& key) const {
+  return _object->hasProperty(_env->rt, static_cast<const jsi::PropNameID&>(key));
+}
+
 inline bool Object::HasOwnProperty(const char* utf8name) const {
   (void)utf8name;
   throw std::runtime_error("TODO");
@@ -721,6 +862,10 @@ inline Value Object::Get(const std::string& utf8name) const {
   return Get(utf8name.c_str());
 }
 
+inline Value Object::Get(const PropertyKey& key) const {
+  return {_env, _object->getProperty(_env->rt, static_cast<const jsi::PropNameID&>(key))};
+}
+
 template <typename ValueType>
 inline void Object::Set(const Value& key, const ValueType& value) {
   _object->setProperty(_env->rt, ((const jsi::Value&)key).toString(_env->rt), static_cast<jsi::Value&&>(Value::From(_env, value)));
@@ -736,6 +881,28 @@ inline void Object::Set(const std::string& utf8name, const ValueType& value) {
   Set(utf8name.c_str(), value);
 }
 
+template <typename ValueType>
+inline void Object::Set(const PropertyKey& key, const ValueType& value) {
+  _object->setProperty(_env->rt, static_cast<const jsi::PropNameID&>(key), static_cast<jsi::Value&&>(Value::From(_env, value)));
+}
+
+inline void Object::SetMany(const std::initializer_list<PropertyKey>& keys, const std::initializer_list<Value>& values) {
+  if (keys.size() != values.size()) {
+    throw std::invalid_argument("Object::SetMany: keys and values must have the same length");
+  }
+
+  details::DefineOwnDataProperties(_env, *this, keys.begin(), values.begin(), keys.size());
+}
+
+inline std::vector<Value> Object::GetMany(const std::initializer_list<PropertyKey>& keys) const {
+  std::vector<Value> results;
+  results.reserve(keys.size());
+  for (const auto& key : keys) {
+    results.push_back(Get(key));
+  }
+  return results;
+}
+
 inline bool Object::Delete(const char* utf8name) {
   (void)utf8name;
   throw std::runtime_error("TODO");
@@ -954,6 +1121,37 @@ inline size_t ArrayBuffer::ByteLength() const {
   return _arrayBuffer->length(_env->rt);
 }
 
+inline ArrayBuffer::Contents::operator bool() const {
+  return false;
+}
+
+inline void* ArrayBuffer::Contents::Data() const {
+  return nullptr;
+}
+
+inline size_t ArrayBuffer::Contents::ByteLength() const {
+  return 0;
+}
+
+inline ArrayBuffer::Contents ArrayBuffer::TakeContents() {
+  return {};
+}
+
+inline ArrayBuffer ArrayBuffer::New(napi_env, Contents) {
+  throw std::runtime_error{"ArrayBuffer::New: jsi can't take the memory of an array buffer"};
+}
+
+// jsi has no way to detach an array buffer, so this goes through JavaScript.
+inline bool ArrayBuffer::TryDetach() {
+  const Napi::Value transfer = Get("transfer");
+  if (!transfer.IsFunction()) {
+    return false;
+  }
+
+  transfer.As<Napi::Function>().Call(*this, {Napi::Number::New(_env, 0)});
+  return true;
+}
+
 inline jsi::ArrayBuffer ArrayBuffer::FromExternal(napi_env env, void* externalData, size_t byteLength) {
   // must copy since jsi does not support array buffers with external data
   jsi::Value value{ env->array_buffer_ctor.callAsConstructor(env->rt, static_cast<int>(byteLength)) };
@@ -962,6 +1160,44 @@ inline jsi::ArrayBuffer ArrayBuffer::FromExternal(napi_env env, void* externalDa
   return arrayBuffer;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// SharedArrayBuffer class
+////////////////////////////////////////////////////////////////////////////////
+
+inline void* SharedArrayBuffer::AllocateMemory(napi_env, size_t byteLength) {
+  void* data{byteLength == 0 ? nullptr : std::calloc(1, byteLength)};
+  if (data == nullptr && byteLength != 0) {
+    throw std::bad_alloc{};
+  }
+  return data;
+}
+
+inline void SharedArrayBuffer::FreeMemory(void* data, size_t) {
+  std::free(data);
+}
+
+template <typename Finalizer, typename Hint>
+inline SharedArrayBuffer SharedArrayBuffer::New(napi_env, void*, size_t, Finalizer, Hint*) {
+  throw std::runtime_error{"SharedArrayBuffer::New: jsi does not support array buffers with external data"};
+}
+
+inline SharedArrayBuffer::SharedArrayBuffer() {
+}
+
+inline SharedArrayBuffer::SharedArrayBuffer(napi_env env, jsi::Value value)
+  : Object{env, std::move(value)} {
+}
+
+// jsi gives no access to the memory of shared array buffers, and none of them
+// can be over host memory.
+inline void* SharedArrayBuffer::Data() const {
+  return nullptr;
+}
+
+inline size_t SharedArrayBuffer::ByteLength() const {
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // DataView class
 ////////////////////////////////////////////////////////////////////////////////
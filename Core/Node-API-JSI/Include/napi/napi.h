@@ -5,6 +5,7 @@
 #include <initializer_list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 
@@ -61,7 +62,8 @@ struct napi_env__ {
         rt.global().getPropertyAsFunction(rt, "Float32Array"),
         rt.global().getPropertyAsFunction(rt, "Float64Array")}
     , boolean_func{rt.global().getPropertyAsFunction(rt, "Boolean")}
-    , number_func{rt.global().getPropertyAsFunction(rt, "Number")} {
+    , number_func{rt.global().getPropertyAsFunction(rt, "Number")}
+    , define_property_func{rt.global().getPropertyAsObject(rt, "Object").getPropertyAsFunction(rt, "defineProperty")} {
   }
 
   facebook::jsi::Runtime& rt;
@@ -72,6 +74,7 @@ struct napi_env__ {
   facebook::jsi::Function typed_array_ctor[9];
   facebook::jsi::Function boolean_func;
   facebook::jsi::Function number_func;
+  facebook::jsi::Function define_property_func;
 
   facebook::jsi::Value last_exception;
 };
@@ -229,6 +232,7 @@ namespace Napi {
     bool IsSymbol() const;      ///< Tests if a value is a JavaScript symbol.
     bool IsArray() const;       ///< Tests if a value is a JavaScript array.
     bool IsArrayBuffer() const; ///< Tests if a value is a JavaScript array buffer.
+    bool IsSharedArrayBuffer() const; ///< Tests if a value is a JavaScript shared array buffer.
     bool IsTypedArray() const;  ///< Tests if a value is a JavaScript typed array.
     bool IsObject() const;      ///< Tests if a value is a JavaScript object.
     bool IsFunction() const;    ///< Tests if a value is a JavaScript function.
@@ -360,6 +364,25 @@ namespace Napi {
     std::u16string Utf16Value() const; ///< Converts a String value to a UTF-16 encoded C++ string.
   };
 
+  /// A scoped, read-only view of a string's UTF-8 contents. JSI only hands out
+  /// copies, so the view owns one.
+  class StringView {
+  public:
+    explicit StringView(const String& value);
+
+    StringView(const StringView&) = delete;
+    StringView& operator=(const StringView&) = delete;
+
+    operator std::string_view() const;
+    std::string_view Value() const;
+
+    const char* Data() const;
+    size_t Size() const;
+
+  private:
+    std::string _value;
+  };
+
   /// A JavaScript symbol value.
   class Symbol : public Name {
   public:
@@ -395,6 +418,58 @@ namespace Napi {
     Symbol(napi_env env, jsi::Value value); ///< Wraps a N-API value primitive.
   };
 
+  /// An interned property name. Create once and reuse for repeated property access
+  /// to avoid re-creating the jsi::PropNameID (or the key string) on every call.
+  class PropertyKey {
+  public:
+    static PropertyKey New(napi_env env, const char* utf8name);
+    static PropertyKey New(napi_env env, const std::string& utf8name);
+
+    PropertyKey();
+
+    operator const jsi::PropNameID&() const;
+    operator const jsi::String&() const;
+
+    Napi::Env Env() const;
+    bool IsEmpty() const;
+
+    /// Gets the key name as a string value.
+    String Value() const;
+
+  private:
+    struct Name {
+      jsi::PropNameID id;
+      jsi::String string;
+    };
+
+    PropertyKey(napi_env env, jsi::PropNameID id, jsi::String string);
+
+    napi_env _env;
+    std::shared_ptr<const Name> _name;
+  };
+
+  /// A fixed, ordered list of property keys for creating many objects of the same shape.
+  /// JSI has no template API, so instances are built with one definition per key.
+  class ObjectTemplate {
+  public:
+    static ObjectTemplate New(napi_env env, const std::initializer_list<PropertyKey>& keys);
+
+    ObjectTemplate();
+
+    Napi::Env Env() const;
+    bool IsEmpty() const;
+    size_t Size() const;
+
+    /// Creates an object with every property defined, `values` matched to the template keys by position.
+    Object NewInstance(const std::initializer_list<Value>& values) const;
+
+  private:
+    ObjectTemplate(napi_env env, std::vector<PropertyKey> keys);
+
+    napi_env _env;
+    std::vector<PropertyKey> _keys;
+  };
+
   /// A JavaScript object value.
   class Object : public Value {
   public:
@@ -490,6 +565,11 @@ namespace Napi {
       const std::string& utf8name ///< UTF-8 encoded property name
     ) const;
 
+    /// Checks whether a property is present.
+    bool Has(
+      const PropertyKey& key ///< Interned property key
+    ) const;
+
     /// Checks whether a own property is present.
     bool HasOwnProperty(
       Value key ///< Property key
@@ -520,6 +600,11 @@ namespace Napi {
       const std::string& utf8name ///< UTF-8 encoded property name
     ) const;
 
+    /// Gets a property.
+    Value Get(
+      const PropertyKey& key ///< Interned property key
+    ) const;
+
     /// Sets a property.
     template <typename ValueType>
     void Set(
@@ -541,6 +626,25 @@ namespace Napi {
       const ValueType& value             ///< Property value primitive
     );
 
+    /// Sets a property.
+    template <typename ValueType>
+    void Set(
+      const PropertyKey& key, ///< Interned property key
+      const ValueType& value  ///< Property value
+    );
+
+    /// Defines several own enumerable, writable and configurable data properties.
+    /// JSI has no batched call, so this is a loop over Object.defineProperty.
+    void SetMany(
+      const std::initializer_list<PropertyKey>& keys, ///< Interned property keys
+      const std::initializer_list<Value>& values      ///< Property values, matched by position
+    );
+
+    /// Gets several properties.
+    std::vector<Value> GetMany(
+      const std::initializer_list<PropertyKey>& keys ///< Interned property keys
+    ) const;
+
     /// Delete property.
     bool Delete(
       Value key ///< Property key
@@ -712,12 +816,52 @@ namespace Napi {
     void* Data() const;        ///< Gets a pointer to the data buffer.
     size_t ByteLength() const; ///< Gets the length of the array buffer in bytes.
 
+    /// Memory taken over from an ArrayBuffer by `TakeContents`. jsi can't hand
+    /// the memory of a buffer over, so it is always empty.
+    class Contents {
+    public:
+      Contents() = default;
+
+      explicit operator bool() const; ///< Whether any memory was taken over.
+      void* Data() const;
+      size_t ByteLength() const;
+    };
+
+    /// Returns empty contents and leaves the buffer as it is.
+    Contents TakeContents();
+
+    /// Creates an ArrayBuffer over memory taken by `TakeContents`, which jsi
+    /// never hands out, so this always throws.
+    static ArrayBuffer New(napi_env env, Contents contents);
+
+    /// Detaches the buffer, freeing its memory. Returns false and leaves the
+    /// buffer as it is if the engine has no ArrayBuffer.prototype.transfer.
+    bool TryDetach();
+
   private:
     static jsi::ArrayBuffer FromExternal(napi_env env, void* externalData, size_t byteLength);
 
     std::optional<jsi::ArrayBuffer> _arrayBuffer;
   };
 
+  /// A JavaScript shared array buffer value over host memory. JSI can't expose
+  /// host memory without copying it, so New always throws; the memory functions
+  /// are kept so code sharing memory between runtimes still builds.
+  class SharedArrayBuffer : public Object {
+  public:
+    static void* AllocateMemory(napi_env env, size_t byteLength);
+    static void FreeMemory(void* data, size_t byteLength);
+
+    template <typename Finalizer, typename Hint>
+    static SharedArrayBuffer New(napi_env env, void* externalData, size_t byteLength, Finalizer finalizeCallback, Hint* finalizeHint);
+
+    SharedArrayBuffer();                               ///< Creates a new _empty_ SharedArrayBuffer instance.
+    SharedArrayBuffer(napi_env env, jsi::Value value); ///< Wraps a N-API value primitive.
+
+    void* Data() const;
+    size_t ByteLength() const;
+  };
+
   /// A JavaScript typed-array value with unknown array type.
   ///
   /// For type-specific operations, cast to a `TypedArrayOf<T>` instance using the `As()`
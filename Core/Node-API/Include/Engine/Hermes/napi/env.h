@@ -2,11 +2,18 @@
 
 #include <napi/napi.h>
 
+#include <functional>
+
 namespace Napi
 {
     // Create a Hermes runtime + napi_env owned by this process and expose it
     // through Napi::Env.  The runtime lives until the matching Detach() call.
-    Napi::Env Attach();
+    // Heap sizes are in bytes; zero keeps the defaults (1 MiB initial, and
+    // NAPI_HERMES_MAX_HEAP_SIZE_MB for the maximum).  `gcEventCallback` is
+    // called when each collection starts and ends, possibly from a GC
+    // thread; `young` tells young-generation collections from the others.
+    using GCEventCallback = std::function<void(bool start, bool young)>;
+    Napi::Env Attach(size_t initialHeapSize = 0, size_t maxHeapSize = 0, GCEventCallback gcEventCallback = {});
 
     // Tear down the runtime that backs `env`.  After this call, `env` is
     // invalid.  Hermes owns the env lifetime via its Runtime; destroying the
@@ -30,4 +37,9 @@ namespace Napi
     // top-level dispatch.  Equivalent engines (V8, Chakra) auto-drain
     // microtasks at scope exit; Hermes requires an explicit drainJobs().
     void DrainJobs(Napi::Env env);
+
+    // Run a full garbage collection on the runtime backing `env`.  Used by
+    // AppRuntime to respond to memory pressure; must be called on the JS
+    // thread.
+    void CollectGarbage(Napi::Env env);
 }
@@ -97,7 +97,10 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_create_string_utf16(napi_env env,
                                                             const char16_t* str,
                                                             size_t length,
                                                             napi_value* result);
-#ifdef NAPI_EXPERIMENTAL
+// [BABYLON-NATIVE-ADDITION]
+// Every backend implements external strings, so they are not gated on
+// NAPI_EXPERIMENTAL. Engines without an external string representation copy
+// the characters, call the finalizer right away and report `*copied = true`.
 #define NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS
 NAPI_EXTERN napi_status NAPI_CDECL
 node_api_create_external_string_latin1(napi_env env,
@@ -115,7 +118,6 @@ node_api_create_external_string_utf16(napi_env env,
                                       void* finalize_hint,
                                       napi_value* result,
                                       bool* copied);
-#endif  // NAPI_EXPERIMENTAL
 NAPI_EXTERN napi_status NAPI_CDECL napi_create_symbol(napi_env env,
                                                       napi_value description,
                                                       napi_value* result);
@@ -184,6 +186,25 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_get_value_string_utf16(napi_env env,
                                                                size_t bufsize,
                                                                size_t* result);
 
+// String views
+// [BABYLON-NATIVE-ADDITION]
+// Exposes the UTF-8 contents of a string without allocating where possible.
+// On success `*result` either points into engine-owned storage, or equals
+// `buf` when the string was copied there; `*length` is the byte count (the
+// view is not necessarily null-terminated). When the string does not fit in
+// `buf`, `*result` is NULL and `*length` is the required size in bytes
+// (excluding the terminator). Any non-NULL `*result` other than `buf` stays
+// valid until it is passed to napi_release_string_utf8_view.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_get_value_string_utf8_view(napi_env env,
+                                napi_value value,
+                                char* buf,
+                                size_t bufsize,
+                                const char** result,
+                                size_t* length);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_release_string_utf8_view(napi_env env, const char* data);
+
 // Methods to coerce values
 // These APIs may execute user scripts
 NAPI_EXTERN napi_status NAPI_CDECL napi_coerce_to_bool(napi_env env,
@@ -496,6 +517,94 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_run_script(napi_env env,
                                                    const char* source_url,
                                                    napi_value* result);
 
+// Interned property keys
+// [BABYLON-NATIVE-ADDITION]
+// A property key is created once per env for a given name and stays valid
+// until the env is detached. Keyed property access skips re-creating (and, on
+// engines that intern names, re-hashing) the property name on every call.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_create_property_key_utf8(napi_env env,
+                              const char* utf8name,
+                              size_t length,
+                              napi_property_key* result);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_get_property_key_value(napi_env env,
+                            napi_property_key key,
+                            napi_value* result);
+NAPI_EXTERN napi_status NAPI_CDECL napi_set_keyed_property(napi_env env,
+                                                           napi_value object,
+                                                           napi_property_key key,
+                                                           napi_value value);
+NAPI_EXTERN napi_status NAPI_CDECL napi_has_keyed_property(napi_env env,
+                                                           napi_value object,
+                                                           napi_property_key key,
+                                                           bool* result);
+NAPI_EXTERN napi_status NAPI_CDECL napi_get_keyed_property(napi_env env,
+                                                           napi_value object,
+                                                           napi_property_key key,
+                                                           napi_value* result);
+// Batched keyed access: one call for `count` properties. Values are defined as
+// own enumerable, writable, configurable data properties. On failure the
+// properties before the failing index have already been applied.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_define_own_properties_batch(napi_env env,
+                                 napi_value object,
+                                 size_t count,
+                                 const napi_property_key* keys,
+                                 const napi_value* values);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_get_properties_batch(napi_env env,
+                          napi_value object,
+                          size_t count,
+                          const napi_property_key* keys,
+                          napi_value* results);
+
+// Object templates
+// [BABYLON-NATIVE-ADDITION]
+// A template fixes an ordered list of property keys so objects of the same
+// shape can be created, fields filled in, with one call. Templates are interned
+// per env by their key list and live until the env is detached.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_create_object_template(napi_env env,
+                            size_t count,
+                            const napi_property_key* keys,
+                            napi_object_template* result);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_new_instance_from_template(napi_env env,
+                                napi_object_template object_template,
+                                const napi_value* values,
+                                napi_value* result);
+
+// Shared array buffers
+// [BABYLON-NATIVE-ADDITION]
+// Memory allocated with napi_allocate_shared_memory can be viewed from several
+// envs at once, each on its own thread, as SharedArrayBuffers over the same
+// bytes; Atomics.wait and Atomics.notify work between them. Any env can
+// allocate the memory, and it can be freed from any thread. The finalizer of a
+// view runs once its env no longer uses the memory, possibly on another thread
+// and after the env is gone, so it must not use `env`.
+// JavaScriptCore, Chakra and Hermes can't create SharedArrayBuffers through
+// their embedding API: there the views are external ArrayBuffers over the
+// memory, which still share its bytes but can't be used with Atomics.wait.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_allocate_shared_memory(napi_env env, size_t byte_length, void** data);
+NAPI_EXTERN napi_status NAPI_CDECL napi_free_shared_memory(void* data,
+                                                           size_t byte_length);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_create_external_sharedarraybuffer(napi_env env,
+                                       void* external_data,
+                                       size_t byte_length,
+                                       napi_finalize finalize_cb,
+                                       void* finalize_hint,
+                                       napi_value* result);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_is_sharedarraybuffer(napi_env env, napi_value value, bool* result);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_get_sharedarraybuffer_info(napi_env env,
+                                napi_value sharedarraybuffer,
+                                void** data,
+                                size_t* byte_length);
+
 // Memory management
 NAPI_EXTERN napi_status NAPI_CDECL napi_adjust_external_memory(
     napi_env env, int64_t change_in_bytes, int64_t* adjusted_value);
@@ -604,11 +713,40 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_get_instance_data(napi_env env,
                                                           void** data);
 #endif  // NAPI_VERSION >= 6
 
-#if NAPI_VERSION >= 7
 // ArrayBuffer detaching
+// [BABYLON-NATIVE-ADDITION]: napi_detach_arraybuffer is declared whatever the
+// NAPI_VERSION, so that buffers can be transferred between runtimes.
 NAPI_EXTERN napi_status NAPI_CDECL
 napi_detach_arraybuffer(napi_env env, napi_value arraybuffer);
 
+// [BABYLON-NATIVE-ADDITION]
+// Detaches `arraybuffer` like napi_detach_arraybuffer, but hands its memory to
+// the caller instead of freeing it. `*data` stays valid until `contents` is
+// passed to napi_release_arraybuffer_contents, which can be called from any
+// thread and after `env` is gone. Only V8 can do this; the other engines return
+// napi_generic_failure and leave the buffer untouched, so the memory has to be
+// copied before the buffer is detached. napi_detach_arraybuffer itself returns
+// napi_generic_failure on engines that can't detach buffers at all: Chakra, and
+// JavaScriptCore without ArrayBuffer.prototype.transfer.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_take_arraybuffer_contents(napi_env env,
+                               napi_value arraybuffer,
+                               void** data,
+                               size_t* byte_length,
+                               napi_arraybuffer_contents* contents);
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_release_arraybuffer_contents(napi_arraybuffer_contents contents);
+
+// [BABYLON-NATIVE-ADDITION]
+// Creates an ArrayBuffer over memory taken by napi_take_arraybuffer_contents,
+// possibly from another env, without copying it. Takes `contents` over on
+// success; on failure the caller still has to release them.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_create_arraybuffer_from_contents(napi_env env,
+                                      napi_arraybuffer_contents contents,
+                                      napi_value* result);
+
+#if NAPI_VERSION >= 7
 NAPI_EXTERN napi_status NAPI_CDECL
 napi_is_detached_arraybuffer(napi_env env, napi_value value, bool* result);
 #endif  // NAPI_VERSION >= 7
@@ -33,6 +33,12 @@ typedef struct napi_handle_scope__* napi_handle_scope;
 typedef struct napi_escapable_handle_scope__* napi_escapable_handle_scope;
 typedef struct napi_callback_info__* napi_callback_info;
 typedef struct napi_deferred__* napi_deferred;
+// [BABYLON-NATIVE-ADDITION]
+typedef struct napi_property_key__* napi_property_key;
+// [BABYLON-NATIVE-ADDITION]
+typedef struct napi_object_template__* napi_object_template;
+// [BABYLON-NATIVE-ADDITION]
+typedef struct napi_arraybuffer_contents__* napi_arraybuffer_contents;
 
 typedef enum {
   napi_default = 0,
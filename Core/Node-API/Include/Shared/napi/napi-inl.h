@@ -693,6 +693,18 @@ inline bool Value::IsArrayBuffer() const {
   return result;
 }
 
+// [BABYLON-NATIVE-ADDITION]
+inline bool Value::IsSharedArrayBuffer() const {
+  if (IsEmpty()) {
+    return false;
+  }
+
+  bool result;
+  napi_status status = napi_is_sharedarraybuffer(_env, _value, &result);
+  NAPI_THROW_IF_FAILED(_env, status, false);
+  return result;
+}
+
 inline bool Value::IsTypedArray() const {
   if (IsEmpty()) {
     return false;
@@ -1142,6 +1154,47 @@ inline std::u16string String::Utf16Value() const {
   return value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// StringView class
+////////////////////////////////////////////////////////////////////////////////
+
+inline StringView::StringView(const String& value)
+    : _env(value.Env()), _data(nullptr), _size(0) {
+  napi_status status = napi_get_value_string_utf8_view(
+      _env, value, _inline, InlineSize, &_data, &_size);
+  NAPI_THROW_IF_FAILED_VOID(_env, status);
+
+  if (_data == nullptr) {
+    _heap.reset(new char[_size + 1]);
+    status = napi_get_value_string_utf8(
+        _env, value, _heap.get(), _size + 1, &_size);
+    NAPI_THROW_IF_FAILED_VOID(_env, status);
+    _data = _heap.get();
+  }
+}
+
+inline StringView::~StringView() {
+  if (_data != nullptr && _data != _inline && _data != _heap.get()) {
+    napi_release_string_utf8_view(_env, _data);
+  }
+}
+
+inline StringView::operator std::string_view() const {
+  return Value();
+}
+
+inline std::string_view StringView::Value() const {
+  return {_data, _size};
+}
+
+inline const char* StringView::Data() const {
+  return _data;
+}
+
+inline size_t StringView::Size() const {
+  return _size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Symbol class
 ////////////////////////////////////////////////////////////////////////////////
@@ -1334,6 +1387,145 @@ String String::From(napi_env env, const T& value) {
   return Helper::From(env, value);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// PropertyKey class
+////////////////////////////////////////////////////////////////////////////////
+
+// [BABYLON-NATIVE-ADDITION]
+inline PropertyKey PropertyKey::New(napi_env env, const char* utf8name) {
+  napi_property_key key;
+  napi_status status =
+      napi_create_property_key_utf8(env, utf8name, NAPI_AUTO_LENGTH, &key);
+  NAPI_THROW_IF_FAILED(env, status, PropertyKey());
+  return PropertyKey(env, key);
+}
+
+inline PropertyKey PropertyKey::New(napi_env env,
+                                    const std::string& utf8name) {
+  napi_property_key key;
+  napi_status status = napi_create_property_key_utf8(
+      env, utf8name.c_str(), utf8name.size(), &key);
+  NAPI_THROW_IF_FAILED(env, status, PropertyKey());
+  return PropertyKey(env, key);
+}
+
+inline PropertyKey::PropertyKey() : _env(nullptr), _key(nullptr) {}
+
+inline PropertyKey::PropertyKey(napi_env env, napi_property_key key)
+    : _env(env), _key(key) {}
+
+inline PropertyKey::operator napi_property_key() const {
+  return _key;
+}
+
+inline Napi::Env PropertyKey::Env() const {
+  return Napi::Env(_env);
+}
+
+inline bool PropertyKey::IsEmpty() const {
+  return _key == nullptr;
+}
+
+inline String PropertyKey::Value() const {
+  napi_value result;
+  napi_status status = napi_get_property_key_value(_env, _key, &result);
+  NAPI_THROW_IF_FAILED(_env, status, String());
+  return String(_env, result);
+}
+
+// [BABYLON-NATIVE-ADDITION]
+namespace details {
+
+// The raw handles of a list of property keys for the batched calls, on the
+// stack unless there are many of them.
+class PropertyKeyArray {
+ public:
+  PropertyKeyArray(size_t count, const PropertyKey* keys) {
+    if (count > stackKeysCount) {
+      _heapKeys.resize(count);
+      _keys = _heapKeys.data();
+    }
+
+    for (size_t index = 0; index < count; index++) {
+      _keys[index] = keys[index];
+    }
+  }
+
+  PropertyKeyArray(const PropertyKeyArray&) = delete;
+  PropertyKeyArray& operator=(const PropertyKeyArray&) = delete;
+
+  const napi_property_key* Data() const { return _keys; }
+
+ private:
+  static constexpr size_t stackKeysCount = 16;
+  napi_property_key _stackKeys[stackKeysCount];
+  std::vector<napi_property_key> _heapKeys;
+  napi_property_key* _keys{_stackKeys};
+};
+
+}  // namespace details
+
+////////////////////////////////////////////////////////////////////////////////
+// ObjectTemplate class
+////////////////////////////////////////////////////////////////////////////////
+
+// [BABYLON-NATIVE-ADDITION]
+inline ObjectTemplate ObjectTemplate::New(
+    napi_env env, const std::initializer_list<PropertyKey>& keys) {
+  return New(env, keys.size(), keys.begin());
+}
+
+inline ObjectTemplate ObjectTemplate::New(napi_env env,
+                                          size_t count,
+                                          const PropertyKey* keys) {
+  details::PropertyKeyArray rawKeys{count, keys};
+  napi_object_template objectTemplate;
+  napi_status status = napi_create_object_template(
+      env, count, rawKeys.Data(), &objectTemplate);
+  NAPI_THROW_IF_FAILED(env, status, ObjectTemplate());
+  return ObjectTemplate(env, objectTemplate, count);
+}
+
+inline ObjectTemplate::ObjectTemplate()
+    : _env(nullptr), _template(nullptr), _size(0) {}
+
+inline ObjectTemplate::ObjectTemplate(napi_env env,
+                                      napi_object_template objectTemplate,
+                                      size_t size)
+    : _env(env), _template(objectTemplate), _size(size) {}
+
+inline ObjectTemplate::operator napi_object_template() const {
+  return _template;
+}
+
+inline Napi::Env ObjectTemplate::Env() const {
+  return Napi::Env(_env);
+}
+
+inline bool ObjectTemplate::IsEmpty() const {
+  return _template == nullptr;
+}
+
+inline size_t ObjectTemplate::Size() const {
+  return _size;
+}
+
+inline MaybeOrValue<Object> ObjectTemplate::NewInstance(
+    const std::initializer_list<napi_value>& values) const {
+  NAPI_CHECK(values.size() == _size,
+             "ObjectTemplate::NewInstance",
+             "expected one value per template key");
+  return NewInstance(values.begin());
+}
+
+inline MaybeOrValue<Object> ObjectTemplate::NewInstance(
+    const napi_value* values) const {
+  napi_value result;
+  napi_status status =
+      napi_new_instance_from_template(_env, _template, values, &result);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, Object(_env, result), Object);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // TypeTaggable class
 ////////////////////////////////////////////////////////////////////////////////
@@ -1467,6 +1659,13 @@ inline MaybeOrValue<bool> Object::Has(const std::string& utf8name) const {
   return Has(utf8name.c_str());
 }
 
+// [BABYLON-NATIVE-ADDITION]
+inline MaybeOrValue<bool> Object::Has(const PropertyKey& key) const {
+  bool result;
+  napi_status status = napi_has_keyed_property(_env, _value, key, &result);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, result, bool);
+}
+
 inline MaybeOrValue<bool> Object::HasOwnProperty(napi_value key) const {
   bool result;
   napi_status status = napi_has_own_property(_env, _value, key, &result);
@@ -1514,6 +1713,13 @@ inline MaybeOrValue<Value> Object::Get(const std::string& utf8name) const {
   return Get(utf8name.c_str());
 }
 
+// [BABYLON-NATIVE-ADDITION]
+inline MaybeOrValue<Value> Object::Get(const PropertyKey& key) const {
+  napi_value result;
+  napi_status status = napi_get_keyed_property(_env, _value, key, &result);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, Value(_env, result), Value);
+}
+
 template <typename ValueType>
 inline MaybeOrValue<bool> Object::Set(napi_value key,
                                       const ValueType& value) const {
@@ -1543,6 +1749,63 @@ inline MaybeOrValue<bool> Object::Set(const std::string& utf8name,
   return Set(utf8name.c_str(), value);
 }
 
+// [BABYLON-NATIVE-ADDITION]
+template <typename ValueType>
+inline MaybeOrValue<bool> Object::Set(const PropertyKey& key,
+                                      const ValueType& value) const {
+  napi_status status =
+      napi_set_keyed_property(_env, _value, key, Value::From(_env, value));
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, status == napi_ok, bool);
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline MaybeOrValue<bool> Object::SetMany(size_t count,
+                                          const PropertyKey* keys,
+                                          const napi_value* values) const {
+  details::PropertyKeyArray rawKeys{count, keys};
+  napi_status status = napi_define_own_properties_batch(
+      _env, _value, count, rawKeys.Data(), values);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, status == napi_ok, bool);
+}
+
+inline MaybeOrValue<bool> Object::SetMany(
+    const std::initializer_list<PropertyKey>& keys,
+    const std::initializer_list<napi_value>& values) const {
+  NAPI_CHECK(keys.size() == values.size(),
+             "Object::SetMany",
+             "keys and values must have the same length");
+  return SetMany(keys.size(), keys.begin(), values.begin());
+}
+
+inline MaybeOrValue<bool> Object::GetMany(size_t count,
+                                          const PropertyKey* keys,
+                                          napi_value* results) const {
+  details::PropertyKeyArray rawKeys{count, keys};
+  napi_status status =
+      napi_get_properties_batch(_env, _value, count, rawKeys.Data(), results);
+  NAPI_RETURN_OR_THROW_IF_FAILED(_env, status, status == napi_ok, bool);
+}
+
+inline MaybeOrValue<std::vector<Value>> Object::GetMany(
+    const std::initializer_list<PropertyKey>& keys) const {
+  std::vector<napi_value> rawResults(keys.size());
+  details::PropertyKeyArray rawKeys{keys.size(), keys.begin()};
+  napi_status status = napi_get_properties_batch(
+      _env, _value, keys.size(), rawKeys.Data(), rawResults.data());
+  NAPI_MAYBE_THROW_IF_FAILED(_env, status, std::vector<Value>);
+
+  std::vector<Value> results;
+  results.reserve(rawResults.size());
+  for (napi_value result : rawResults) {
+    results.emplace_back(_env, result);
+  }
+#ifdef NODE_ADDON_API_ENABLE_MAYBE
+  return Napi::Just<std::vector<Value>>(std::move(results));
+#else
+  return results;
+#endif
+}
+
 inline MaybeOrValue<bool> Object::Delete(napi_value key) const {
   bool result;
   napi_status status = napi_delete_property(_env, _value, key, &result);
@@ -2009,6 +2272,177 @@ inline void ArrayBuffer::Detach() {
 }
 #endif  // NAPI_VERSION >= 7
 
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer::Contents::Contents()
+    : _contents(nullptr), _data(nullptr), _byteLength(0) {}
+
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer::Contents::Contents(napi_arraybuffer_contents contents,
+                                       void* data,
+                                       size_t byteLength)
+    : _contents(contents), _data(data), _byteLength(byteLength) {}
+
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer::Contents::~Contents() {
+  if (_contents != nullptr) {
+    napi_release_arraybuffer_contents(_contents);
+  }
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer::Contents::Contents(Contents&& other)
+    : _contents(std::exchange(other._contents, nullptr)),
+      _data(std::exchange(other._data, nullptr)),
+      _byteLength(std::exchange(other._byteLength, 0)) {}
+
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer::Contents& ArrayBuffer::Contents::operator=(
+    Contents&& other) {
+  if (this != &other) {
+    if (_contents != nullptr) {
+      napi_release_arraybuffer_contents(_contents);
+    }
+    _contents = std::exchange(other._contents, nullptr);
+    _data = std::exchange(other._data, nullptr);
+    _byteLength = std::exchange(other._byteLength, 0);
+  }
+  return *this;
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer::Contents::operator bool() const {
+  return _contents != nullptr;
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline void* ArrayBuffer::Contents::Data() const {
+  return _data;
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline size_t ArrayBuffer::Contents::ByteLength() const {
+  return _byteLength;
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer::Contents ArrayBuffer::TakeContents() {
+  void* data;
+  size_t byteLength;
+  napi_arraybuffer_contents contents;
+  napi_status status = napi_take_arraybuffer_contents(
+      _env, _value, &data, &byteLength, &contents);
+  if (status == napi_generic_failure) {
+    return Contents();
+  }
+  NAPI_THROW_IF_FAILED(_env, status, Contents());
+
+  // The cached info is stale once the buffer is detached.
+  _data = nullptr;
+  _length = 0;
+  return Contents(contents, data, byteLength);
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline ArrayBuffer ArrayBuffer::New(napi_env env, Contents contents) {
+  napi_value value;
+  napi_status status =
+      napi_create_arraybuffer_from_contents(env, contents._contents, &value);
+  NAPI_THROW_IF_FAILED(env, status, ArrayBuffer());
+
+  contents._contents = nullptr;
+  return ArrayBuffer(env, value, contents._data, contents._byteLength);
+}
+
+// [BABYLON-NATIVE-ADDITION]
+inline bool ArrayBuffer::TryDetach() {
+  napi_status status = napi_detach_arraybuffer(_env, _value);
+  if (status == napi_generic_failure) {
+    return false;
+  }
+  NAPI_THROW_IF_FAILED(_env, status, false);
+
+  _data = nullptr;
+  _length = 0;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SharedArrayBuffer class
+// [BABYLON-NATIVE-ADDITION]
+////////////////////////////////////////////////////////////////////////////////
+
+inline void* SharedArrayBuffer::AllocateMemory(napi_env env, size_t byteLength) {
+  void* data;
+  napi_status status = napi_allocate_shared_memory(env, byteLength, &data);
+  NAPI_THROW_IF_FAILED(env, status, nullptr);
+  return data;
+}
+
+inline void SharedArrayBuffer::FreeMemory(void* data, size_t byteLength) {
+  napi_free_shared_memory(data, byteLength);
+}
+
+template <typename Finalizer, typename Hint>
+inline SharedArrayBuffer SharedArrayBuffer::New(napi_env env,
+                                                void* externalData,
+                                                size_t byteLength,
+                                                Finalizer finalizeCallback,
+                                                Hint* finalizeHint) {
+  napi_value value;
+  details::FinalizeData<void, Finalizer, Hint>* finalizeData =
+      new details::FinalizeData<void, Finalizer, Hint>(
+          {std::move(finalizeCallback), finalizeHint});
+  napi_status status = napi_create_external_sharedarraybuffer(
+      env,
+      externalData,
+      byteLength,
+      details::FinalizeData<void, Finalizer, Hint>::WrapperWithHint,
+      finalizeData,
+      &value);
+  if (status != napi_ok) {
+    delete finalizeData;
+    NAPI_THROW_IF_FAILED(env, status, SharedArrayBuffer());
+  }
+
+  return SharedArrayBuffer(env, value);
+}
+
+inline void SharedArrayBuffer::CheckCast(napi_env env, napi_value value) {
+  NAPI_CHECK(value != nullptr, "SharedArrayBuffer::CheckCast", "empty value");
+
+  void* data;
+  size_t length;
+  napi_status status =
+      napi_get_sharedarraybuffer_info(env, value, &data, &length);
+  NAPI_CHECK(status == napi_ok,
+             "SharedArrayBuffer::CheckCast",
+             "value is not sharedarraybuffer");
+}
+
+inline SharedArrayBuffer::SharedArrayBuffer()
+    : Object(), _data(nullptr), _length(0) {}
+
+inline SharedArrayBuffer::SharedArrayBuffer(napi_env env, napi_value value)
+    : Object(env, value), _data(nullptr), _length(0) {}
+
+inline void* SharedArrayBuffer::Data() const {
+  EnsureInfo();
+  return _data;
+}
+
+inline size_t SharedArrayBuffer::ByteLength() const {
+  EnsureInfo();
+  return _length;
+}
+
+inline void SharedArrayBuffer::EnsureInfo() const {
+  if (_data == nullptr) {
+    napi_status status =
+        napi_get_sharedarraybuffer_info(_env, _value, &_data, &_length);
+    NAPI_THROW_IF_FAILED_VOID(_env, status);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // DataView class
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 #include <mutex>
 #endif  // NAPI_HAS_THREADS
 #include <string>
+#include <string_view>
 #include <vector>
 
 // VS2015 RTM has bugs with constexpr, so require min of VS2015 Update 3 (known
@@ -199,8 +200,11 @@ class Date;
 #endif
 class String;
 class Object;
+class PropertyKey;
+class ObjectTemplate;
 class Array;
 class ArrayBuffer;
+class SharedArrayBuffer;
 class Function;
 class Error;
 class PropertyDescriptor;
@@ -475,6 +479,9 @@ class Value {
   bool IsArray() const;   ///< Tests if a value is a JavaScript array.
   bool IsArrayBuffer()
       const;  ///< Tests if a value is a JavaScript array buffer.
+  // [BABYLON-NATIVE-ADDITION]
+  bool IsSharedArrayBuffer()
+      const;  ///< Tests if a value is a JavaScript shared array buffer.
   bool IsTypedArray() const;  ///< Tests if a value is a JavaScript typed array.
   bool IsObject() const;      ///< Tests if a value is a JavaScript object.
   bool IsFunction() const;    ///< Tests if a value is a JavaScript function.
@@ -705,6 +712,35 @@ class String : public Name {
       const;  ///< Converts a String value to a UTF-16 encoded C++ string.
 };
 
+// [BABYLON-NATIVE-ADDITION]
+/// A scoped, read-only view of a string's UTF-8 contents. Where the engine can
+/// expose its own storage the view points into it; otherwise short strings are
+/// copied into an inline buffer and only long ones allocate. The view is valid
+/// for the lifetime of this object and of the string value it was made from.
+class StringView {
+ public:
+  explicit StringView(const String& value);
+  ~StringView();
+
+  StringView(const StringView&) = delete;
+  StringView& operator=(const StringView&) = delete;
+
+  operator std::string_view() const;
+  std::string_view Value() const;
+
+  const char* Data() const;
+  size_t Size() const;
+
+ private:
+  static constexpr size_t InlineSize = 128;
+
+  napi_env _env;
+  const char* _data;
+  size_t _size;
+  std::unique_ptr<char[]> _heap;
+  char _inline[InlineSize];
+};
+
 /// A JavaScript symbol value.
 class Symbol : public Name {
  public:
@@ -756,6 +792,84 @@ class Symbol : public Name {
          napi_value value);  ///< Wraps a Node-API value primitive.
 };
 
+// [BABYLON-NATIVE-ADDITION]
+/// An interned property name. Keys are owned by the environment and stay valid
+/// until it is detached, so a key can be created once (e.g. when a polyfill is
+/// initialized) and reused for every property access that follows.
+class PropertyKey {
+ public:
+  /// Gets the key for a name, creating it on first use.
+  static PropertyKey New(
+      napi_env env,         ///< Node-API environment
+      const char* utf8name  ///< UTF-8 encoded null-terminated property name
+  );
+
+  /// Gets the key for a name, creating it on first use.
+  static PropertyKey New(
+      napi_env env,                ///< Node-API environment
+      const std::string& utf8name  ///< UTF-8 encoded property name
+  );
+
+  PropertyKey();  ///< Creates a new _empty_ PropertyKey instance.
+  PropertyKey(napi_env env, napi_property_key key);
+
+  operator napi_property_key() const;
+
+  Napi::Env Env() const;
+  bool IsEmpty() const;
+
+  /// Gets the key name as a string value.
+  String Value() const;
+
+ private:
+  napi_env _env;
+  napi_property_key _key;
+};
+
+// [BABYLON-NATIVE-ADDITION]
+/// A fixed, ordered list of property keys for creating many objects of the same
+/// shape. Templates are owned by the environment (and shared between callers
+/// passing the same keys), so one can be created at initialization time and
+/// kept for as long as the environment lives.
+class ObjectTemplate {
+ public:
+  /// Gets the template for a key list, creating it on first use.
+  static ObjectTemplate New(
+      napi_env env,                                  ///< Node-API environment
+      const std::initializer_list<PropertyKey>& keys  ///< Keys, in order
+  );
+
+  /// Gets the template for a key list, creating it on first use.
+  static ObjectTemplate New(napi_env env,  ///< Node-API environment
+                            size_t count,  ///< Number of keys
+                            const PropertyKey* keys  ///< Keys, in order
+  );
+
+  ObjectTemplate();  ///< Creates a new _empty_ ObjectTemplate instance.
+  ObjectTemplate(napi_env env, napi_object_template objectTemplate, size_t size);
+
+  operator napi_object_template() const;
+
+  Napi::Env Env() const;
+  bool IsEmpty() const;
+
+  /// Number of properties each instance is created with.
+  size_t Size() const;
+
+  /// Creates an object with every property set, `values` matched to the
+  /// template keys by position. `values` must hold exactly Size() values.
+  MaybeOrValue<Object> NewInstance(
+      const std::initializer_list<napi_value>& values) const;
+
+  /// Creates an object with every property set from Size() `values`.
+  MaybeOrValue<Object> NewInstance(const napi_value* values) const;
+
+ private:
+  napi_env _env;
+  napi_object_template _template;
+  size_t _size;
+};
+
 class TypeTaggable : public Value {
  public:
 #if NAPI_VERSION >= 8
@@ -866,6 +980,11 @@ class Object : public TypeTaggable {
       const std::string& utf8name  ///< UTF-8 encoded property name
   ) const;
 
+  // [BABYLON-NATIVE-ADDITION]
+  /// Checks whether a property is present.
+  MaybeOrValue<bool> Has(const PropertyKey& key  ///< Interned property key
+  ) const;
+
   /// Checks whether a own property is present.
   MaybeOrValue<bool> HasOwnProperty(napi_value key  ///< Property key primitive
   ) const;
@@ -902,6 +1021,11 @@ class Object : public TypeTaggable {
       const std::string& utf8name  ///< UTF-8 encoded property name
   ) const;
 
+  // [BABYLON-NATIVE-ADDITION]
+  /// Gets a property.
+  MaybeOrValue<Value> Get(const PropertyKey& key  ///< Interned property key
+  ) const;
+
   /// Sets a property.
   template <typename ValueType>
   MaybeOrValue<bool> Set(napi_value key,         ///< Property key primitive
@@ -927,6 +1051,38 @@ class Object : public TypeTaggable {
       const ValueType& value        ///< Property value primitive
   ) const;
 
+  // [BABYLON-NATIVE-ADDITION]
+  /// Sets a property.
+  template <typename ValueType>
+  MaybeOrValue<bool> Set(const PropertyKey& key,  ///< Interned property key
+                         const ValueType& value   ///< Property value
+  ) const;
+
+  // [BABYLON-NATIVE-ADDITION]
+  /// Defines several own data properties in one call. `keys` and `values` are
+  /// matched by position.
+  MaybeOrValue<bool> SetMany(size_t count,
+                             const PropertyKey* keys,
+                             const napi_value* values) const;
+
+  // [BABYLON-NATIVE-ADDITION]
+  /// Defines several own data properties in one call. `keys` and `values` must
+  /// have the same length.
+  MaybeOrValue<bool> SetMany(
+      const std::initializer_list<PropertyKey>& keys,
+      const std::initializer_list<napi_value>& values) const;
+
+  // [BABYLON-NATIVE-ADDITION]
+  /// Gets several properties in one call, writing `count` values to `results`.
+  MaybeOrValue<bool> GetMany(size_t count,
+                             const PropertyKey* keys,
+                             napi_value* results) const;
+
+  // [BABYLON-NATIVE-ADDITION]
+  /// Gets several properties in one call.
+  MaybeOrValue<std::vector<Value>> GetMany(
+      const std::initializer_list<PropertyKey>& keys) const;
+
   /// Delete property.
   MaybeOrValue<bool> Delete(napi_value key  ///< Property key primitive
   ) const;
@@ -1200,6 +1356,49 @@ class ArrayBuffer : public Object {
   void* Data() const;         ///< Gets a pointer to the data buffer.
   size_t ByteLength() const;  ///< Gets the length of the array buffer in bytes.
 
+  // [BABYLON-NATIVE-ADDITION]
+  /// Memory taken over from an ArrayBuffer by `TakeContents`. Released when
+  /// destroyed, which can happen on any thread and after the env is gone.
+  class Contents {
+   public:
+    Contents();
+    Contents(napi_arraybuffer_contents contents, void* data, size_t byteLength);
+    ~Contents();
+
+    Contents(Contents&& other);
+    Contents& operator=(Contents&& other);
+    Contents(const Contents&) = delete;
+    Contents& operator=(const Contents&) = delete;
+
+    explicit operator bool() const;  ///< Whether any memory was taken over.
+    void* Data() const;
+    size_t ByteLength() const;
+
+   private:
+    friend class ArrayBuffer;
+
+    napi_arraybuffer_contents _contents;
+    void* _data;
+    size_t _byteLength;
+  };
+
+  // [BABYLON-NATIVE-ADDITION]
+  /// Detaches the buffer and takes over its memory, see
+  /// `napi_take_arraybuffer_contents`. Returns empty contents and leaves the
+  /// buffer as it is on engines that can't hand the memory over.
+  Contents TakeContents();
+
+  // [BABYLON-NATIVE-ADDITION]
+  /// Creates an ArrayBuffer over memory taken by `TakeContents`, possibly in
+  /// another env, without copying it. See
+  /// `napi_create_arraybuffer_from_contents`.
+  static ArrayBuffer New(napi_env env, Contents contents);
+
+  // [BABYLON-NATIVE-ADDITION]
+  /// Detaches the buffer, freeing its memory. Returns false and leaves the
+  /// buffer as it is on engines that can't detach buffers.
+  bool TryDetach();
+
  private:
   mutable void* _data;
   mutable size_t _length;
@@ -1213,6 +1412,52 @@ class ArrayBuffer : public Object {
 #endif  // NAPI_VERSION >= 7
 };
 
+// [BABYLON-NATIVE-ADDITION]
+/// A JavaScript shared array buffer value over memory allocated with
+/// `AllocateMemory`. Views over the same memory can be created in several envs.
+/// Engines that can't create shared array buffers over host memory give an
+/// ordinary array buffer over it instead, see
+/// `napi_create_external_sharedarraybuffer`.
+class SharedArrayBuffer : public Object {
+ public:
+  /// Allocates zeroed memory that can back shared array buffers in any env.
+  static void* AllocateMemory(napi_env env, size_t byteLength);
+  /// Frees memory allocated with `AllocateMemory`. Can be called from any
+  /// thread.
+  static void FreeMemory(void* data, size_t byteLength);
+
+  /// Creates a new SharedArrayBuffer instance over memory allocated with
+  /// `AllocateMemory`. The finalizer can run on any thread and after the env
+  /// is gone, so it must not use the env.
+  template <typename Finalizer, typename Hint>
+  static SharedArrayBuffer New(
+      napi_env env,        ///< Node-API environment
+      void* externalData,  ///< Pointer to the shared memory
+      size_t byteLength,   ///< Length of the shared memory, in bytes
+      Finalizer finalizeCallback,  ///< Function to be called when the buffer
+                                   ///< no longer uses the memory; must
+                                   ///  implement `void operator()(Env env,
+                                   ///  void* externalData, Hint* hint)`
+      Hint* finalizeHint  ///< Hint (second parameter) to be passed to the
+                          ///< finalize callback
+  );
+
+  static void CheckCast(napi_env env, napi_value value);
+
+  SharedArrayBuffer();  ///< Creates a new _empty_ SharedArrayBuffer instance.
+  SharedArrayBuffer(napi_env env,
+                    napi_value value);  ///< Wraps a Node-API value primitive.
+
+  void* Data() const;         ///< Gets a pointer to the shared memory.
+  size_t ByteLength() const;  ///< Gets the length of the buffer in bytes.
+
+ private:
+  mutable void* _data;
+  mutable size_t _length;
+
+  void EnsureInfo() const;
+};
+
 /// A JavaScript typed-array value with unknown array type.
 ///
 /// For type-specific operations, cast to a `TypedArrayOf<T>` instance using the
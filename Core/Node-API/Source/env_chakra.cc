@@ -44,6 +44,10 @@ namespace Napi
     void Detach(Env env)
     {
         napi_env env_ptr{env};
+        for (auto& [name, key] : env_ptr->property_keys)
+        {
+            JsRelease(key->property_id, nullptr);
+        }
         delete env_ptr;
     }
 }
@@ -11,7 +11,10 @@
 //       takes a `source_url` for stack traces, matching what callers expect
 //       from the other engines' `Napi::Eval`).
 //   4.  Expose `Napi::DrainJobs` so AppRuntime can pump microtasks after each
-//       dispatched callback.
+//       dispatched callback, and `Napi::CollectGarbage` for memory pressure.
+//   5.  Supply the Babylon-only C API additions that hermesNapi doesn't
+//       implement (interned property keys, object templates, string views),
+//       layered on the standard calls.
 //
 // Header layering note:
 // Both our shared NAPI headers and Hermes's vendored ones use the same
@@ -51,12 +54,15 @@ typedef napi_finalize node_api_basic_finalize;
 #include "hermes/Public/RuntimeConfig.h"
 #include "hermes/VM/Runtime.h"
 
+#include <cstdlib>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Maximum GC heap size (in MiB) for the Hermes Runtime created by
 // `Napi::Attach`.  Overridable at CMake configure time via
@@ -66,11 +72,26 @@ typedef napi_finalize node_api_basic_finalize;
 #define NAPI_HERMES_MAX_HEAP_SIZE_MB 512
 #endif
 
+// Hermes has no handle to hold a pre-built name, so a key is just the interned
+// UTF-8 name and keyed access forwards to the named-property calls.
+struct napi_property_key__
+{
+    std::string name;
+};
+
+// Likewise a template is only the ordered key list.
+struct napi_object_template__
+{
+    std::vector<napi_property_key> keys;
+};
+
 namespace
 {
     struct HermesEnvState
     {
         std::shared_ptr<hermes::vm::Runtime> runtime;
+        std::unordered_map<std::string, std::unique_ptr<napi_property_key__>> propertyKeys;
+        std::map<std::vector<napi_property_key>, std::unique_ptr<napi_object_template__>> objectTemplates;
     };
 
     std::mutex& StateMutex()
@@ -99,18 +120,40 @@ namespace
 
 namespace Napi
 {
-    Napi::Env Attach()
+    Napi::Env Attach(size_t initialHeapSize, size_t maxHeapSize, GCEventCallback gcEventCallback)
     {
         // Default Hermes config is fine for embedding: MicrotaskQueue is on,
         // ES6 Proxy + generators are on, Intl is on, EnableEval is on.
         // We bump the max GC heap to something reasonable for running our
         // Mocha test suite (the unit-test default of 512 KiB is too small).
-        // The ceiling is configurable via NAPI_HERMES_MAX_HEAP_SIZE_MB
-        // (defaults to 512 MiB).
+        // The ceiling is configurable per runtime through `maxHeapSize`, or
+        // for the whole build via NAPI_HERMES_MAX_HEAP_SIZE_MB (defaults to
+        // 512 MiB).
+        if (initialHeapSize == 0)
+        {
+            initialHeapSize = 1u << 20;        //   1 MiB
+        }
+        if (maxHeapSize == 0)
+        {
+            maxHeapSize = static_cast<size_t>(NAPI_HERMES_MAX_HEAP_SIZE_MB) << 20;
+        }
+
+        // Hermes names each collection in `extraInfo`; young-generation ones
+        // mention it ("young" or "Young" depending on the GC).
+        std::function<void(hermes::vm::GCEventKind, const char*)> gcCallback;
+        if (gcEventCallback)
+        {
+            gcCallback = [gcEventCallback = std::move(gcEventCallback)](hermes::vm::GCEventKind kind, const char* extraInfo) {
+                const bool young = extraInfo != nullptr && (std::strstr(extraInfo, "young") != nullptr || std::strstr(extraInfo, "Young") != nullptr);
+                gcEventCallback(kind == hermes::vm::GCEventKind::CollectionStart, young);
+            };
+        }
+
         auto config = hermes::vm::RuntimeConfig::Builder()
                           .withGCConfig(hermes::vm::GCConfig::Builder()
-                                            .withInitHeapSize(1u << 20)        //   1 MiB
-                                            .withMaxHeapSize(static_cast<unsigned>(NAPI_HERMES_MAX_HEAP_SIZE_MB) << 20)
+                                            .withInitHeapSize(static_cast<hermes::vm::gcheapsize_t>(initialHeapSize))
+                                            .withMaxHeapSize(static_cast<hermes::vm::gcheapsize_t>(maxHeapSize))
+                                            .withCallback(std::move(gcCallback))
                                             .build())
                           .build();
 
@@ -166,6 +209,16 @@ namespace Napi
         (void)runtime->drainJobs();
     }
 
+    void CollectGarbage(Napi::Env env)
+    {
+        hermes::vm::Runtime* runtime = LookupRuntime(env);
+        if (runtime == nullptr)
+        {
+            return;
+        }
+        runtime->collect("memory pressure");
+    }
+
     Napi::Value Eval(Napi::Env env, const char* source, const char* sourceUrl)
     {
         napi_env env_ptr{env};
@@ -227,3 +280,292 @@ namespace Napi
         return Napi::Value{env, result};
     }
 }
+
+napi_status napi_create_property_key_utf8(napi_env env, const char* utf8name, size_t length, napi_property_key* result)
+{
+    if (env == nullptr || utf8name == nullptr || result == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+
+    std::string name = (length == NAPI_AUTO_LENGTH) ? std::string{utf8name} : std::string{utf8name, length};
+
+    std::scoped_lock lock{StateMutex()};
+    auto state = StateMap().find(env);
+    if (state == StateMap().end())
+    {
+        return napi_invalid_arg;
+    }
+
+    auto& keys = state->second.propertyKeys;
+    auto it = keys.find(name);
+    if (it == keys.end())
+    {
+        auto key = std::make_unique<napi_property_key__>(napi_property_key__{name});
+        it = keys.emplace(std::move(name), std::move(key)).first;
+    }
+
+    *result = it->second.get();
+    return napi_ok;
+}
+
+napi_status napi_get_property_key_value(napi_env env, napi_property_key key, napi_value* result)
+{
+    if (key == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+    return napi_create_string_utf8(env, key->name.data(), key->name.size(), result);
+}
+
+napi_status napi_set_keyed_property(napi_env env, napi_value object, napi_property_key key, napi_value value)
+{
+    if (key == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+    return napi_set_named_property(env, object, key->name.c_str(), value);
+}
+
+napi_status napi_has_keyed_property(napi_env env, napi_value object, napi_property_key key, bool* result)
+{
+    if (key == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+    return napi_has_named_property(env, object, key->name.c_str(), result);
+}
+
+napi_status napi_get_keyed_property(napi_env env, napi_value object, napi_property_key key, napi_value* result)
+{
+    if (key == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+    return napi_get_named_property(env, object, key->name.c_str(), result);
+}
+
+napi_status napi_define_own_properties_batch(napi_env env, napi_value object, size_t count, const napi_property_key* keys, const napi_value* values)
+{
+    if (count > 0 && (keys == nullptr || values == nullptr))
+    {
+        return napi_invalid_arg;
+    }
+
+    std::vector<napi_property_descriptor> descriptors(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (keys[i] == nullptr)
+        {
+            return napi_invalid_arg;
+        }
+
+        descriptors[i].utf8name = keys[i]->name.c_str();
+        descriptors[i].value = values[i];
+        descriptors[i].attributes = napi_default_jsproperty;
+    }
+    return napi_define_properties(env, object, count, descriptors.data());
+}
+
+napi_status napi_get_properties_batch(napi_env env, napi_value object, size_t count, const napi_property_key* keys, napi_value* results)
+{
+    if (count > 0 && (keys == nullptr || results == nullptr))
+    {
+        return napi_invalid_arg;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const napi_status status = napi_get_keyed_property(env, object, keys[i], &results[i]);
+        if (status != napi_ok)
+        {
+            return status;
+        }
+    }
+    return napi_ok;
+}
+
+napi_status napi_create_object_template(napi_env env, size_t count, const napi_property_key* keys, napi_object_template* result)
+{
+    if (env == nullptr || result == nullptr || (count > 0 && keys == nullptr))
+    {
+        return napi_invalid_arg;
+    }
+
+    std::vector<napi_property_key> keyList(keys, keys + count);
+
+    std::scoped_lock lock{StateMutex()};
+    auto state = StateMap().find(env);
+    if (state == StateMap().end())
+    {
+        return napi_invalid_arg;
+    }
+
+    auto& templates = state->second.objectTemplates;
+    auto it = templates.find(keyList);
+    if (it == templates.end())
+    {
+        auto objectTemplate = std::make_unique<napi_object_template__>(napi_object_template__{keyList});
+        it = templates.emplace(std::move(keyList), std::move(objectTemplate)).first;
+    }
+
+    *result = it->second.get();
+    return napi_ok;
+}
+
+napi_status napi_new_instance_from_template(napi_env env, napi_object_template objectTemplate, const napi_value* values, napi_value* result)
+{
+    if (objectTemplate == nullptr || result == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+
+    napi_value object = nullptr;
+    napi_status status = napi_create_object(env, &object);
+    if (status != napi_ok)
+    {
+        return status;
+    }
+
+    status = napi_define_own_properties_batch(env, object, objectTemplate->keys.size(), objectTemplate->keys.data(), values);
+    if (status != napi_ok)
+    {
+        return status;
+    }
+
+    *result = object;
+    return napi_ok;
+}
+
+// String views only go through the standard copy calls here: measure, then
+// copy into the caller's buffer when it fits.
+napi_status napi_get_value_string_utf8_view(napi_env env, napi_value value, char* buf, size_t bufsize, const char** result, size_t* length)
+{
+    if (result == nullptr || length == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+
+    napi_status status = napi_get_value_string_utf8(env, value, nullptr, 0, length);
+    if (status != napi_ok)
+    {
+        return status;
+    }
+
+    if (buf == nullptr || *length >= bufsize)
+    {
+        *result = nullptr;
+        return napi_ok;
+    }
+
+    status = napi_get_value_string_utf8(env, value, buf, bufsize, length);
+    if (status != napi_ok)
+    {
+        return status;
+    }
+
+    *result = buf;
+    return napi_ok;
+}
+
+napi_status napi_release_string_utf8_view(napi_env env, const char* /*data*/)
+{
+    return env == nullptr ? napi_invalid_arg : napi_ok;
+}
+
+// hermesNapi can only detach a buffer by freeing its memory.
+napi_status napi_take_arraybuffer_contents(napi_env env, napi_value arraybuffer, void** data, size_t* byte_length, napi_arraybuffer_contents* contents)
+{
+    if (env == nullptr || arraybuffer == nullptr || data == nullptr || byte_length == nullptr || contents == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+
+    return napi_generic_failure;
+}
+
+napi_status napi_release_arraybuffer_contents(napi_arraybuffer_contents /*contents*/)
+{
+    return napi_ok;
+}
+
+napi_status napi_create_arraybuffer_from_contents(napi_env env, napi_arraybuffer_contents contents, napi_value* result)
+{
+    if (env == nullptr || contents == nullptr || result == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+
+    return napi_generic_failure;
+}
+
+// Hermes can't create SharedArrayBuffers over embedder memory through
+// hermesNapi, so the memory is exposed as an external ArrayBuffer instead.
+napi_status napi_allocate_shared_memory(napi_env env, size_t byte_length, void** data)
+{
+    if (env == nullptr || data == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+
+    *data = byte_length == 0 ? nullptr : std::calloc(1, byte_length);
+    return (*data != nullptr || byte_length == 0) ? napi_ok : napi_generic_failure;
+}
+
+napi_status napi_free_shared_memory(void* data, size_t /*byte_length*/)
+{
+    std::free(data);
+    return napi_ok;
+}
+
+napi_status napi_create_external_sharedarraybuffer(napi_env env, void* external_data, size_t byte_length, napi_finalize finalize_cb, void* finalize_hint, napi_value* result)
+{
+    return napi_create_external_arraybuffer(env, external_data, byte_length, finalize_cb, finalize_hint, result);
+}
+
+napi_status napi_is_sharedarraybuffer(napi_env env, napi_value value, bool* result)
+{
+    if (result == nullptr)
+    {
+        return napi_invalid_arg;
+    }
+
+    napi_value global = nullptr;
+    napi_value constructor = nullptr;
+    napi_valuetype constructorType = napi_undefined;
+    napi_status status = napi_get_global(env, &global);
+    if (status == napi_ok)
+    {
+        status = napi_get_named_property(env, global, "SharedArrayBuffer", &constructor);
+    }
+    if (status == napi_ok)
+    {
+        status = napi_typeof(env, constructor, &constructorType);
+    }
+    if (status != napi_ok)
+    {
+        return status;
+    }
+
+    if (constructorType != napi_function)
+    {
+        *result = false;
+        return napi_ok;
+    }
+    return napi_instanceof(env, value, constructor, result);
+}
+
+napi_status napi_get_sharedarraybuffer_info(napi_env env, napi_value sharedarraybuffer, void** data, size_t* byte_length)
+{
+    bool isArrayBuffer = false;
+    napi_status status = napi_is_arraybuffer(env, sharedarraybuffer, &isArrayBuffer);
+    if (status != napi_ok)
+    {
+        return status;
+    }
+    if (!isArrayBuffer)
+    {
+        return napi_generic_failure;
+    }
+    return napi_get_arraybuffer_info(env, sharedarraybuffer, data, byte_length);
+}
@@ -101,6 +101,14 @@ namespace Napi
                 JS_FreeValue(env_ptr->context, value);
             }
 
+            // Keys are handed out as raw pointers, so the map entries stay
+            // alive with the env; only the atoms are released here.
+            for (auto& [name, key] : env_ptr->property_keys)
+            {
+                JS_FreeAtom(env_ptr->context, key->atom);
+                key->atom = JS_ATOM_NULL;
+            }
+
             if (!JS_IsUndefined(env_ptr->has_own_property_function))
             {
                 JS_FreeValue(env_ptr->context, env_ptr->has_own_property_function);
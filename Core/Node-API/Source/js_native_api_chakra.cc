@@ -3,6 +3,7 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 #include <optional>
 #include <vector>
 #include <string>
@@ -801,6 +802,164 @@ napi_status napi_get_named_property(napi_env env,
   return napi_ok;
 }
 
+napi_status napi_create_property_key_utf8(napi_env env,
+                                          const char* utf8name,
+                                          size_t length,
+                                          napi_property_key* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, utf8name);
+  CHECK_ARG(env, result);
+  std::string name = (length == NAPI_AUTO_LENGTH) ? std::string{utf8name} : std::string{utf8name, length};
+  auto it = env->property_keys.find(name);
+  if (it == env->property_keys.end()) {
+    auto key = std::make_unique<napi_property_key__>();
+    CHECK_JSRT(env, JsCreatePropertyId(name.data(), name.size(), &key->property_id));
+    CHECK_JSRT(env, JsAddRef(key->property_id, nullptr));
+    key->name = name;
+    it = env->property_keys.emplace(std::move(name), std::move(key)).first;
+  }
+  *result = it->second.get();
+  return napi_ok;
+}
+
+napi_status napi_get_property_key_value(napi_env env,
+                                        napi_property_key key,
+                                        napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+  return napi_create_string_utf8(env, key->name.data(), key->name.size(), result);
+}
+
+napi_status napi_set_keyed_property(napi_env env,
+                                    napi_value object,
+                                    napi_property_key key,
+                                    napi_value value) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, value);
+  JsValueRef obj = reinterpret_cast<JsValueRef>(object);
+  JsValueRef js_value = reinterpret_cast<JsValueRef>(value);
+  CHECK_JSRT(env, JsSetProperty(obj, key->property_id, js_value, true));
+  return napi_ok;
+}
+
+napi_status napi_has_keyed_property(napi_env env,
+                                    napi_value object,
+                                    napi_property_key key,
+                                    bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+  JsValueRef obj = reinterpret_cast<JsValueRef>(object);
+  CHECK_JSRT(env, JsHasProperty(obj, key->property_id, result));
+  return napi_ok;
+}
+
+napi_status napi_get_keyed_property(napi_env env,
+                                    napi_value object,
+                                    napi_property_key key,
+                                    napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+  JsValueRef obj = reinterpret_cast<JsValueRef>(object);
+  CHECK_JSRT(env,
+    JsGetProperty(obj, key->property_id, reinterpret_cast<JsValueRef*>(result)));
+  return napi_ok;
+}
+
+napi_status napi_define_own_properties_batch(napi_env env,
+                                             napi_value object,
+                                             size_t count,
+                                             const napi_property_key* keys,
+                                             const napi_value* values) {
+  CHECK_ENV(env);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, values);
+  }
+  // One descriptor serves every property; only its value changes between
+  // definitions.
+  JsValueRef descriptor;
+  CHECK_JSRT(env, JsCreateObject(&descriptor));
+  JsValueRef trueValue;
+  CHECK_JSRT(env, JsGetTrueValue(&trueValue));
+  auto setTrueField = [&](const char* name, size_t len) -> napi_status {
+    JsPropertyIdRef pid;
+    CHECK_JSRT(env, JsCreatePropertyId(name, len, &pid));
+    CHECK_JSRT(env, JsSetProperty(descriptor, pid, trueValue, true));
+    return napi_ok;
+  };
+  CHECK_NAPI(setTrueField(STR_AND_LENGTH("writable")));
+  CHECK_NAPI(setTrueField(STR_AND_LENGTH("enumerable")));
+  CHECK_NAPI(setTrueField(STR_AND_LENGTH("configurable")));
+  JsPropertyIdRef valueProperty;
+  CHECK_JSRT(env, JsCreatePropertyId(STR_AND_LENGTH("value"), &valueProperty));
+
+  JsValueRef obj = reinterpret_cast<JsValueRef>(object);
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_ARG(env, keys[i]);
+    CHECK_JSRT(env, JsSetProperty(descriptor, valueProperty, reinterpret_cast<JsValueRef>(values[i]), true));
+    bool defined;
+    CHECK_JSRT(env, JsDefineProperty(obj, keys[i]->property_id, descriptor, &defined));
+  }
+  return napi_ok;
+}
+
+napi_status napi_get_properties_batch(napi_env env,
+                                      napi_value object,
+                                      size_t count,
+                                      const napi_property_key* keys,
+                                      napi_value* results) {
+  CHECK_ENV(env);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, results);
+  }
+  JsValueRef obj = reinterpret_cast<JsValueRef>(object);
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_ARG(env, keys[i]);
+    CHECK_JSRT(env,
+      JsGetProperty(obj, keys[i]->property_id, reinterpret_cast<JsValueRef*>(&results[i])));
+  }
+  return napi_ok;
+}
+
+napi_status napi_create_object_template(napi_env env,
+                                        size_t count,
+                                        const napi_property_key* keys,
+                                        napi_object_template* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+  }
+  std::vector<napi_property_key> key_list(keys, keys + count);
+  auto it = env->object_templates.find(key_list);
+  if (it == env->object_templates.end()) {
+    auto object_template = std::make_unique<napi_object_template__>();
+    object_template->keys = key_list;
+    it = env->object_templates.emplace(std::move(key_list), std::move(object_template)).first;
+  }
+  *result = it->second.get();
+  return napi_ok;
+}
+
+napi_status napi_new_instance_from_template(napi_env env,
+                                            napi_object_template object_template,
+                                            const napi_value* values,
+                                            napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object_template);
+  CHECK_ARG(env, result);
+  JsValueRef object;
+  CHECK_JSRT(env, JsCreateObject(&object));
+  CHECK_NAPI(napi_define_own_properties_batch(env, reinterpret_cast<napi_value>(object), object_template->keys.size(), object_template->keys.data(), values));
+  *result = reinterpret_cast<napi_value>(object);
+  return napi_ok;
+}
+
 napi_status napi_set_element(napi_env env,
                              napi_value object,
                              uint32_t index,
@@ -1031,6 +1190,59 @@ napi_status napi_create_string_utf16(napi_env env,
   return napi_ok;
 }
 
+namespace {
+// Chakra copies every string it is given, so this is a plain copy: the
+// characters go through the regular string creation and the native buffer is
+// handed back to its finalizer straight away instead of being kept alive
+// alongside the engine's copy.
+template <typename CharType, typename CreateAPI>
+napi_status NewExternalString(napi_env env,
+                              CharType* str,
+                              size_t length,
+                              napi_finalize finalize_callback,
+                              void* finalize_hint,
+                              napi_value* result,
+                              bool* copied,
+                              CreateAPI create_api) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env, str != nullptr || length == 0, napi_invalid_arg);
+
+  if (length == NAPI_AUTO_LENGTH) {
+    length = std::char_traits<CharType>::length(str);
+  }
+
+  CHECK_NAPI(create_api(env, str, length, result));
+  if (copied != nullptr) {
+    *copied = true;
+  }
+  if (finalize_callback != nullptr) {
+    finalize_callback(env, str, finalize_hint);
+  }
+  return napi_ok;
+}
+}
+
+napi_status node_api_create_external_string_latin1(napi_env env,
+                                                   char* str,
+                                                   size_t length,
+                                                   napi_finalize finalize_callback,
+                                                   void* finalize_hint,
+                                                   napi_value* result,
+                                                   bool* copied) {
+  return NewExternalString(env, str, length, finalize_callback, finalize_hint, result, copied, napi_create_string_latin1);
+}
+
+napi_status node_api_create_external_string_utf16(napi_env env,
+                                                  char16_t* str,
+                                                  size_t length,
+                                                  napi_finalize finalize_callback,
+                                                  void* finalize_hint,
+                                                  napi_value* result,
+                                                  bool* copied) {
+  return NewExternalString(env, str, length, finalize_callback, finalize_hint, result, copied, napi_create_string_utf16);
+}
+
 napi_status napi_create_double(napi_env env,
                                double value,
                                napi_value* result) {
@@ -1503,6 +1715,41 @@ napi_status napi_get_value_string_latin1(napi_env env,
 // If buf is NULL, this method returns the length of the string (in bytes)
 // via the result parameter.
 // The result argument is optional unless buf is NULL.
+// Chakra has no way to expose its string storage, so the view is always a
+// copy into `buf` when the string fits.
+napi_status napi_get_value_string_utf8_view(napi_env env,
+                                            napi_value value,
+                                            char* buf,
+                                            size_t bufsize,
+                                            const char** result,
+                                            size_t* length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, length);
+
+  JsValueRef jsValue = reinterpret_cast<JsValueRef>(value);
+  CHECK_JSRT_EXPECTED(env,
+    JsCopyString(jsValue, nullptr, 0, length),
+    napi_string_expected);
+
+  if (buf == nullptr || *length >= bufsize) {
+    *result = nullptr;
+    return napi_ok;
+  }
+
+  CHECK_JSRT_EXPECTED(env,
+    JsCopyString(jsValue, buf, *length, nullptr),
+    napi_string_expected);
+  *result = buf;
+  return napi_ok;
+}
+
+napi_status napi_release_string_utf8_view(napi_env env, const char* /*data*/) {
+  CHECK_ENV(env);
+  return napi_ok;
+}
+
 napi_status napi_get_value_string_utf8(napi_env env,
                                        napi_value value,
                                        char* buf,
@@ -2117,6 +2364,103 @@ napi_status napi_get_arraybuffer_info(napi_env env,
   return napi_ok;
 }
 
+// JsRT has no way to detach an ArrayBuffer.
+napi_status napi_detach_arraybuffer(napi_env env, napi_value arraybuffer) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, arraybuffer);
+
+  return napi_set_last_error(env, napi_generic_failure);
+}
+
+napi_status napi_take_arraybuffer_contents(napi_env env,
+                                           napi_value arraybuffer,
+                                           void** data,
+                                           size_t* byte_length,
+                                           napi_arraybuffer_contents* contents) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, arraybuffer);
+  CHECK_ARG(env, data);
+  CHECK_ARG(env, byte_length);
+  CHECK_ARG(env, contents);
+
+  return napi_set_last_error(env, napi_generic_failure);
+}
+
+napi_status napi_release_arraybuffer_contents(napi_arraybuffer_contents) {
+  return napi_ok;
+}
+
+napi_status napi_create_arraybuffer_from_contents(napi_env env,
+                                                  napi_arraybuffer_contents contents,
+                                                  napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, contents);
+  CHECK_ARG(env, result);
+
+  return napi_set_last_error(env, napi_generic_failure);
+}
+
+// SharedArrayBuffer support
+// Chakra can't create SharedArrayBuffers over embedder memory (or read
+// the memory of one) through its embedding API, so the memory is exposed as an
+// external ArrayBuffer instead.
+napi_status napi_allocate_shared_memory(napi_env env, size_t byte_length, void** data) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, data);
+
+  *data = byte_length == 0 ? nullptr : std::calloc(1, byte_length);
+  RETURN_STATUS_IF_FALSE(env, *data != nullptr || byte_length == 0, napi_generic_failure);
+
+  return napi_ok;
+}
+
+napi_status napi_free_shared_memory(void* data, size_t) {
+  std::free(data);
+  return napi_ok;
+}
+
+napi_status napi_create_external_sharedarraybuffer(napi_env env,
+                                                   void* external_data,
+                                                   size_t byte_length,
+                                                   napi_finalize finalize_cb,
+                                                   void* finalize_hint,
+                                                   napi_value* result) {
+  return napi_create_external_arraybuffer(env, external_data, byte_length, finalize_cb, finalize_hint, result);
+}
+
+napi_status napi_is_sharedarraybuffer(napi_env env, napi_value value, bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  napi_value global{}, shared_array_buffer_ctor{};
+  napi_valuetype ctor_type{};
+  CHECK_NAPI(napi_get_global(env, &global));
+  CHECK_NAPI(napi_get_named_property(env, global, "SharedArrayBuffer", &shared_array_buffer_ctor));
+  CHECK_NAPI(napi_typeof(env, shared_array_buffer_ctor, &ctor_type));
+  if (ctor_type != napi_function) {
+    *result = false;
+    return napi_ok;
+  }
+
+  CHECK_NAPI(napi_instanceof(env, value, shared_array_buffer_ctor, result));
+  return napi_ok;
+}
+
+napi_status napi_get_sharedarraybuffer_info(napi_env env,
+                                            napi_value sharedarraybuffer,
+                                            void** data,
+                                            size_t* byte_length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, sharedarraybuffer);
+
+  bool is_arraybuffer{};
+  CHECK_NAPI(napi_is_arraybuffer(env, sharedarraybuffer, &is_arraybuffer));
+  RETURN_STATUS_IF_FALSE(env, is_arraybuffer, napi_generic_failure);
+
+  return napi_get_arraybuffer_info(env, sharedarraybuffer, data, byte_length);
+}
+
 napi_status napi_is_typedarray(napi_env env, napi_value value, bool* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, value);
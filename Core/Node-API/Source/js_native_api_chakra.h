@@ -7,6 +7,24 @@
 #include <napi/js_native_api_types.h>
 #include <thread>
 #include <cassert>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Interned property key. The property id is AddRef'd for the env's lifetime;
+// the name is kept to hand back a string value on request.
+struct napi_property_key__ {
+  JsPropertyIdRef property_id = JS_INVALID_REFERENCE;
+  std::string name;
+};
+
+// Template for same-shape objects: the interned keys, in definition order, so
+// instances follow the same type-handler path.
+struct napi_object_template__ {
+  std::vector<napi_property_key> keys;
+};
 
 struct napi_env__ {
   JsSourceContext source_context = JS_SOURCE_CONTEXT_NONE;
@@ -15,6 +33,9 @@ struct napi_env__ {
 
   JsPropertyIdRef wrap_property_id = JS_INVALID_REFERENCE;
 
+  std::unordered_map<std::string, std::unique_ptr<napi_property_key__>> property_keys;
+  std::map<std::vector<napi_property_key>, std::unique_ptr<napi_object_template__>> object_templates;
+
   const std::thread::id thread_id{std::this_thread::get_id()};
 };
 
@@ -1,7 +1,9 @@
 #include "js_native_api_javascriptcore.h"
+#include "unicode.h"
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <stdexcept>
@@ -51,6 +53,17 @@ namespace {
       return {string};
     }
 
+    // Latin-1 code units map one-to-one onto UTF-16 code units, so this is a
+    // single widening pass with no decoding.
+    static JSString Latin1(const char* string, size_t length = NAPI_AUTO_LENGTH) {
+      if (length == NAPI_AUTO_LENGTH) {
+        length = std::strlen(string);
+      }
+      std::u16string u16str(length, u'\0');
+      unicode::Widen(string, length, u16str.data());
+      return {JSStringCreateWithCharacters(reinterpret_cast<const JSChar*>(u16str.data()), u16str.size())};
+    }
+
     operator JSStringRef() const {
       return _string;
     }
@@ -59,9 +72,13 @@ namespace {
       return JSStringGetLength(_string);
     }
 
+    const char16_t* Characters() const {
+      static_assert(sizeof(char16_t) == sizeof(JSChar));
+      return reinterpret_cast<const char16_t*>(JSStringGetCharactersPtr(_string));
+    }
+
     size_t LengthUTF8() const {
-      std::vector<char> buffer(JSStringGetMaximumUTF8CStringSize(_string));
-      return JSStringGetUTF8CString(_string, buffer.data(), buffer.size()) - 1;
+      return unicode::Utf16Utf8Length(Characters(), Length());
     }
 
     size_t LengthLatin1() const {
@@ -73,7 +90,7 @@ namespace {
       size_t length{JSStringGetLength(_string)};
       const JSChar* chars{JSStringGetCharactersPtr(_string)};
       size_t size{std::min(length, bufsize - 1)};
-      std::memcpy(buf, chars, size);
+      std::memcpy(buf, chars, size * sizeof(JSChar));
       buf[size] = 0;
       if (result != nullptr) {
         *result = size;
@@ -81,10 +98,11 @@ namespace {
     }
 
     void CopyToUTF8(char* buf, size_t bufsize, size_t* result) const {
-      size_t size{JSStringGetUTF8CString(_string, buf, bufsize)};
+      // Truncates on a code point boundary, like JSStringGetUTF8CString.
+      size_t size{unicode::Utf16ToUtf8(Characters(), Length(), buf, bufsize - 1)};
+      buf[size] = '\0';
       if (result != nullptr) {
-        // JSStringGetUTF8CString returns size with null terminator.
-        *result = size - 1;
+        *result = size;
       }
     }
 
@@ -102,69 +120,15 @@ namespace {
     }
 
    private:
-    // Decode UTF-8 to UTF-16, replacing invalid sequences with U+FFFD.
-    static std::u16string Utf8ToUtf16(const char* str, size_t len) {
-      std::u16string result;
-      result.reserve(len);
-      const auto* s = reinterpret_cast<const unsigned char*>(str);
-      const auto* end = s + len;
-      while (s < end) {
-        uint32_t cp;
-        int trail;
-        unsigned char lead = *s++;
-        if (lead < 0x80) {
-          cp = lead; trail = 0;
-        } else if ((lead >> 5) == 0x6) {
-          cp = lead & 0x1F; trail = 1;
-        } else if ((lead >> 4) == 0xE) {
-          cp = lead & 0x0F; trail = 2;
-        } else if ((lead >> 3) == 0x1E) {
-          cp = lead & 0x07; trail = 3;
-        } else {
-          result.push_back(0xFFFD);
-          continue;
-        }
-        if (s + trail > end) {
-          result.push_back(0xFFFD);
-          break;
-        }
-        bool valid = true;
-        for (int i = 0; i < trail; ++i) {
-          if ((s[i] & 0xC0) != 0x80) { valid = false; break; }
-          cp = (cp << 6) | (s[i] & 0x3F);
-        }
-        if (!valid) {
-          result.push_back(0xFFFD);
-          continue;
-        }
-        s += trail;
-        // Reject overlong encodings, surrogates, and out-of-range values.
-        if ((trail == 1 && cp < 0x80) ||
-            (trail == 2 && cp < 0x800) ||
-            (trail == 3 && cp < 0x10000) ||
-            (cp >= 0xD800 && cp <= 0xDFFF) ||
-            cp > 0x10FFFF) {
-          result.push_back(0xFFFD);
-          continue;
-        }
-        if (cp <= 0xFFFF) {
-          result.push_back(static_cast<char16_t>(cp));
-        } else {
-          cp -= 0x10000;
-          result.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
-          result.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
-        }
-      }
-      return result;
-    }
-
     static JSStringRef CreateUTF8(const char* string, size_t length) {
       if (length == NAPI_AUTO_LENGTH) {
         return JSStringCreateWithUTF8CString(string);
       }
 
-      std::u16string u16str{Utf8ToUtf16(string, length)};
-      return JSStringCreateWithCharacters(reinterpret_cast<JSChar*>(u16str.data()), u16str.size());
+      // Decode UTF-8 to UTF-16, replacing invalid sequences with U+FFFD.
+      std::u16string u16str(length, u'\0');
+      u16str.resize(unicode::Utf8ToUtf16(string, length, u16str.data(), false));
+      return JSStringCreateWithCharacters(reinterpret_cast<const JSChar*>(u16str.data()), u16str.size());
     }
 
     JSString(JSStringRef string)
@@ -832,6 +796,13 @@ void napi_env__::deinit_refs() {
   }
 }
 
+void napi_env__::deinit_property_keys() {
+  for (auto& [name, key] : property_keys) {
+    JSStringRelease(key->name);
+  }
+  property_keys.clear();
+}
+
 void napi_env__::init_symbol(JSValueRef &symbol, const char *description) {
   symbol = JSValueMakeSymbol(context, JSString(description));
   JSValueProtect(context, symbol);
@@ -1131,6 +1102,198 @@ napi_status napi_get_named_property(napi_env env,
   return napi_ok;
 }
 
+napi_status napi_create_property_key_utf8(napi_env env,
+                                          const char* utf8name,
+                                          size_t length,
+                                          napi_property_key* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, utf8name);
+  CHECK_ARG(env, result);
+
+  std::string name{length == NAPI_AUTO_LENGTH ? std::string{utf8name} : std::string{utf8name, length}};
+  auto it{env->property_keys.find(name)};
+  if (it == env->property_keys.end()) {
+    auto key{std::make_unique<napi_property_key__>()};
+    key->name = JSStringCreateWithUTF8CString(name.c_str());
+    it = env->property_keys.emplace(std::move(name), std::move(key)).first;
+  }
+
+  *result = it->second.get();
+  return napi_ok;
+}
+
+napi_status napi_get_property_key_value(napi_env env,
+                                        napi_property_key key,
+                                        napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  *result = ToNapi(JSValueMakeString(env->context, key->name));
+  return napi_ok;
+}
+
+napi_status napi_set_keyed_property(napi_env env,
+                                    napi_value object,
+                                    napi_property_key key,
+                                    napi_value value) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, value);
+
+  JSValueRef exception{};
+  JSObjectSetProperty(
+    env->context,
+    ToJSObject(env, object),
+    key->name,
+    ToJSValue(value),
+    kJSPropertyAttributeNone,
+    &exception);
+  CHECK_JSC(env, exception);
+
+  return napi_ok;
+}
+
+napi_status napi_has_keyed_property(napi_env env,
+                                    napi_value object,
+                                    napi_property_key key,
+                                    bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  *result = JSObjectHasProperty(
+    env->context,
+    ToJSObject(env, object),
+    key->name);
+
+  return napi_ok;
+}
+
+napi_status napi_get_keyed_property(napi_env env,
+                                    napi_value object,
+                                    napi_property_key key,
+                                    napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  JSValueRef exception{};
+  *result = ToNapi(JSObjectGetProperty(
+    env->context,
+    ToJSObject(env, object),
+    key->name,
+    &exception));
+  CHECK_JSC(env, exception);
+
+  return napi_ok;
+}
+
+napi_status napi_define_own_properties_batch(napi_env env,
+                                             napi_value object,
+                                             size_t count,
+                                             const napi_property_key* keys,
+                                             const napi_value* values) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, values);
+  }
+
+  // The JSC C API only defines (rather than sets) a property when it is given
+  // attributes, and then the property isn't writable, enumerable and
+  // configurable, so go through Object.defineProperty with one descriptor
+  // whose value changes between definitions.
+  napi_value global{}, object_ctor{}, function{};
+  CHECK_NAPI(napi_get_global(env, &global));
+  CHECK_NAPI(napi_get_named_property(env, global, "Object", &object_ctor));
+  CHECK_NAPI(napi_get_named_property(env, object_ctor, "defineProperty", &function));
+
+  napi_value descriptor{}, true_value{};
+  CHECK_NAPI(napi_create_object(env, &descriptor));
+  CHECK_NAPI(napi_get_boolean(env, true, &true_value));
+  CHECK_NAPI(napi_set_named_property(env, descriptor, "writable", true_value));
+  CHECK_NAPI(napi_set_named_property(env, descriptor, "enumerable", true_value));
+  CHECK_NAPI(napi_set_named_property(env, descriptor, "configurable", true_value));
+
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_ARG(env, keys[i]);
+    CHECK_NAPI(napi_set_named_property(env, descriptor, "value", values[i]));
+
+    napi_value args[] = { object, ToNapi(JSValueMakeString(env->context, keys[i]->name)), descriptor };
+    CHECK_NAPI(napi_call_function(env, object_ctor, function, 3, args, nullptr));
+  }
+
+  return napi_ok;
+}
+
+napi_status napi_get_properties_batch(napi_env env,
+                                      napi_value object,
+                                      size_t count,
+                                      const napi_property_key* keys,
+                                      napi_value* results) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, results);
+  }
+
+  JSObjectRef jsObject{ToJSObject(env, object)};
+  JSValueRef exception{};
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_ARG(env, keys[i]);
+    results[i] = ToNapi(JSObjectGetProperty(
+      env->context,
+      jsObject,
+      keys[i]->name,
+      &exception));
+    CHECK_JSC(env, exception);
+  }
+
+  return napi_ok;
+}
+
+napi_status napi_create_object_template(napi_env env,
+                                        size_t count,
+                                        const napi_property_key* keys,
+                                        napi_object_template* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+  }
+
+  std::vector<napi_property_key> key_list(keys, keys + count);
+  auto it{env->object_templates.find(key_list)};
+  if (it == env->object_templates.end()) {
+    auto object_template{std::make_unique<napi_object_template__>()};
+    object_template->keys = key_list;
+    it = env->object_templates.emplace(std::move(key_list), std::move(object_template)).first;
+  }
+
+  *result = it->second.get();
+  return napi_ok;
+}
+
+napi_status napi_new_instance_from_template(napi_env env,
+                                            napi_object_template object_template,
+                                            const napi_value* values,
+                                            napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object_template);
+  CHECK_ARG(env, result);
+
+  napi_value object{ToNapi(JSObjectMake(env->context, nullptr, nullptr))};
+  CHECK_NAPI(napi_define_own_properties_batch(env, object, object_template->keys.size(), object_template->keys.data(), values));
+
+  *result = object;
+  return napi_ok;
+}
+
 napi_status napi_set_element(napi_env env,
                              napi_value object,
                              uint32_t index,
@@ -1391,7 +1554,7 @@ napi_status napi_create_string_latin1(napi_env env,
   CHECK_ARG(env, result);
   *result = ToNapi(JSValueMakeString(
     env->context,
-    JSString(str, length)));
+    JSString::Latin1(str, length)));
   return napi_ok;
 }
 
@@ -1420,6 +1583,56 @@ napi_status napi_create_string_utf16(napi_env env,
   return napi_ok;
 }
 
+namespace {
+  // JSStringCreateWithCharactersNoCopy has no way to tell when the engine
+  // stops referencing the characters, so there is nowhere to run the
+  // finalizer from. This is a plain copy instead: the characters go through
+  // the regular string creation and the native buffer is handed back to its
+  // finalizer straight away instead of being kept alive alongside the copy.
+  template <typename CharType, typename CreateAPI>
+  napi_status NewExternalString(napi_env env,
+                                CharType* str,
+                                size_t length,
+                                napi_finalize finalize_callback,
+                                void* finalize_hint,
+                                napi_value* result,
+                                bool* copied,
+                                CreateAPI create_api) {
+    CHECK_ENV(env);
+    CHECK_ARG(env, result);
+    RETURN_STATUS_IF_FALSE(env, str != nullptr || length == 0, napi_invalid_arg);
+
+    CHECK_NAPI(create_api(env, str, length, result));
+    if (copied != nullptr) {
+      *copied = true;
+    }
+    if (finalize_callback != nullptr) {
+      finalize_callback(env, str, finalize_hint);
+    }
+    return napi_ok;
+  }
+}
+
+napi_status node_api_create_external_string_latin1(napi_env env,
+                                                   char* str,
+                                                   size_t length,
+                                                   napi_finalize finalize_callback,
+                                                   void* finalize_hint,
+                                                   napi_value* result,
+                                                   bool* copied) {
+  return NewExternalString(env, str, length, finalize_callback, finalize_hint, result, copied, napi_create_string_latin1);
+}
+
+napi_status node_api_create_external_string_utf16(napi_env env,
+                                                  char16_t* str,
+                                                  size_t length,
+                                                  napi_finalize finalize_callback,
+                                                  void* finalize_hint,
+                                                  napi_value* result,
+                                                  bool* copied) {
+  return NewExternalString(env, str, length, finalize_callback, finalize_hint, result, copied, napi_create_string_utf16);
+}
+
 napi_status napi_create_double(napi_env env,
                                double value,
                                napi_value* result) {
@@ -1808,6 +2021,7 @@ napi_status napi_get_value_string_latin1(napi_env env,
                                          size_t* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, value);
+  RETURN_STATUS_IF_FALSE(env, JSValueIsString(env->context, ToJSValue(value)), napi_string_expected);
 
   JSValueRef exception{};
   JSString string{ToJSString(env, value, &exception)};
@@ -1843,6 +2057,7 @@ napi_status napi_get_value_string_utf8(napi_env env,
                                        size_t* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, value);
+  RETURN_STATUS_IF_FALSE(env, JSValueIsString(env->context, ToJSValue(value)), napi_string_expected);
 
   JSValueRef exception{};
   JSString string{ToJSString(env, value, &exception)};
@@ -1863,6 +2078,47 @@ napi_status napi_get_value_string_utf8(napi_env env,
   return napi_ok;
 }
 
+// JavaScriptCore keeps strings as UTF-16, so there is no UTF-8 storage to
+// expose. The characters are transcoded once: straight into `buf` when their
+// worst-case UTF-8 size fits, otherwise into a buffer of the exact size that
+// napi_release_string_utf8_view frees.
+napi_status napi_get_value_string_utf8_view(napi_env env,
+                                            napi_value value,
+                                            char* buf,
+                                            size_t bufsize,
+                                            const char** result,
+                                            size_t* length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, length);
+  RETURN_STATUS_IF_FALSE(env, JSValueIsString(env->context, ToJSValue(value)), napi_string_expected);
+
+  JSValueRef exception{};
+  JSString string{ToJSString(env, value, &exception)};
+  CHECK_JSC(env, exception);
+
+  const char16_t* chars{string.Characters()};
+  const size_t count{string.Length()};
+  if (buf != nullptr && count * 3 <= bufsize) {
+    *length = unicode::Utf16ToUtf8(chars, count, buf);
+    *result = buf;
+    return napi_ok;
+  }
+
+  *length = unicode::Utf16Utf8Length(chars, count);
+  char* data{new char[*length]};
+  unicode::Utf16ToUtf8(chars, count, data);
+  *result = data;
+  return napi_ok;
+}
+
+napi_status napi_release_string_utf8_view(napi_env env, const char* data) {
+  CHECK_ENV(env);
+  delete[] data;
+  return napi_ok;
+}
+
 // Copies a JavaScript string into a UTF-16 string buffer. The result is the
 // number of 2-byte code units (excluding the null terminator) copied into buf.
 // A sufficient buffer size should be greater than the length of string,
@@ -1878,6 +2134,7 @@ napi_status napi_get_value_string_utf16(napi_env env,
                                         size_t* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, value);
+  RETURN_STATUS_IF_FALSE(env, JSValueIsString(env->context, ToJSValue(value)), napi_string_expected);
 
   JSValueRef exception{};
   JSString string{ToJSString(env, value, &exception)};
@@ -2301,6 +2558,113 @@ napi_status napi_get_arraybuffer_info(napi_env env,
   return napi_ok;
 }
 
+// JavaScriptCore's embedding API has no way to detach an ArrayBuffer, but
+// ArrayBuffer.prototype.transfer does it where the engine is recent enough.
+napi_status napi_detach_arraybuffer(napi_env env, napi_value arraybuffer) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, arraybuffer);
+
+  napi_value transfer{};
+  napi_valuetype transfer_type{};
+  CHECK_NAPI(napi_get_named_property(env, arraybuffer, "transfer", &transfer));
+  CHECK_NAPI(napi_typeof(env, transfer, &transfer_type));
+  RETURN_STATUS_IF_FALSE(env, transfer_type == napi_function, napi_generic_failure);
+
+  napi_value length{}, result{};
+  CHECK_NAPI(napi_create_uint32(env, 0, &length));
+  CHECK_NAPI(napi_call_function(env, arraybuffer, transfer, 1, &length, &result));
+  return napi_ok;
+}
+
+napi_status napi_take_arraybuffer_contents(napi_env env,
+                                           napi_value arraybuffer,
+                                           void** data,
+                                           size_t* byte_length,
+                                           napi_arraybuffer_contents* contents) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, arraybuffer);
+  CHECK_ARG(env, data);
+  CHECK_ARG(env, byte_length);
+  CHECK_ARG(env, contents);
+
+  return napi_set_last_error(env, napi_generic_failure);
+}
+
+napi_status napi_release_arraybuffer_contents(napi_arraybuffer_contents) {
+  return napi_ok;
+}
+
+napi_status napi_create_arraybuffer_from_contents(napi_env env,
+                                                  napi_arraybuffer_contents contents,
+                                                  napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, contents);
+  CHECK_ARG(env, result);
+
+  return napi_set_last_error(env, napi_generic_failure);
+}
+
+// SharedArrayBuffer support
+// JavaScriptCore can't create SharedArrayBuffers over embedder memory (or read
+// the memory of one) through its embedding API, so the memory is exposed as an
+// external ArrayBuffer instead.
+napi_status napi_allocate_shared_memory(napi_env env, size_t byte_length, void** data) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, data);
+
+  *data = byte_length == 0 ? nullptr : std::calloc(1, byte_length);
+  RETURN_STATUS_IF_FALSE(env, *data != nullptr || byte_length == 0, napi_generic_failure);
+
+  return napi_ok;
+}
+
+napi_status napi_free_shared_memory(void* data, size_t) {
+  std::free(data);
+  return napi_ok;
+}
+
+napi_status napi_create_external_sharedarraybuffer(napi_env env,
+                                                   void* external_data,
+                                                   size_t byte_length,
+                                                   napi_finalize finalize_cb,
+                                                   void* finalize_hint,
+                                                   napi_value* result) {
+  return napi_create_external_arraybuffer(env, external_data, byte_length, finalize_cb, finalize_hint, result);
+}
+
+napi_status napi_is_sharedarraybuffer(napi_env env, napi_value value, bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  napi_value global{}, shared_array_buffer_ctor{};
+  napi_valuetype ctor_type{};
+  CHECK_NAPI(napi_get_global(env, &global));
+  CHECK_NAPI(napi_get_named_property(env, global, "SharedArrayBuffer", &shared_array_buffer_ctor));
+  CHECK_NAPI(napi_typeof(env, shared_array_buffer_ctor, &ctor_type));
+  if (ctor_type != napi_function) {
+    *result = false;
+    return napi_ok;
+  }
+
+  CHECK_NAPI(napi_instanceof(env, value, shared_array_buffer_ctor, result));
+  return napi_ok;
+}
+
+napi_status napi_get_sharedarraybuffer_info(napi_env env,
+                                            napi_value sharedarraybuffer,
+                                            void** data,
+                                            size_t* byte_length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, sharedarraybuffer);
+
+  bool is_arraybuffer{};
+  CHECK_NAPI(napi_is_arraybuffer(env, sharedarraybuffer, &is_arraybuffer));
+  RETURN_STATUS_IF_FALSE(env, is_arraybuffer, napi_generic_failure);
+
+  return napi_get_arraybuffer_info(env, sharedarraybuffer, data, byte_length);
+}
+
 napi_status napi_is_typedarray(napi_env env, napi_value value, bool* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, value);
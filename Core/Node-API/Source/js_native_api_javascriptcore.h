@@ -5,15 +5,33 @@
 #include <JavaScriptCore/JavaScript.h>
 #include <unordered_map>
 #include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include <thread>
 #include <cassert>
 
+// Interned property key. The name string is retained for the env's lifetime.
+struct napi_property_key__ {
+  JSStringRef name{};
+};
+
+// Template for same-shape objects: the interned keys, in definition order. The
+// C API cannot pre-build a structure, but a fixed order lets instances share
+// JSC's structure transitions.
+struct napi_object_template__ {
+  std::vector<napi_property_key> keys;
+};
+
 struct napi_env__ {
   JSGlobalContextRef context{};
   JSValueRef last_exception{};
   napi_extended_error_info last_error{nullptr, nullptr, 0, napi_ok};
   std::unordered_map<napi_value, std::uintptr_t> active_ref_values{};
   std::list<napi_ref> strong_refs{};
+  std::unordered_map<std::string, std::unique_ptr<napi_property_key__>> property_keys{};
+  std::map<std::vector<napi_property_key>, std::unique_ptr<napi_object_template__>> object_templates{};
 
   JSValueRef constructor_info_symbol{};
   JSValueRef function_info_symbol{};
@@ -33,6 +51,7 @@ struct napi_env__ {
 
   ~napi_env__() {
     deinit_refs();
+    deinit_property_keys();
     deinit_symbol(wrapper_info_symbol);
     deinit_symbol(reference_info_symbol);
     deinit_symbol(function_info_symbol);
@@ -54,6 +73,7 @@ struct napi_env__ {
   static inline std::unordered_map<JSGlobalContextRef, napi_env> napi_envs{};
 
   void deinit_refs();
+  void deinit_property_keys();
   void init_symbol(JSValueRef& symbol, const char* description);
   void deinit_symbol(JSValueRef symbol);
 };
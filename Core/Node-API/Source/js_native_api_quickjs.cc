@@ -1,4 +1,5 @@
 #include "js_native_api_quickjs.h"
+#include "unicode.h"
 #include <napi/js_native_api.h>
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -11,10 +12,12 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <cstring>
+#include <memory>
 #include <algorithm>
 
 namespace {
@@ -484,13 +487,24 @@ napi_status napi_create_string_latin1(napi_env env, const char* str, size_t leng
   CHECK_ENV(env);
   CHECK_ARG(env, result);
   
-  // QuickJS doesn't have native Latin-1 support, so we convert to UTF-8
-  // For now, just treat as UTF-8 (this may not be fully correct for high bytes)
   if (length == NAPI_AUTO_LENGTH) {
     length = strlen(str);
   }
-  
-  JSValue jsStr = JS_NewStringLen(env->context, str, length);
+
+  // QuickJS only accepts UTF-8 input. ASCII is passed through untouched;
+  // otherwise bytes above 0x7F are widened to their two-byte UTF-8 form, in a
+  // buffer sized for exactly that.
+  JSValue jsStr;
+  const size_t ascii = unicode::AsciiPrefixLength(str, length);
+  if (ascii == length) {
+    jsStr = JS_NewStringLen(env->context, str, length);
+  } else {
+    const size_t utf8Length = ascii + unicode::Latin1Utf8Length(str + ascii, length - ascii);
+    std::unique_ptr<char[]> utf8{new char[utf8Length]};
+    std::memcpy(utf8.get(), str, ascii);
+    unicode::Latin1ToUtf8(str + ascii, length - ascii, utf8.get() + ascii);
+    jsStr = JS_NewStringLen(env->context, utf8.get(), utf8Length);
+  }
   if (JS_IsException(jsStr)) {
     return napi_set_last_error(env, napi_generic_failure);
   }
@@ -505,46 +519,15 @@ napi_status napi_create_string_utf16(napi_env env, const char16_t* str, size_t l
   CHECK_ENV(env);
   CHECK_ARG(env, result);
   
-  // Convert UTF-16 to UTF-8 for QuickJS
   if (length == NAPI_AUTO_LENGTH) {
-    length = 0;
-    while (str[length] != 0) length++;
+    length = std::char_traits<char16_t>::length(str);
   }
   
-  // Simple UTF-16 to UTF-8 conversion
-  std::string utf8;
-  utf8.reserve(length * 3); // worst case
+  // QuickJS only accepts UTF-8 input.
+  std::unique_ptr<char[]> utf8{new char[length * 3]};
+  const size_t utf8Length = unicode::Utf16ToUtf8(str, length, utf8.get());
   
-  for (size_t i = 0; i < length; i++) {
-    uint32_t cp = str[i];
-    
-    // Handle surrogate pairs
-    if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < length) {
-      uint16_t low = str[i + 1];
-      if (low >= 0xDC00 && low <= 0xDFFF) {
-        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
-        i++;
-      }
-    }
-    
-    if (cp < 0x80) {
-      utf8.push_back(static_cast<char>(cp));
-    } else if (cp < 0x800) {
-      utf8.push_back(static_cast<char>(0xC0 | (cp >> 6)));
-      utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
-    } else if (cp < 0x10000) {
-      utf8.push_back(static_cast<char>(0xE0 | (cp >> 12)));
-      utf8.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
-      utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
-    } else {
-      utf8.push_back(static_cast<char>(0xF0 | (cp >> 18)));
-      utf8.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
-      utf8.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
-      utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
-    }
-  }
-  
-  JSValue jsStr = JS_NewStringLen(env->context, utf8.c_str(), utf8.length());
+  JSValue jsStr = JS_NewStringLen(env->context, utf8.get(), utf8Length);
   if (JS_IsException(jsStr)) {
     return napi_set_last_error(env, napi_generic_failure);
   }
@@ -554,6 +537,53 @@ napi_status napi_create_string_utf16(napi_env env, const char16_t* str, size_t l
   return napi_ok;
 }
 
+// QuickJS has no external string representation, so this is a plain copy:
+// the characters go through the regular string creation and the native
+// buffer is handed back to its finalizer straight away instead of being kept
+// alive alongside the copy.
+template <typename CharType, typename CreateAPI>
+static napi_status NewExternalString(napi_env env,
+                                     CharType* str,
+                                     size_t length,
+                                     napi_finalize finalize_callback,
+                                     void* finalize_hint,
+                                     napi_value* result,
+                                     bool* copied,
+                                     CreateAPI create_api) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env, str != nullptr || length == 0, napi_invalid_arg);
+
+  CHECK_NAPI(create_api(env, str, length, result));
+  if (copied != nullptr) {
+    *copied = true;
+  }
+  if (finalize_callback != nullptr) {
+    finalize_callback(env, str, finalize_hint);
+  }
+  return napi_ok;
+}
+
+napi_status node_api_create_external_string_latin1(napi_env env,
+                                                   char* str,
+                                                   size_t length,
+                                                   napi_finalize finalize_callback,
+                                                   void* finalize_hint,
+                                                   napi_value* result,
+                                                   bool* copied) {
+  return NewExternalString(env, str, length, finalize_callback, finalize_hint, result, copied, napi_create_string_latin1);
+}
+
+napi_status node_api_create_external_string_utf16(napi_env env,
+                                                  char16_t* str,
+                                                  size_t length,
+                                                  napi_finalize finalize_callback,
+                                                  void* finalize_hint,
+                                                  napi_value* result,
+                                                  bool* copied) {
+  return NewExternalString(env, str, length, finalize_callback, finalize_hint, result, copied, napi_create_string_utf16);
+}
+
 // Get value type
 napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype* result) {
   CHECK_ENV(env);
@@ -721,78 +751,113 @@ napi_status napi_get_value_string_utf8(napi_env env, napi_value value, char* buf
   return napi_ok;
 }
 
-// Get value string latin1
-napi_status napi_get_value_string_latin1(napi_env env, napi_value value, char* buf, size_t bufsize, size_t* result) {
-  // For simplicity, treat same as UTF-8
-  return napi_get_value_string_utf8(env, value, buf, bufsize, result);
+// Get value string utf8 view
+// JS_ToCStringLen hands out a pointer into the string itself for ASCII
+// strings (and a single conversion otherwise), so the view never needs `buf`.
+napi_status napi_get_value_string_utf8_view(napi_env env, napi_value value, char* /*buf*/, size_t /*bufsize*/, const char** result, size_t* length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, length);
+
+  JSValue jsValue = ToJSValue(value);
+  if (!JS_IsString(jsValue)) {
+    return napi_set_last_error(env, napi_string_expected);
+  }
+
+  *result = JS_ToCStringLen(env->context, length, jsValue);
+  if (*result == nullptr) {
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  napi_clear_last_error(env);
+  return napi_ok;
 }
 
-// Get value string UTF16
-napi_status napi_get_value_string_utf16(napi_env env, napi_value value, char16_t* buf, size_t bufsize, size_t* result) {
+napi_status napi_release_string_utf8_view(napi_env env, const char* data) {
+  CHECK_ENV(env);
+
+  if (data != nullptr) {
+    JS_FreeCString(env->context, data);
+  }
+
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+// Get value string latin1
+// The length and the copy are in UTF-16 code units, each narrowed to its low
+// byte, like V8.
+napi_status napi_get_value_string_latin1(napi_env env, napi_value value, char* buf, size_t bufsize, size_t* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, value);
 
   JSValue jsValue = ToJSValue(value);
-  
   if (!JS_IsString(jsValue)) {
     return napi_set_last_error(env, napi_string_expected);
   }
-  
+
   size_t len;
   const char* str = JS_ToCStringLen(env->context, &len, jsValue);
   if (!str) {
     return napi_set_last_error(env, napi_string_expected);
   }
 
-  // Convert UTF-8 to UTF-16
-  std::vector<char16_t> utf16;
-  utf16.reserve(len);
-  
-  for (size_t i = 0; i < len; ) {
-    uint32_t cp;
-    unsigned char c = str[i];
-    
-    if ((c & 0x80) == 0) {
-      cp = c;
-      i++;
-    } else if ((c & 0xE0) == 0xC0) {
-      cp = (c & 0x1F) << 6;
-      if (i + 1 < len) cp |= (str[i+1] & 0x3F);
-      i += 2;
-    } else if ((c & 0xF0) == 0xE0) {
-      cp = (c & 0x0F) << 12;
-      if (i + 1 < len) cp |= (str[i+1] & 0x3F) << 6;
-      if (i + 2 < len) cp |= (str[i+2] & 0x3F);
-      i += 3;
-    } else if ((c & 0xF8) == 0xF0) {
-      cp = (c & 0x07) << 18;
-      if (i + 1 < len) cp |= (str[i+1] & 0x3F) << 12;
-      if (i + 2 < len) cp |= (str[i+2] & 0x3F) << 6;
-      if (i + 3 < len) cp |= (str[i+3] & 0x3F);
-      i += 4;
-    } else {
-      cp = 0xFFFD; // replacement character
-      i++;
+  if (buf == nullptr) {
+    if (result != nullptr) {
+      *result = unicode::Utf8Utf16Length(str, len, true);
     }
-    
-    if (cp < 0x10000) {
-      utf16.push_back(static_cast<char16_t>(cp));
-    } else {
-      cp -= 0x10000;
-      utf16.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
-      utf16.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
+  } else if (bufsize > 0) {
+    const size_t count = unicode::Utf8ToLatin1(str, len, buf, bufsize - 1);
+    buf[count] = '\0';
+    if (result != nullptr) {
+      *result = count;
     }
+  } else if (result != nullptr) {
+    // buf != nullptr but bufsize == 0: no room for the null terminator.
+    *result = 0;
   }
 
   JS_FreeCString(env->context, str);
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+// Get value string UTF16
+napi_status napi_get_value_string_utf16(napi_env env, napi_value value, char16_t* buf, size_t bufsize, size_t* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+
+  JSValue jsValue = ToJSValue(value);
+  
+  if (!JS_IsString(jsValue)) {
+    return napi_set_last_error(env, napi_string_expected);
+  }
+  
+  size_t len;
+  const char* str = JS_ToCStringLen(env->context, &len, jsValue);
+  if (!str) {
+    return napi_set_last_error(env, napi_string_expected);
+  }
 
+  // JS_ToCStringLen encodes unpaired surrogates as-is, so they are decoded
+  // back the same way. A string never has more UTF-16 code units than UTF-8
+  // bytes, so a buffer that holds `len` units can be decoded into directly.
   if (buf == nullptr) {
     if (result != nullptr) {
-      *result = utf16.size();
+      *result = unicode::Utf8Utf16Length(str, len, true);
+    }
+  } else if (bufsize > len) {
+    const size_t count = unicode::Utf8ToUtf16(str, len, buf, true);
+    buf[count] = 0;
+    if (result != nullptr) {
+      *result = count;
     }
   } else if (bufsize > 0) {
-    size_t copy_len = std::min(utf16.size(), bufsize - 1);
-    memcpy(buf, utf16.data(), copy_len * sizeof(char16_t));
+    std::unique_ptr<char16_t[]> utf16{new char16_t[len]};
+    const size_t count = unicode::Utf8ToUtf16(str, len, utf16.get(), true);
+    const size_t copy_len = std::min(count, bufsize - 1);
+    memcpy(buf, utf16.get(), copy_len * sizeof(char16_t));
     buf[copy_len] = 0;
     if (result != nullptr) {
       *result = copy_len;
@@ -805,6 +870,8 @@ napi_status napi_get_value_string_utf16(napi_env env, napi_value value, char16_t
     *result = 0;
   }
 
+  JS_FreeCString(env->context, str);
+
   napi_clear_last_error(env);
   return napi_ok;
 }
@@ -1314,6 +1381,164 @@ napi_status napi_has_named_property(napi_env env, napi_value object, const char*
   return napi_ok;
 }
 
+napi_status napi_create_property_key_utf8(napi_env env, const char* utf8name, size_t length, napi_property_key* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, utf8name);
+  CHECK_ARG(env, result);
+
+  std::string name = (length == NAPI_AUTO_LENGTH) ? std::string{utf8name} : std::string{utf8name, length};
+  auto it = env->property_keys.find(name);
+  if (it == env->property_keys.end()) {
+    JSAtom atom = JS_NewAtomLen(env->context, name.data(), name.size());
+    if (atom == JS_ATOM_NULL) {
+      return napi_set_last_error(env, napi_generic_failure);
+    }
+
+    it = env->property_keys.emplace(std::move(name), std::make_unique<napi_property_key__>(napi_property_key__{atom})).first;
+  }
+
+  *result = it->second.get();
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_get_property_key_value(napi_env env, napi_property_key key, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  JSValue jsName = JS_AtomToString(env->context, key->atom);
+  if (JS_IsException(jsName)) {
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = FromJSValue(env, jsName);
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_get_keyed_property(napi_env env, napi_value object, napi_property_key key, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  JSValue jsResult = JS_GetProperty(env->context, ToJSValue(object), key->atom);
+  if (JS_IsException(jsResult)) {
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = FromJSValue(env, jsResult);
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_set_keyed_property(napi_env env, napi_value object, napi_property_key key, napi_value value) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, value);
+
+  if (JS_SetProperty(env->context, ToJSValue(object), key->atom, JS_DupValue(env->context, ToJSValue(value))) < 0) {
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_has_keyed_property(napi_env env, napi_value object, napi_property_key key, bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  int has = JS_HasProperty(env->context, ToJSValue(object), key->atom);
+  if (has < 0) {
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = (has != 0);
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_define_own_properties_batch(napi_env env, napi_value object, size_t count, const napi_property_key* keys, const napi_value* values) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, values);
+  }
+
+  JSValue jsObject = ToJSValue(object);
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_ARG(env, keys[i]);
+    JSValue jsValue = JS_DupValue(env->context, ToJSValue(values[i]));
+    if (JS_DefinePropertyValue(env->context, jsObject, keys[i]->atom, jsValue, JS_PROP_C_W_E | JS_PROP_THROW) < 0) {
+      return napi_set_last_error(env, napi_generic_failure);
+    }
+  }
+
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_get_properties_batch(napi_env env, napi_value object, size_t count, const napi_property_key* keys, napi_value* results) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, results);
+  }
+
+  JSValue jsObject = ToJSValue(object);
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_ARG(env, keys[i]);
+    JSValue jsResult = JS_GetProperty(env->context, jsObject, keys[i]->atom);
+    if (JS_IsException(jsResult)) {
+      return napi_set_last_error(env, napi_generic_failure);
+    }
+    results[i] = FromJSValue(env, jsResult);
+  }
+
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_create_object_template(napi_env env, size_t count, const napi_property_key* keys, napi_object_template* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+  }
+
+  std::vector<napi_property_key> key_list(keys, keys + count);
+  auto it = env->object_templates.find(key_list);
+  if (it == env->object_templates.end()) {
+    auto object_template = std::make_unique<napi_object_template__>();
+    object_template->keys = key_list;
+    it = env->object_templates.emplace(std::move(key_list), std::move(object_template)).first;
+  }
+
+  *result = it->second.get();
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_new_instance_from_template(napi_env env, napi_object_template object_template, const napi_value* values, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, object_template);
+  CHECK_ARG(env, result);
+
+  napi_value object;
+  CHECK_NAPI(napi_create_object(env, &object));
+  CHECK_NAPI(napi_define_own_properties_batch(env, object, object_template->keys.size(), object_template->keys.data(), values));
+
+  *result = object;
+  return napi_ok;
+}
+
 napi_status napi_get_element(napi_env env, napi_value object, uint32_t index, napi_value* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, object);
@@ -2077,6 +2302,93 @@ napi_status napi_get_arraybuffer_info(napi_env env, napi_value arraybuffer, void
   return napi_ok;
 }
 
+// SharedArrayBuffer support
+napi_status napi_allocate_shared_memory(napi_env env, size_t byte_length, void** data) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, data);
+
+  // Not the runtime's allocator, since the memory outlives the runtime.
+  *data = byte_length == 0 ? nullptr : std::calloc(1, byte_length);
+  RETURN_STATUS_IF_FALSE(env, *data != nullptr || byte_length == 0, napi_generic_failure);
+
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_free_shared_memory(void* data, size_t) {
+  std::free(data);
+  return napi_ok;
+}
+
+napi_status napi_create_external_sharedarraybuffer(napi_env env, void* external_data, size_t byte_length, napi_finalize finalize_cb, void* finalize_hint, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+
+  ExternalData* externalDataInfo = new ExternalData(env, external_data, finalize_cb, finalize_hint);
+
+  // Atomics.wait waiters are kept in a process-wide list keyed by address, so
+  // views in other runtimes over the same memory wake each other up.
+  JSValue sharedArrayBuffer = JS_NewArrayBuffer(env->context,
+                                                reinterpret_cast<uint8_t*>(external_data),
+                                                byte_length,
+                                                ArrayBufferFreeCallback,
+                                                externalDataInfo,
+                                                1);
+
+  if (JS_IsException(sharedArrayBuffer)) {
+    delete externalDataInfo;
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = FromJSValue(env, sharedArrayBuffer);
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_is_sharedarraybuffer(napi_env env, napi_value value, bool* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  // QuickJS doesn't have a direct way to check SharedArrayBuffer, so use instanceof
+  JSValue jsValue = ToJSValue(value);
+  JSValue global = JS_GetGlobalObject(env->context);
+  JSValue sharedArrayBufferCtor = JS_GetPropertyStr(env->context, global, "SharedArrayBuffer");
+
+  int ret = JS_IsObject(sharedArrayBufferCtor) ? JS_IsInstanceOf(env->context, jsValue, sharedArrayBufferCtor) : 0;
+  *result = (ret > 0);
+
+  JS_FreeValue(env->context, sharedArrayBufferCtor);
+  JS_FreeValue(env->context, global);
+
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
+napi_status napi_get_sharedarraybuffer_info(napi_env env, napi_value sharedarraybuffer, void** data, size_t* byte_length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, sharedarraybuffer);
+
+  bool isSharedArrayBuffer = false;
+  napi_is_sharedarraybuffer(env, sharedarraybuffer, &isSharedArrayBuffer);
+  RETURN_STATUS_IF_FALSE(env, isSharedArrayBuffer, napi_invalid_arg);
+
+  // JS_GetArrayBuffer accepts SharedArrayBuffers too.
+  size_t size;
+  uint8_t* bufferData = JS_GetArrayBuffer(env->context, &size, ToJSValue(sharedarraybuffer));
+
+  if (data != nullptr) {
+    *data = bufferData;
+  }
+
+  if (byte_length != nullptr) {
+    *byte_length = size;
+  }
+
+  napi_clear_last_error(env);
+  return napi_ok;
+}
+
 // TypedArray support
 napi_status napi_is_typedarray(napi_env env, napi_value value, bool* result) {
   CHECK_ENV(env);
@@ -2856,6 +3168,30 @@ napi_status napi_is_detached_arraybuffer(napi_env env, napi_value value, bool* r
   return napi_ok;
 }
 
+// QuickJS frees the memory of a buffer as it detaches it, so it can't be
+// handed over.
+napi_status napi_take_arraybuffer_contents(napi_env env, napi_value arraybuffer, void** data, size_t* byte_length, napi_arraybuffer_contents* contents) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, arraybuffer);
+  CHECK_ARG(env, data);
+  CHECK_ARG(env, byte_length);
+  CHECK_ARG(env, contents);
+
+  return napi_set_last_error(env, napi_generic_failure);
+}
+
+napi_status napi_release_arraybuffer_contents(napi_arraybuffer_contents) {
+  return napi_ok;
+}
+
+napi_status napi_create_arraybuffer_from_contents(napi_env env, napi_arraybuffer_contents contents, napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, contents);
+  CHECK_ARG(env, result);
+
+  return napi_set_last_error(env, napi_generic_failure);
+}
+
 // Exception handling
 napi_status napi_is_exception_pending(napi_env env, bool* result) {
   CHECK_ENV(env);
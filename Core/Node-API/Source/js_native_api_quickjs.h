@@ -11,7 +11,10 @@
 #include <napi/js_native_api_types.h>
 #include <thread>
 #include <cassert>
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 // Reference info for preventing GC. Defined in the header so that both
@@ -21,6 +24,19 @@ struct RefInfo {
   uint32_t count;
 };
 
+// Interned property key. Holds a strong atom reference that is released in
+// Detach, before the context is torn down.
+struct napi_property_key__ {
+  JSAtom atom;
+};
+
+// Template for same-shape objects: the interned keys, in definition order.
+// QuickJS shares shapes between objects whose properties are added in the same
+// order, so fixing the order (and the atoms) is all a template needs to do.
+struct napi_object_template__ {
+  std::vector<napi_property_key> keys;
+};
+
 struct napi_env__ {
   JSContext* context = nullptr;
   JSContext* current_context = nullptr;
@@ -41,6 +57,12 @@ struct napi_env__ {
   // JS_FreeRuntime.
   std::vector<void*> refs_list;
 
+  // Property keys created by napi_create_property_key_utf8, by name.
+  std::unordered_map<std::string, std::unique_ptr<napi_property_key__>> property_keys;
+
+  // Templates created by napi_create_object_template, by key list.
+  std::map<std::vector<napi_property_key>, std::unique_ptr<napi_object_template__>> object_templates;
+
   // Set to true once Detach has run. Subsequent napi_delete_reference
   // calls (from native destructors running during the JS teardown
   // cascade) must not touch the context or the (already emptied)
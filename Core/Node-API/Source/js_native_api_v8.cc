@@ -1284,6 +1284,232 @@ napi_status NAPI_CDECL napi_get_named_property(napi_env env,
   return GET_RETURN_STATUS(env);
 }
 
+napi_status NAPI_CDECL napi_create_property_key_utf8(napi_env env,
+                                                     const char* utf8name,
+                                                     size_t length,
+                                                     napi_property_key* result) {
+  CHECK_ENV_NOT_IN_GC(env);
+  CHECK_ARG(env, utf8name);
+  CHECK_ARG(env, result);
+
+  std::string name = (length == NAPI_AUTO_LENGTH)
+                         ? std::string{utf8name}
+                         : std::string{utf8name, length};
+  auto it = env->property_keys.find(name);
+  if (it == env->property_keys.end()) {
+    v8::Local<v8::String> key;
+    CHECK_NEW_FROM_UTF8_LEN(env, key, name.data(), name.size());
+
+    auto entry = std::make_unique<napi_property_key__>();
+    entry->name.Reset(env->isolate, key);
+    it = env->property_keys.emplace(std::move(name), std::move(entry)).first;
+  }
+
+  *result = it->second.get();
+  return napi_clear_last_error(env);
+}
+
+napi_status NAPI_CDECL napi_get_property_key_value(napi_env env,
+                                                   napi_property_key key,
+                                                   napi_value* result) {
+  CHECK_ENV_NOT_IN_GC(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  *result = v8impl::JsValueFromV8LocalValue(key->name.Get(env->isolate));
+  return napi_clear_last_error(env);
+}
+
+napi_status NAPI_CDECL napi_set_keyed_property(napi_env env,
+                                               napi_value object,
+                                               napi_property_key key,
+                                               napi_value value) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, value);
+
+  v8::Local<v8::Context> context = env->context();
+  v8::Local<v8::Object> obj;
+
+  CHECK_TO_OBJECT(env, context, obj, object);
+
+  v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
+
+  v8::Maybe<bool> set_maybe =
+      obj->Set(context, key->name.Get(env->isolate), val);
+
+  RETURN_STATUS_IF_FALSE_WITH_PREAMBLE(
+      env, set_maybe.FromMaybe(false), napi_generic_failure);
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status NAPI_CDECL napi_has_keyed_property(napi_env env,
+                                               napi_value object,
+                                               napi_property_key key,
+                                               bool* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  v8::Local<v8::Context> context = env->context();
+  v8::Local<v8::Object> obj;
+
+  CHECK_TO_OBJECT(env, context, obj, object);
+
+  v8::Maybe<bool> has_maybe = obj->Has(context, key->name.Get(env->isolate));
+
+  CHECK_MAYBE_NOTHING_WITH_PREAMBLE(env, has_maybe, napi_generic_failure);
+
+  *result = has_maybe.FromMaybe(false);
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status NAPI_CDECL napi_get_keyed_property(napi_env env,
+                                               napi_value object,
+                                               napi_property_key key,
+                                               napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, key);
+  CHECK_ARG(env, result);
+
+  v8::Local<v8::Context> context = env->context();
+  v8::Local<v8::Object> obj;
+
+  CHECK_TO_OBJECT(env, context, obj, object);
+
+  auto get_maybe = obj->Get(context, key->name.Get(env->isolate));
+
+  CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, get_maybe, napi_generic_failure);
+
+  v8::Local<v8::Value> val = get_maybe.ToLocalChecked();
+  *result = v8impl::JsValueFromV8LocalValue(val);
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status NAPI_CDECL
+napi_define_own_properties_batch(napi_env env,
+                                 napi_value object,
+                                 size_t count,
+                                 const napi_property_key* keys,
+                                 const napi_value* values) {
+  NAPI_PREAMBLE(env);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, values);
+  }
+
+  v8::Local<v8::Context> context = env->context();
+  v8::Local<v8::Object> obj;
+
+  CHECK_TO_OBJECT(env, context, obj, object);
+
+  for (size_t i = 0; i < count; i++) {
+    CHECK_ARG(env, keys[i]);
+    v8::Maybe<bool> define_maybe = obj->CreateDataProperty(
+        context,
+        keys[i]->name.Get(env->isolate),
+        v8impl::V8LocalValueFromJsValue(values[i]));
+
+    RETURN_STATUS_IF_FALSE_WITH_PREAMBLE(
+        env, define_maybe.FromMaybe(false), napi_generic_failure);
+  }
+
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status NAPI_CDECL napi_get_properties_batch(napi_env env,
+                                                 napi_value object,
+                                                 size_t count,
+                                                 const napi_property_key* keys,
+                                                 napi_value* results) {
+  NAPI_PREAMBLE(env);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, results);
+  }
+
+  v8::Local<v8::Context> context = env->context();
+  v8::Local<v8::Object> obj;
+
+  CHECK_TO_OBJECT(env, context, obj, object);
+
+  for (size_t i = 0; i < count; i++) {
+    CHECK_ARG(env, keys[i]);
+    auto get_maybe = obj->Get(context, keys[i]->name.Get(env->isolate));
+
+    CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, get_maybe, napi_generic_failure);
+
+    results[i] = v8impl::JsValueFromV8LocalValue(get_maybe.ToLocalChecked());
+  }
+
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status NAPI_CDECL
+napi_create_object_template(napi_env env,
+                            size_t count,
+                            const napi_property_key* keys,
+                            napi_object_template* result) {
+  CHECK_ENV_NOT_IN_GC(env);
+  CHECK_ARG(env, result);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+  }
+
+  std::vector<napi_property_key> key_list(keys, keys + count);
+  auto it = env->object_templates.find(key_list);
+  if (it == env->object_templates.end()) {
+    v8::HandleScope scope(env->isolate);
+    v8::Local<v8::ObjectTemplate> tpl = v8::ObjectTemplate::New(env->isolate);
+    for (napi_property_key key : key_list) {
+      RETURN_STATUS_IF_FALSE(env, key != nullptr, napi_invalid_arg);
+      tpl->Set(key->name.Get(env->isolate), v8::Undefined(env->isolate));
+    }
+
+    auto object_template = std::make_unique<napi_object_template__>();
+    object_template->keys = key_list;
+    object_template->object_template.Reset(env->isolate, tpl);
+    it = env->object_templates
+             .emplace(std::move(key_list), std::move(object_template))
+             .first;
+  }
+
+  *result = it->second.get();
+  return napi_clear_last_error(env);
+}
+
+napi_status NAPI_CDECL
+napi_new_instance_from_template(napi_env env,
+                                napi_object_template object_template,
+                                const napi_value* values,
+                                napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, object_template);
+  CHECK_ARG(env, result);
+  if (!object_template->keys.empty()) {
+    CHECK_ARG(env, values);
+  }
+
+  v8::Local<v8::Context> context = env->context();
+  auto instance_maybe =
+      object_template->object_template.Get(env->isolate)->NewInstance(context);
+  CHECK_MAYBE_EMPTY_WITH_PREAMBLE(env, instance_maybe, napi_generic_failure);
+
+  v8::Local<v8::Object> obj = instance_maybe.ToLocalChecked();
+  for (size_t i = 0; i < object_template->keys.size(); i++) {
+    v8::Maybe<bool> set_maybe =
+        obj->Set(context,
+                 object_template->keys[i]->name.Get(env->isolate),
+                 v8impl::V8LocalValueFromJsValue(values[i]));
+
+    RETURN_STATUS_IF_FALSE_WITH_PREAMBLE(
+        env, set_maybe.FromMaybe(false), napi_generic_failure);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(obj);
+  return GET_RETURN_STATUS(env);
+}
+
 napi_status NAPI_CDECL napi_set_element(napi_env env,
                                         napi_value object,
                                         uint32_t index,
@@ -2422,6 +2648,61 @@ napi_status NAPI_CDECL napi_get_value_string_utf8(
   return napi_clear_last_error(env);
 }
 
+// [BABYLON-NATIVE-ADDITION]
+napi_status NAPI_CDECL napi_get_value_string_utf8_view(napi_env env,
+                                                       napi_value value,
+                                                       char* buf,
+                                                       size_t bufsize,
+                                                       const char** result,
+                                                       size_t* length) {
+  CHECK_ENV_NOT_IN_GC(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, length);
+
+  v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
+  RETURN_STATUS_IF_FALSE(env, val->IsString(), napi_string_expected);
+  v8::Local<v8::String> str = val.As<v8::String>();
+
+  // An external one-byte string that is pure ASCII is already valid UTF-8, so
+  // the view points straight at the embedder's buffer.
+  if (str->IsExternalOneByte()) {
+    const v8::String::ExternalOneByteStringResource* resource =
+        str->GetExternalOneByteStringResource();
+    const char* data = resource->data();
+    const size_t size = resource->length();
+    if (std::all_of(data, data + size, [](char c) {
+          return static_cast<unsigned char>(c) < 0x80;
+        })) {
+      *result = data;
+      *length = size;
+      return napi_clear_last_error(env);
+    }
+  }
+
+  *length = str->Utf8Length(env->isolate);
+  if (buf == nullptr || *length >= bufsize) {
+    *result = nullptr;
+    return napi_clear_last_error(env);
+  }
+
+  str->WriteUtf8(env->isolate,
+                 buf,
+                 static_cast<int>(*length),
+                 nullptr,
+                 v8::String::REPLACE_INVALID_UTF8 |
+                     v8::String::NO_NULL_TERMINATION);
+  *result = buf;
+  return napi_clear_last_error(env);
+}
+
+// [BABYLON-NATIVE-ADDITION]
+napi_status NAPI_CDECL napi_release_string_utf8_view(napi_env env,
+                                                     const char* /*data*/) {
+  CHECK_ENV(env);
+  return napi_clear_last_error(env);
+}
+
 // Copies a JavaScript string into a UTF-16 string buffer. The result is the
 // number of 2-byte code units (excluding the null terminator) copied into buf.
 // A sufficient buffer size should be greater than the length of string,
@@ -3023,6 +3304,107 @@ napi_status NAPI_CDECL napi_get_arraybuffer_info(napi_env env,
   return napi_clear_last_error(env);
 }
 
+namespace {
+// Shared memory outlives the isolate that allocated it, so it can't come from
+// an isolate's ArrayBuffer allocator. V8's default allocator places it inside
+// the sandbox when that is enabled, as SharedArrayBuffers require.
+v8::ArrayBuffer::Allocator& SharedMemoryAllocator() {
+  // Never deleted: memory may still be freed while the process exits.
+  static v8::ArrayBuffer::Allocator* allocator =
+      v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+  return *allocator;
+}
+}  // end of anonymous namespace
+
+napi_status NAPI_CDECL napi_allocate_shared_memory(napi_env env,
+                                                   size_t byte_length,
+                                                   void** data) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, data);
+
+  *data = SharedMemoryAllocator().Allocate(byte_length);
+  RETURN_STATUS_IF_FALSE(env, *data != nullptr || byte_length == 0, napi_generic_failure);
+
+  return napi_clear_last_error(env);
+}
+
+napi_status NAPI_CDECL napi_free_shared_memory(void* data,
+                                               size_t byte_length) {
+  SharedMemoryAllocator().Free(data, byte_length);
+  return napi_ok;
+}
+
+napi_status NAPI_CDECL
+napi_create_external_sharedarraybuffer(napi_env env,
+                                       void* external_data,
+                                       size_t byte_length,
+                                       napi_finalize finalize_cb,
+                                       void* finalize_hint,
+                                       napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, result);
+
+  // Each view gets a backing store of its own over the same memory. V8 keys
+  // Atomics.wait waiters by address, so they still wake each other up.
+  struct FinalizeData {
+    napi_env env;
+    napi_finalize finalize_cb;
+    void* finalize_hint;
+
+    static void Finalize(void* data, size_t, void* deleter_data) {
+      auto finalize_data = reinterpret_cast<FinalizeData*>(deleter_data);
+
+      if (finalize_data->finalize_cb != nullptr) {
+        finalize_data->finalize_cb(finalize_data->env, data, finalize_data->finalize_hint);
+      }
+
+      delete finalize_data;
+    }
+  };
+
+  auto buffer = v8::SharedArrayBuffer::New(
+      env->isolate,
+      v8::SharedArrayBuffer::NewBackingStore(external_data, byte_length, FinalizeData::Finalize, new FinalizeData{env, finalize_cb, finalize_hint}));
+
+  *result = v8impl::JsValueFromV8LocalValue(buffer);
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status NAPI_CDECL napi_is_sharedarraybuffer(napi_env env,
+                                                 napi_value value,
+                                                 bool* result) {
+  CHECK_ENV_NOT_IN_GC(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+
+  *result = v8impl::V8LocalValueFromJsValue(value)->IsSharedArrayBuffer();
+
+  return napi_clear_last_error(env);
+}
+
+napi_status NAPI_CDECL napi_get_sharedarraybuffer_info(napi_env env,
+                                                       napi_value sharedarraybuffer,
+                                                       void** data,
+                                                       size_t* byte_length) {
+  CHECK_ENV_NOT_IN_GC(env);
+  CHECK_ARG(env, sharedarraybuffer);
+
+  v8::Local<v8::Value> value = v8impl::V8LocalValueFromJsValue(sharedarraybuffer);
+  RETURN_STATUS_IF_FALSE(env, value->IsSharedArrayBuffer(), napi_invalid_arg);
+
+  v8::Local<v8::SharedArrayBuffer> buffer = value.As<v8::SharedArrayBuffer>();
+
+  if (data != nullptr) {
+    *data = buffer->GetBackingStore()->Data();
+  }
+
+  if (byte_length != nullptr) {
+    *byte_length = buffer->ByteLength();
+  }
+
+  return napi_clear_last_error(env);
+}
+
 napi_status NAPI_CDECL napi_is_typedarray(napi_env env,
                                           napi_value value,
                                           bool* result) {
@@ -3489,7 +3871,8 @@ napi_status NAPI_CDECL napi_detach_arraybuffer(napi_env env,
   RETURN_STATUS_IF_FALSE(
       env, it->IsDetachable(), napi_detachable_arraybuffer_expected);
 
-  it->Detach();
+  RETURN_STATUS_IF_FALSE(
+      env, it->Detach(v8::Local<v8::Value>()).IsJust(), napi_generic_failure);
 
   return napi_clear_last_error(env);
 }
@@ -3508,3 +3891,60 @@ napi_status NAPI_CDECL napi_is_detached_arraybuffer(napi_env env,
   *result = true;
   return napi_clear_last_error(env);
 }
+
+// [BABYLON-NATIVE-ADDITION]
+napi_status NAPI_CDECL napi_take_arraybuffer_contents(napi_env env,
+                                                      napi_value arraybuffer,
+                                                      void** data,
+                                                      size_t* byte_length,
+                                                      napi_arraybuffer_contents* contents) {
+  CHECK_ENV_NOT_IN_GC(env);
+  CHECK_ARG(env, arraybuffer);
+  CHECK_ARG(env, data);
+  CHECK_ARG(env, byte_length);
+  CHECK_ARG(env, contents);
+
+  v8::Local<v8::Value> value = v8impl::V8LocalValueFromJsValue(arraybuffer);
+  RETURN_STATUS_IF_FALSE(
+      env, value->IsArrayBuffer(), napi_arraybuffer_expected);
+
+  v8::Local<v8::ArrayBuffer> it = value.As<v8::ArrayBuffer>();
+  RETURN_STATUS_IF_FALSE(
+      env, it->IsDetachable(), napi_detachable_arraybuffer_expected);
+
+  // The backing store outlives the buffer once detached, for as long as a
+  // reference to it is held.
+  auto store = std::make_unique<std::shared_ptr<v8::BackingStore>>(it->GetBackingStore());
+  RETURN_STATUS_IF_FALSE(
+      env, it->Detach(v8::Local<v8::Value>()).IsJust(), napi_generic_failure);
+
+  *data = (*store)->Data();
+  *byte_length = (*store)->ByteLength();
+  *contents = reinterpret_cast<napi_arraybuffer_contents>(store.release());
+  return napi_clear_last_error(env);
+}
+
+// [BABYLON-NATIVE-ADDITION]
+napi_status NAPI_CDECL napi_release_arraybuffer_contents(napi_arraybuffer_contents contents) {
+  delete reinterpret_cast<std::shared_ptr<v8::BackingStore>*>(contents);
+  return napi_ok;
+}
+
+// [BABYLON-NATIVE-ADDITION]
+napi_status NAPI_CDECL napi_create_arraybuffer_from_contents(napi_env env,
+                                                             napi_arraybuffer_contents contents,
+                                                             napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, contents);
+  CHECK_ARG(env, result);
+
+  // Wraps the backing store itself, which stays inside the sandbox, so unlike
+  // an external buffer nothing is copied.
+  std::unique_ptr<std::shared_ptr<v8::BackingStore>> store{
+      reinterpret_cast<std::shared_ptr<v8::BackingStore>*>(contents)};
+  v8::Local<v8::ArrayBuffer> buffer =
+      v8::ArrayBuffer::New(env->isolate, std::move(*store));
+
+  *result = v8impl::JsValueFromV8LocalValue(buffer);
+  return GET_RETURN_STATUS(env);
+}
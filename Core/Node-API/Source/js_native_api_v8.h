@@ -2,9 +2,13 @@
 #define SRC_JS_NATIVE_API_V8_H_
 
 
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <napi/js_native_api_types.h>
 #include "js_native_api_v8_internals.h"
@@ -95,6 +99,19 @@ class RefTracker {
 class Finalizer;
 }  // end of namespace v8impl
 
+// Interned property key. The v8::Global is reset when the env is deleted.
+struct napi_property_key__ {
+  v8::Global<v8::String> name;
+};
+
+// Template for same-shape objects. Instances of one v8::ObjectTemplate start
+// from a shared map that already holds every property, so filling in the
+// values never triggers a map transition.
+struct napi_object_template__ {
+  std::vector<napi_property_key> keys;
+  v8::Global<v8::ObjectTemplate> object_template;
+};
+
 struct napi_env__ {
   explicit napi_env__(v8::Local<v8::Context> context,
                       int32_t module_api_version)
@@ -203,6 +220,13 @@ struct napi_env__ {
   v8impl::RefTracker::RefList finalizing_reflist;
   // The invocation order of the finalizers is not determined.
   std::unordered_set<v8impl::RefTracker*> pending_finalizers;
+  // Property keys created by napi_create_property_key_utf8, by name.
+  std::unordered_map<std::string, std::unique_ptr<napi_property_key__>>
+      property_keys;
+  // Templates created by napi_create_object_template, by key list.
+  std::map<std::vector<napi_property_key>,
+           std::unique_ptr<napi_object_template__>>
+      object_templates;
   napi_extended_error_info last_error;
   int open_handle_scopes = 0;
   int open_callback_scopes = 0;
@@ -0,0 +1,440 @@
+#pragma once
+
+// UTF-8 / UTF-16 / Latin-1 transcoding shared by the backends that convert
+// strings themselves (QuickJS, JavaScriptCore).
+//
+// Text crossing the boundary is overwhelmingly ASCII, so every conversion is
+// built around finding and copying ASCII runs a vector at a time (AVX2 when
+// the build enables it, otherwise SSE2 on x86/x64 and NEON on ARM64, with a
+// word-at-a-time scalar fallback). Non-ASCII code points are handled one at a
+// time by the scalar encoder/decoder between runs.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NAPI_UNICODE_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NAPI_UNICODE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NAPI_UNICODE_NEON
+#endif
+
+namespace unicode {
+  // Number of leading bytes below 0x80.
+  inline size_t AsciiPrefixLength(const char* data, size_t length) {
+    size_t i = 0;
+
+#if defined(NAPI_UNICODE_AVX2)
+    for (; i + 32 <= length; i += 32) {
+      const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+      if (_mm256_movemask_epi8(block) != 0) {
+        break;
+      }
+    }
+#endif
+
+#if defined(NAPI_UNICODE_SSE2)
+    for (; i + 16 <= length; i += 16) {
+      const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      if (_mm_movemask_epi8(block) != 0) {
+        break;
+      }
+    }
+#elif defined(NAPI_UNICODE_NEON)
+    for (; i + 16 <= length; i += 16) {
+      const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+      if (vmaxvq_u8(block) >= 0x80) {
+        break;
+      }
+    }
+#else
+    for (; i + 8 <= length; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, data + i, sizeof(word));
+      if ((word & 0x8080808080808080ull) != 0) {
+        break;
+      }
+    }
+#endif
+
+    // The vector loops stop at the first block holding a non-ASCII byte; the
+    // exact position is found here.
+    for (; i < length; ++i) {
+      if (static_cast<unsigned char>(data[i]) >= 0x80) {
+        break;
+      }
+    }
+    return i;
+  }
+
+  // Number of leading UTF-16 code units below 0x80.
+  inline size_t AsciiPrefixLength(const char16_t* data, size_t length) {
+    size_t i = 0;
+
+#if defined(NAPI_UNICODE_AVX2)
+    const __m256i highMask256 = _mm256_set1_epi16(static_cast<short>(0xFF80));
+    for (; i + 16 <= length; i += 16) {
+      const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+      if (!_mm256_testz_si256(block, highMask256)) {
+        break;
+      }
+    }
+#endif
+
+#if defined(NAPI_UNICODE_SSE2)
+    const __m128i highMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for (; i + 8 <= length; i += 8) {
+      const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      const __m128i high = _mm_cmpeq_epi16(_mm_and_si128(block, highMask), _mm_setzero_si128());
+      if (_mm_movemask_epi8(high) != 0xFFFF) {
+        break;
+      }
+    }
+#elif defined(NAPI_UNICODE_NEON)
+    for (; i + 8 <= length; i += 8) {
+      const uint16x8_t block = vld1q_u16(reinterpret_cast<const uint16_t*>(data + i));
+      if (vmaxvq_u16(block) >= 0x80) {
+        break;
+      }
+    }
+#else
+    for (; i + 4 <= length; i += 4) {
+      uint64_t word;
+      std::memcpy(&word, data + i, sizeof(word));
+      if ((word & 0xFF80FF80FF80FF80ull) != 0) {
+        break;
+      }
+    }
+#endif
+
+    for (; i < length; ++i) {
+      if (data[i] >= 0x80) {
+        break;
+      }
+    }
+    return i;
+  }
+
+  // Zero-extends `length` bytes into UTF-16 code units. This is exact for
+  // ASCII and for Latin-1, whose code points are the byte values.
+  inline void Widen(const char* src, size_t length, char16_t* dst) {
+    size_t i = 0;
+
+#if defined(NAPI_UNICODE_AVX2)
+    for (; i + 16 <= length; i += 16) {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu8_epi16(bytes));
+    }
+#elif defined(NAPI_UNICODE_SSE2)
+    for (; i + 16 <= length; i += 16) {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(bytes, _mm_setzero_si128()));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(bytes, _mm_setzero_si128()));
+    }
+#elif defined(NAPI_UNICODE_NEON)
+    for (; i + 16 <= length; i += 16) {
+      const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+      vst1q_u16(reinterpret_cast<uint16_t*>(dst + i), vmovl_u8(vget_low_u8(bytes)));
+      vst1q_u16(reinterpret_cast<uint16_t*>(dst + i + 8), vmovl_high_u8(bytes));
+    }
+#endif
+
+    for (; i < length; ++i) {
+      dst[i] = static_cast<unsigned char>(src[i]);
+    }
+  }
+
+  // Narrows `length` UTF-16 code units that are all below 0x80 to bytes.
+  inline void NarrowAscii(const char16_t* src, size_t length, char* dst) {
+    size_t i = 0;
+
+#if defined(NAPI_UNICODE_SSE2)
+    for (; i + 16 <= length; i += 16) {
+      const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(low, high));
+    }
+#elif defined(NAPI_UNICODE_NEON)
+    for (; i + 16 <= length; i += 16) {
+      const uint16x8_t low = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+      const uint16x8_t high = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i + 8));
+      vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+    }
+#endif
+
+    for (; i < length; ++i) {
+      dst[i] = static_cast<char>(src[i]);
+    }
+  }
+
+  // Writes the UTF-8 encoding of `cp` and returns the number of bytes written.
+  // Unpaired surrogates are encoded as-is (3 bytes), like the engines do.
+  inline size_t EncodeUtf8(uint32_t cp, char* dst) {
+    if (cp < 0x80) {
+      dst[0] = static_cast<char>(cp);
+      return 1;
+    }
+    if (cp < 0x800) {
+      dst[0] = static_cast<char>(0xC0 | (cp >> 6));
+      dst[1] = static_cast<char>(0x80 | (cp & 0x3F));
+      return 2;
+    }
+    if (cp < 0x10000) {
+      dst[0] = static_cast<char>(0xE0 | (cp >> 12));
+      dst[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      dst[2] = static_cast<char>(0x80 | (cp & 0x3F));
+      return 3;
+    }
+    dst[0] = static_cast<char>(0xF0 | (cp >> 18));
+    dst[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    dst[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+  }
+
+  // Number of bytes Utf16ToUtf8 writes for `length` UTF-16 code units, at most
+  // 3 * `length`.
+  inline size_t Utf16Utf8Length(const char16_t* src, size_t length) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+      const size_t ascii = AsciiPrefixLength(src + in, length - in);
+      in += ascii;
+      out += ascii;
+      if (in == length) {
+        break;
+      }
+
+      const char16_t unit = src[in++];
+      if (unit < 0x800) {
+        out += 2;
+      } else if (unit >= 0xD800 && unit <= 0xDBFF && in < length && src[in] >= 0xDC00 && src[in] <= 0xDFFF) {
+        ++in;
+        out += 4;
+      } else {
+        out += 3;
+      }
+    }
+    return out;
+  }
+
+  // Converts UTF-16 to UTF-8 and returns the number of bytes written. `dst`
+  // must hold at least Utf16Utf8Length(src, length) bytes; 3 * `length` is
+  // always enough.
+  inline size_t Utf16ToUtf8(const char16_t* src, size_t length, char* dst) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+      const size_t ascii = AsciiPrefixLength(src + in, length - in);
+      NarrowAscii(src + in, ascii, dst + out);
+      in += ascii;
+      out += ascii;
+      if (in == length) {
+        break;
+      }
+
+      uint32_t cp = src[in++];
+      if (cp >= 0xD800 && cp <= 0xDBFF && in < length && src[in] >= 0xDC00 && src[in] <= 0xDFFF) {
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (src[in++] - 0xDC00);
+      }
+      out += EncodeUtf8(cp, dst + out);
+    }
+    return out;
+  }
+
+  // Converts UTF-16 to UTF-8 like Utf16ToUtf8, but writes at most `capacity`
+  // bytes, stopping before the first code point that doesn't fit.
+  inline size_t Utf16ToUtf8(const char16_t* src, size_t length, char* dst, size_t capacity) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length && out < capacity) {
+      const size_t ascii = std::min(AsciiPrefixLength(src + in, length - in), capacity - out);
+      NarrowAscii(src + in, ascii, dst + out);
+      in += ascii;
+      out += ascii;
+      if (in == length || out == capacity) {
+        break;
+      }
+
+      uint32_t cp = src[in];
+      size_t units = 1;
+      if (cp >= 0xD800 && cp <= 0xDBFF && in + 1 < length && src[in + 1] >= 0xDC00 && src[in + 1] <= 0xDFFF) {
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (src[in + 1] - 0xDC00);
+        units = 2;
+      }
+
+      char encoded[4];
+      const size_t size = EncodeUtf8(cp, encoded);
+      if (size > capacity - out) {
+        break;
+      }
+      std::memcpy(dst + out, encoded, size);
+      in += units;
+      out += size;
+    }
+    return out;
+  }
+
+  // Number of bytes Latin1ToUtf8 writes for `length` Latin-1 bytes: one per
+  // ASCII byte and two per byte above 0x7F.
+  inline size_t Latin1Utf8Length(const char* src, size_t length) {
+    size_t in = 0;
+    size_t out = length;
+    while (in < length) {
+      in += AsciiPrefixLength(src + in, length - in);
+      if (in == length) {
+        break;
+      }
+
+      ++in;
+      ++out;
+    }
+    return out;
+  }
+
+  // Converts Latin-1 to UTF-8 and returns the number of bytes written. `dst`
+  // must hold at least Latin1Utf8Length(src, length) bytes.
+  inline size_t Latin1ToUtf8(const char* src, size_t length, char* dst) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+      const size_t ascii = AsciiPrefixLength(src + in, length - in);
+      std::memcpy(dst + out, src + in, ascii);
+      in += ascii;
+      out += ascii;
+      if (in == length) {
+        break;
+      }
+
+      out += EncodeUtf8(static_cast<unsigned char>(src[in++]), dst + out);
+    }
+    return out;
+  }
+
+  // Decodes the multi-byte sequence at `src[in]`, advancing `in` past it, and
+  // returns its code point. Invalid sequences become U+FFFD. Encoded
+  // surrogates (as produced by engines for unpaired surrogates) are passed
+  // through when `allowSurrogates` is set and replaced otherwise.
+  inline uint32_t DecodeUtf8(const char* src, size_t length, size_t& in, bool allowSurrogates) {
+    const auto* s = reinterpret_cast<const unsigned char*>(src);
+    uint32_t cp;
+    size_t trail;
+    const unsigned char lead = s[in++];
+    if ((lead >> 5) == 0x6) {
+      cp = lead & 0x1F;
+      trail = 1;
+    } else if ((lead >> 4) == 0xE) {
+      cp = lead & 0x0F;
+      trail = 2;
+    } else if ((lead >> 3) == 0x1E) {
+      cp = lead & 0x07;
+      trail = 3;
+    } else {
+      return 0xFFFD;
+    }
+
+    if (in + trail > length) {
+      in = length;
+      return 0xFFFD;
+    }
+
+    for (size_t i = 0; i < trail; ++i) {
+      if ((s[in + i] & 0xC0) != 0x80) {
+        return 0xFFFD;
+      }
+      cp = (cp << 6) | (s[in + i] & 0x3F);
+    }
+    in += trail;
+
+    // Reject overlong encodings and out-of-range values.
+    if ((trail == 1 && cp < 0x80) ||
+        (trail == 2 && cp < 0x800) ||
+        (trail == 3 && cp < 0x10000) ||
+        (!allowSurrogates && cp >= 0xD800 && cp <= 0xDFFF) ||
+        cp > 0x10FFFF) {
+      return 0xFFFD;
+    }
+    return cp;
+  }
+
+  // Number of UTF-16 code units Utf8ToUtf16 writes for `length` bytes.
+  inline size_t Utf8Utf16Length(const char* src, size_t length, bool allowSurrogates) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+      const size_t ascii = AsciiPrefixLength(src + in, length - in);
+      in += ascii;
+      out += ascii;
+      if (in == length) {
+        break;
+      }
+
+      out += DecodeUtf8(src, length, in, allowSurrogates) > 0xFFFF ? 2 : 1;
+    }
+    return out;
+  }
+
+  // Converts UTF-8 to UTF-16 and returns the number of code units written.
+  // `dst` must hold at least `length` code units. See DecodeUtf8 for how
+  // invalid sequences and surrogates are handled.
+  inline size_t Utf8ToUtf16(const char* src, size_t length, char16_t* dst, bool allowSurrogates) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+      const size_t ascii = AsciiPrefixLength(src + in, length - in);
+      Widen(src + in, ascii, dst + out);
+      in += ascii;
+      out += ascii;
+      if (in == length) {
+        break;
+      }
+
+      uint32_t cp = DecodeUtf8(src, length, in, allowSurrogates);
+      if (cp <= 0xFFFF) {
+        dst[out++] = static_cast<char16_t>(cp);
+      } else {
+        cp -= 0x10000;
+        dst[out++] = static_cast<char16_t>(0xD800 + (cp >> 10));
+        dst[out++] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+      }
+    }
+    return out;
+  }
+
+  // Converts UTF-8 to Latin-1, writing at most `capacity` bytes, and returns
+  // the number of bytes written. Like V8's one-byte writes, each UTF-16 code
+  // unit of the text becomes its low byte, which is exact for Latin-1 text.
+  inline size_t Utf8ToLatin1(const char* src, size_t length, char* dst, size_t capacity) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length && out < capacity) {
+      const size_t ascii = std::min(AsciiPrefixLength(src + in, length - in), capacity - out);
+      std::memcpy(dst + out, src + in, ascii);
+      in += ascii;
+      out += ascii;
+      if (in == length || out == capacity) {
+        break;
+      }
+
+      uint32_t cp = DecodeUtf8(src, length, in, true);
+      if (cp <= 0xFFFF) {
+        dst[out++] = static_cast<char>(cp);
+      } else {
+        cp -= 0x10000;
+        dst[out++] = static_cast<char>(0xD800 + (cp >> 10));
+        if (out < capacity) {
+          dst[out++] = static_cast<char>(0xDC00 + (cp & 0x3FF));
+        }
+      }
+    }
+    return out;
+  }
+}
@@ -4,6 +4,7 @@
 #include <arcana/tracing/trace_region.h>
 #include <sstream>
 #include "Babylon/DebugTrace.h"
+#include "Babylon/StartupTrace.h"
 
 namespace Babylon
 {
@@ -22,15 +23,23 @@ namespace Babylon
             std::string traceName = (std::ostringstream{} << "Loading script at url " << url).str();
             DEBUG_TRACE("%s", traceName.c_str());
             arcana::trace_region requestRegion{traceName.c_str()};
+            const auto fetchStart = StartupTrace::Clock::now();
+            auto fetchEnd = std::make_shared<StartupTrace::Clock::time_point>();
             request.Open(UrlLib::UrlMethod::Get, url);
             request.ResponseType(UrlLib::UrlResponseType::String);
-            const auto requestTask = request.SendAsync().then(arcana::inline_scheduler, arcana::cancellation::none(), [requestRegion{std::move(requestRegion)}]() { });
-            m_task = arcana::when_all(m_task, requestTask).then(arcana::inline_scheduler, arcana::cancellation::none(), [dispatchFunction = m_dispatchFunction, request = std::move(request), url = std::move(url)](auto) mutable {
+            const auto requestTask = request.SendAsync().then(arcana::inline_scheduler, arcana::cancellation::none(), [requestRegion{std::move(requestRegion)}, fetchEnd]() {
+                *fetchEnd = StartupTrace::Clock::now();
+            });
+            m_task = arcana::when_all(m_task, requestTask).then(arcana::inline_scheduler, arcana::cancellation::none(), [dispatchFunction = m_dispatchFunction, request = std::move(request), url = std::move(url), fetchStart, fetchEnd](auto) mutable {
                 arcana::task_completion_source<void, std::exception_ptr> taskCompletionSource{};
-                dispatchFunction([taskCompletionSource, request = std::move(request), url = std::move(url)](Napi::Env env) mutable {
+                dispatchFunction([taskCompletionSource, request = std::move(request), url = std::move(url), fetchStart, fetchEnd](Napi::Env env) mutable {
+                    // The fetch ran off the JavaScript thread, so it is only recorded now.
+                    StartupTrace::Record(env, "ScriptLoader::Fetch", url, fetchStart, *fetchEnd);
+
                     std::string traceName = (std::ostringstream{} << "Evaluating script at url " << url << " (LoadScript)").str();
                     DEBUG_TRACE("%s", traceName.c_str());
                     arcana::trace_region evalRegion{traceName.c_str()};
+                    StartupTrace::Scope evalPhase{env, "ScriptLoader::Eval", url};
                     Napi::Eval(env, request.ResponseString().data(), url.data());
                     taskCompletionSource.complete();
                 });
@@ -46,6 +55,7 @@ namespace Babylon
                     dispatchFunction([taskCompletionSource, source = std::move(source), url = std::move(url)](Napi::Env env) mutable {
                         std::string traceName = (std::ostringstream{} << "Evaluating script at url " << url << " (Eval)").str();
                         arcana::trace_region evalRegion{traceName.c_str()};
+                        StartupTrace::Scope evalPhase{env, "ScriptLoader::Eval", url};
                         Napi::Eval(env, source.data(), url.data());
                         taskCompletionSource.complete();
                     });
@@ -1,5 +1,6 @@
 #include "AbortController.h"
 #include <cassert>
+#include <Babylon/StartupTrace.h>
 
 namespace Babylon::Polyfills::Internal
 {
@@ -44,6 +45,7 @@ namespace Babylon::Polyfills::AbortController
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::AbortController::Initialize"};
         Internal::AbortController::Initialize(env);
         Internal::AbortSignal::Initialize(env);
     }
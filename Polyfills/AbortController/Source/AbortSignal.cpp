@@ -3,10 +3,25 @@
 
 namespace Babylon::Polyfills::Internal
 {
+    namespace
+    {
+        static constexpr auto JS_ABORT_SIGNAL_KEYS_NAME = "abortSignalKeys";
+    }
+
+    AbortSignal::PropertyKeys::PropertyKeys(Napi::Env env)
+        : name{Napi::PropertyKey::New(env, "name")}
+    {
+    }
+
     void AbortSignal::Initialize(Napi::Env env)
     {
         if (env.Global().Get(JS_ABORT_SIGNAL_CONSTRUCTOR_NAME).IsUndefined())
         {
+            // Owned by the native object, so the keys live as long as the env.
+            auto* keys = new PropertyKeys{env};
+            JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_ABORT_SIGNAL_KEYS_NAME,
+                Napi::External<PropertyKeys>::New(env, keys, [](Napi::Env, PropertyKeys* keys) { delete keys; }));
+
             Napi::Function func = DefineClass(
                 env,
                 JS_ABORT_SIGNAL_CONSTRUCTOR_NAME,
@@ -18,7 +33,8 @@ namespace Babylon::Polyfills::Internal
                     InstanceMethod("addEventListener", &AbortSignal::AddEventListener),
                     InstanceMethod("removeEventListener", &AbortSignal::RemoveEventListener),
                     StaticMethod("abort", &AbortSignal::AbortStatic),
-                });
+                },
+                keys);
 
             env.Global().Set(JS_ABORT_SIGNAL_CONSTRUCTOR_NAME, func);
         }
@@ -26,16 +42,18 @@ namespace Babylon::Polyfills::Internal
 
     AbortSignal::AbortSignal(const Napi::CallbackInfo& info)
         : Napi::ObjectWrap<AbortSignal>{info}
+        , m_keys{*static_cast<const PropertyKeys*>(info.Data())}
     {
     }
 
-    Napi::Value AbortSignal::CreateAbortError(Napi::Env env, const char* message)
+    Napi::Value AbortSignal::CreateAbortError(const char* message) const
     {
+        Napi::Env env = Env();
         // There is no DOMException polyfill, so represent the abort reason as an Error whose `name`
         // is "AbortError" -- the value web code checks (`err.name === "AbortError"`).
-        Napi::Error error = Napi::Error::New(env, message);
-        error.Set("name", Napi::String::New(env, "AbortError"));
-        return error.Value();
+        Napi::Object error = Napi::Error::New(env, message).Value();
+        error.Set(m_keys.name, Napi::String::New(env, "AbortError"));
+        return error;
     }
 
     void AbortSignal::Abort(const Napi::Value& reason)
@@ -47,9 +65,8 @@ namespace Babylon::Polyfills::Internal
 
         m_aborted = true;
 
-        Napi::Env env = Env();
         const Napi::Value resolvedReason = (reason.IsUndefined() || reason.IsEmpty())
-            ? CreateAbortError(env, "The operation was aborted.")
+            ? CreateAbortError("The operation was aborted.")
             : reason;
         m_reason = Napi::Persistent(resolvedReason);
 
@@ -21,12 +21,21 @@ namespace Babylon::Polyfills::Internal
         // "AbortError"), firing onabort and any "abort" listeners. No-op if already aborted.
         void Abort(const Napi::Value& reason);
 
+    private:
+        // Property keys built once per env in Initialize and handed to every instance through
+        // the class data.
+        struct PropertyKeys
+        {
+            explicit PropertyKeys(Napi::Env env);
+
+            Napi::PropertyKey name;
+        };
+
         // Build the default abort reason: an Error whose name is "AbortError" (there is no
         // DOMException polyfill), matching what the platform uses when abort() is called with no
         // reason and what fetch() rejects with on abort.
-        static Napi::Value CreateAbortError(Napi::Env env, const char* message);
+        Napi::Value CreateAbortError(const char* message) const;
 
-    private:
         Napi::Value GetAborted(const Napi::CallbackInfo& info);
 
         Napi::Value GetReason(const Napi::CallbackInfo& info);
@@ -44,6 +53,7 @@ namespace Babylon::Polyfills::Internal
 
         std::unordered_map<std::string, std::vector<Napi::FunctionReference>> m_eventHandlerRefs;
 
+        const PropertyKeys m_keys;
         Napi::FunctionReference m_onabort;
         Napi::Reference<Napi::Value> m_reason;
         bool m_aborted = false;
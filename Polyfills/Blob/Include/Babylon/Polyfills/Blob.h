@@ -3,7 +3,18 @@
 #include <napi/env.h>
 #include <Babylon/Api.h>
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace Babylon::Polyfills::Blob
 {
     void BABYLON_API Initialize(Napi::Env env);
+
+    // Copies the contents and type of `value` if it is a Blob created by this
+    // polyfill (not a subclass such as File). Returns false otherwise.
+    bool BABYLON_API TryGetData(Napi::Value value, std::vector<std::byte>& data, std::string& type);
+
+    // Creates a Blob holding `data`. Initialize must have been called for `env`.
+    Napi::Value BABYLON_API Create(Napi::Env env, std::vector<std::byte> data, std::string type);
 }
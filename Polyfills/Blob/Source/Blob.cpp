@@ -1,12 +1,12 @@
 #include "Blob.h"
 #include <Babylon/JsRuntime.h>
 #include <Babylon/Polyfills/Blob.h>
+#include <Babylon/StartupTrace.h>
 
 namespace Babylon::Polyfills::Internal
 {
     void Blob::Initialize(Napi::Env env)
     {
-        static constexpr auto JS_BLOB_CONSTRUCTOR_NAME = "Blob";
         if (env.Global().Get(JS_BLOB_CONSTRUCTOR_NAME).IsUndefined())
         {
             Napi::Function func = DefineClass(
@@ -54,6 +54,42 @@ namespace Babylon::Polyfills::Internal
         }
     }
 
+    bool Blob::TryGetData(Napi::Value value, std::vector<std::byte>& data, std::string& type)
+    {
+        if (!value.IsObject())
+        {
+            return false;
+        }
+
+        const auto constructor = value.Env().Global().Get(JS_BLOB_CONSTRUCTOR_NAME);
+        if (!constructor.IsFunction())
+        {
+            return false;
+        }
+
+        // Only exact Blobs are unwrapped: a File is also an instance of Blob,
+        // but wraps a different native object.
+        const auto object = value.As<Napi::Object>();
+        if (object.Get("constructor") != constructor || !object.InstanceOf(constructor.As<Napi::Function>()))
+        {
+            return false;
+        }
+
+        const auto* blob = Napi::ObjectWrap<Blob>::Unwrap(object);
+        data = blob->m_data;
+        type = blob->m_type;
+        return true;
+    }
+
+    Napi::Value Blob::Create(Napi::Env env, std::vector<std::byte> data, std::string type)
+    {
+        const auto object = env.Global().Get(JS_BLOB_CONSTRUCTOR_NAME).As<Napi::Function>().New({});
+        auto* blob = Napi::ObjectWrap<Blob>::Unwrap(object);
+        blob->m_data = std::move(data);
+        blob->m_type = std::move(type);
+        return object;
+    }
+
     Napi::Value Blob::GetSize(const Napi::CallbackInfo&)
     {
         return Napi::Value::From(Env(), m_data.size());
@@ -137,6 +173,16 @@ namespace Babylon::Polyfills::Blob
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::Blob::Initialize"};
         Internal::Blob::Initialize(env);
     }
+    bool BABYLON_API TryGetData(Napi::Value value, std::vector<std::byte>& data, std::string& type)
+    {
+        return Internal::Blob::TryGetData(value, data, type);
+    }
+
+    Napi::Value BABYLON_API Create(Napi::Env env, std::vector<std::byte> data, std::string type)
+    {
+        return Internal::Blob::Create(env, std::move(data), std::move(type));
+    }
 }
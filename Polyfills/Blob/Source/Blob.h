@@ -10,10 +10,15 @@ namespace Babylon::Polyfills::Internal
     class Blob : public Napi::ObjectWrap<Blob>
     {
     public:
+        static constexpr auto JS_BLOB_CONSTRUCTOR_NAME = "Blob";
+
         static void Initialize(Napi::Env env);
 
         explicit Blob(const Napi::CallbackInfo& info);
 
+        static bool TryGetData(Napi::Value value, std::vector<std::byte>& data, std::string& type);
+        static Napi::Value Create(Napi::Env env, std::vector<std::byte> data, std::string type);
+
     private:
         Napi::Value GetSize(const Napi::CallbackInfo& info);
         Napi::Value GetType(const Napi::CallbackInfo& info);
@@ -1,4 +1,5 @@
 #include <Babylon/Polyfills/Console.h>
+#include <Babylon/StartupTrace.h>
 
 #include <array>
 #include <functional>
@@ -40,7 +41,8 @@ namespace
         std::ostringstream ss{};
         if (info.Length() > 0)
         {
-            std::string firstArg = info[0].ToString();
+            const Napi::StringView firstArgView{info[0].ToString()};
+            const std::string_view firstArg = firstArgView;
             size_t currArgIndex = 1;
 
             std::size_t j = 0;
@@ -55,7 +57,7 @@ namespace
                     // the next character can be one of: [soO], when the substitution string specifies a string
                     if (nextChar == 'o' || nextChar == 'O' || nextChar == 's')
                     {
-                        ss << currArg.ToString().Utf8Value();
+                        ss << Napi::StringView{currArg.ToString()}.Value();
                         currArgIndex++;
                     }
                     // or [dif], when it specifies a number
@@ -98,7 +100,7 @@ namespace
             {
                 ss << " ";
                 Napi::Value currArg = info[currArgIndex];
-                ss << currArg.ToString().Utf8Value();
+                ss << Napi::StringView{currArg.ToString()}.Value();
             }
         }
 
@@ -126,6 +128,8 @@ namespace Babylon::Polyfills::Console
 {
     void BABYLON_API Initialize(Napi::Env env, CallbackT callback)
     {
+        StartupTrace::Scope phase{env, "Polyfills::Console::Initialize"};
+
         Napi::HandleScope scope{env};
 
         auto console = env.Global().Get(JS_INSTANCE_NAME).As<Napi::Object>();
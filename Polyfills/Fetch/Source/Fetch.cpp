@@ -3,7 +3,9 @@
 #include <Babylon/JsRuntime.h>
 #include <Babylon/JsRuntimeScheduler.h>
 #include <Babylon/Polyfills/Fetch.h>
+#include <Babylon/StartupTrace.h>
 
+#include <TaskAwaiter.h>
 #include <UrlLib/UrlLib.h>
 
 #include <algorithm>
@@ -30,9 +32,61 @@ namespace Babylon::Polyfills::Internal
             std::vector<std::byte> body;
         };
 
+        // Property names touched on every fetch() call and every Response built, interned once per
+        // env in Initialize so the hot path does not re-create the name strings each time.
+        struct PropertyKeys
+        {
+            explicit PropertyKeys(Napi::Env env)
+                : url{Napi::PropertyKey::New(env, "url")}
+                , method{Napi::PropertyKey::New(env, "method")}
+                , body{Napi::PropertyKey::New(env, "body")}
+                , headers{Napi::PropertyKey::New(env, "headers")}
+                , signal{Napi::PropertyKey::New(env, "signal")}
+                , aborted{Napi::PropertyKey::New(env, "aborted")}
+                , reason{Napi::PropertyKey::New(env, "reason")}
+                , name{Napi::PropertyKey::New(env, "name")}
+                , ok{Napi::PropertyKey::New(env, "ok")}
+                , status{Napi::PropertyKey::New(env, "status")}
+                , statusText{Napi::PropertyKey::New(env, "statusText")}
+                , redirected{Napi::PropertyKey::New(env, "redirected")}
+                , type{Napi::PropertyKey::New(env, "type")}
+                , bodyUsed{Napi::PropertyKey::New(env, "bodyUsed")}
+                , text{Napi::PropertyKey::New(env, "text")}
+                , arrayBuffer{Napi::PropertyKey::New(env, "arrayBuffer")}
+                , json{Napi::PropertyKey::New(env, "json")}
+                , blob{Napi::PropertyKey::New(env, "blob")}
+                , clone{Napi::PropertyKey::New(env, "clone")}
+                , response{Napi::ObjectTemplate::New(env, {ok, status, statusText, url, redirected, type, bodyUsed, headers})}
+            {
+            }
+
+            Napi::PropertyKey url;
+            Napi::PropertyKey method;
+            Napi::PropertyKey body;
+            Napi::PropertyKey headers;
+            Napi::PropertyKey signal;
+            Napi::PropertyKey aborted;
+            Napi::PropertyKey reason;
+            Napi::PropertyKey name;
+            Napi::PropertyKey ok;
+            Napi::PropertyKey status;
+            Napi::PropertyKey statusText;
+            Napi::PropertyKey redirected;
+            Napi::PropertyKey type;
+            Napi::PropertyKey bodyUsed;
+            Napi::PropertyKey text;
+            Napi::PropertyKey arrayBuffer;
+            Napi::PropertyKey json;
+            Napi::PropertyKey blob;
+            Napi::PropertyKey clone;
+
+            // Shape of the data fields every Response starts with.
+            Napi::ObjectTemplate response;
+        };
+
         // Shared state for honoring an AbortSignal passed via init.signal. Co-owned by the "abort"
         // listener (which sets the flag, captures the reason, and cancels the transport) and the
-        // completion continuation (which reports the AbortError and tears the listener down).
+        // Send coroutine (which reports the AbortError and tears the listener down once resumed).
         struct AbortState
         {
             bool aborted{false};
@@ -43,17 +97,17 @@ namespace Babylon::Polyfills::Internal
 
         // The reason a fetch was aborted: the signal's `reason` (per the modern AbortSignal), or a
         // fresh AbortError if the signal does not expose one.
-        Napi::Value GetAbortReason(Napi::Env env, const Napi::Object& signal)
+        Napi::Value GetAbortReason(Napi::Env env, const PropertyKeys& keys, const Napi::Object& signal)
         {
-            const Napi::Value reason = signal.Get("reason");
+            const Napi::Value reason = signal.Get(keys.reason);
             if (!reason.IsUndefined() && !reason.IsNull())
             {
                 return reason;
             }
 
-            Napi::Error error = Napi::Error::New(env, "The operation was aborted.");
-            error.Set("name", Napi::String::New(env, "AbortError"));
-            return error.Value();
+            Napi::Object error = Napi::Error::New(env, "The operation was aborted.").Value();
+            error.Set(keys.name, Napi::String::New(env, "AbortError"));
+            return error;
         }
 
         bool EqualsIgnoreCase(std::string_view a, std::string_view b)
@@ -69,8 +123,8 @@ namespace Babylon::Polyfills::Internal
         constexpr const char* FETCH_FAILED_MESSAGE = "fetch failed";
 
         // Snapshot the JS call-site stack synchronously, inside fetch(), before SendAsync() hands
-        // the request to a worker thread. The transport-failure rejection is otherwise built in a
-        // continuation that runs after fetch() has returned, where an Error would capture zero user
+        // the request to a worker thread. The transport-failure rejection is otherwise built once the
+        // Send coroutine resumes after fetch() has returned, where an Error would capture zero user
         // frames. We go through the global JS `Error` constructor (rather than napi_create_error) so
         // engines that materialize `.stack` from the JS constructor path capture the live caller
         // frames. The result is a plain std::string, safe to carry across the thread hop (unlike a
@@ -143,7 +197,7 @@ namespace Babylon::Polyfills::Internal
         }
 
         // fetch only resolves for GET and POST because the underlying UrlLib transport supports nothing else.
-        UrlLib::UrlMethod ParseMethod(const std::string& method)
+        UrlLib::UrlMethod ParseMethod(std::string_view method)
         {
             if (EqualsIgnoreCase(method, "GET"))
             {
@@ -154,7 +208,7 @@ namespace Babylon::Polyfills::Internal
                 return UrlLib::UrlMethod::Post;
             }
 
-            throw std::runtime_error{"Unsupported fetch method: " + method + " (only GET and POST are supported)"};
+            throw std::runtime_error{"Unsupported fetch method: " + std::string{method} + " (only GET and POST are supported)"};
         }
 
         std::optional<std::string> FindHeader(const ResponseData& data, std::string_view name)
@@ -228,12 +282,12 @@ namespace Babylon::Polyfills::Internal
 
             headers.Set("get", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
                 Napi::Env env = info.Env();
-                const auto value = FindHeader(*data, info[0].ToString().Utf8Value());
+                const auto value = FindHeader(*data, Napi::StringView{info[0].ToString()});
                 return value ? Napi::Value{Napi::String::New(env, *value)} : Napi::Value{env.Null()};
             }, "get"));
 
             headers.Set("has", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
-                return Napi::Boolean::New(info.Env(), FindHeader(*data, info[0].ToString().Utf8Value()).has_value());
+                return Napi::Boolean::New(info.Env(), FindHeader(*data, Napi::StringView{info[0].ToString()}).has_value());
             }, "has"));
 
             headers.Set("forEach", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
@@ -250,21 +304,21 @@ namespace Babylon::Polyfills::Internal
             return headers;
         }
 
-        Napi::Object BuildResponse(Napi::Env env, const std::shared_ptr<ResponseData>& data)
+        Napi::Object BuildResponse(Napi::Env env, const std::shared_ptr<const PropertyKeys>& keys, const std::shared_ptr<ResponseData>& data)
         {
-            Napi::Object response = Napi::Object::New(env);
-
             const bool ok = data->statusCode >= 200 && data->statusCode < 300;
-            response.Set("ok", Napi::Boolean::New(env, ok));
-            response.Set("status", Napi::Number::New(env, data->statusCode));
-            response.Set("statusText", Napi::String::New(env, data->statusText));
-            response.Set("url", Napi::String::New(env, data->url));
-            response.Set("redirected", Napi::Boolean::New(env, false));
-            response.Set("type", Napi::String::New(env, "basic"));
-            response.Set("bodyUsed", Napi::Boolean::New(env, false));
-            response.Set("headers", BuildHeaders(env, data));
-
-            response.Set("text", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
+            Napi::Object response = keys->response.NewInstance({
+                Napi::Boolean::New(env, ok),
+                Napi::Number::New(env, data->statusCode),
+                Napi::String::New(env, data->statusText),
+                Napi::String::New(env, data->url),
+                Napi::Boolean::New(env, false),
+                Napi::String::New(env, "basic"),
+                Napi::Boolean::New(env, false),
+                BuildHeaders(env, data),
+            });
+
+            response.Set(keys->text, Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
                 Napi::Env env = info.Env();
                 const auto deferred = Napi::Promise::Deferred::New(env);
                 std::string text{reinterpret_cast<const char*>(data->body.data()), data->body.size()};
@@ -272,7 +326,7 @@ namespace Babylon::Polyfills::Internal
                 return deferred.Promise();
             }, "text"));
 
-            response.Set("arrayBuffer", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
+            response.Set(keys->arrayBuffer, Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
                 Napi::Env env = info.Env();
                 const auto deferred = Napi::Promise::Deferred::New(env);
                 const auto arrayBuffer = Napi::ArrayBuffer::New(env, data->body.size());
@@ -284,7 +338,7 @@ namespace Babylon::Polyfills::Internal
                 return deferred.Promise();
             }, "arrayBuffer"));
 
-            response.Set("json", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
+            response.Set(keys->json, Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
                 Napi::Env env = info.Env();
                 const auto deferred = Napi::Promise::Deferred::New(env);
                 std::string text{reinterpret_cast<const char*>(data->body.data()), data->body.size()};
@@ -301,7 +355,7 @@ namespace Babylon::Polyfills::Internal
                 return deferred.Promise();
             }, "json"));
 
-            response.Set("blob", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
+            response.Set(keys->blob, Napi::Function::New(env, [keys, data](const Napi::CallbackInfo& info) -> Napi::Value {
                 Napi::Env env = info.Env();
                 const auto deferred = Napi::Promise::Deferred::New(env);
 
@@ -328,18 +382,83 @@ namespace Babylon::Polyfills::Internal
 
                 Napi::Object options = Napi::Object::New(env);
                 const auto contentType = FindHeader(*data, "content-type");
-                options.Set("type", Napi::String::New(env, contentType.value_or("")));
+                options.Set(keys->type, Napi::String::New(env, contentType.value_or("")));
 
                 deferred.Resolve(blobConstructor.As<Napi::Function>().New({parts, options}));
                 return deferred.Promise();
             }, "blob"));
 
-            response.Set("clone", Napi::Function::New(env, [data](const Napi::CallbackInfo& info) -> Napi::Value {
-                return BuildResponse(info.Env(), data);
+            response.Set(keys->clone, Napi::Function::New(env, [keys, data](const Napi::CallbackInfo& info) -> Napi::Value {
+                return BuildResponse(info.Env(), keys, data);
             }, "clone"));
 
             return response;
         }
+
+        // Sends the request and settles the fetch() promise on the JavaScript thread once it completes.
+        Coroutine Send(JsRuntimeScheduler scheduler, Napi::Promise::Deferred deferred, std::shared_ptr<UrlLib::UrlRequest> request, Napi::Env env,
+            std::string url, std::string capturedStack, std::shared_ptr<AbortState> abortState, std::shared_ptr<const PropertyKeys> keys)
+        {
+            const auto result = co_await TaskAwaiter{scheduler, request->SendAsync()};
+
+            try
+            {
+                // The request has settled: stop listening for aborts (breaking the
+                // listener <-> abortState ownership cycle) before deciding the outcome.
+                if (abortState)
+                {
+                    if (!abortState->signal.IsEmpty() && !abortState->listener.IsEmpty())
+                    {
+                        Napi::Object signalObject = abortState->signal.Value();
+                        signalObject.Get("removeEventListener").As<Napi::Function>().Call(signalObject, {Napi::String::New(env, "abort"), abortState->listener.Value()});
+                    }
+                    abortState->listener.Reset();
+                    abortState->signal.Reset();
+
+                    if (abortState->aborted)
+                    {
+                        // Per the fetch spec, an aborted request rejects with the
+                        // signal's reason (an AbortError), not a network error.
+                        deferred.Reject(abortState->reason.Value());
+                        co_return;
+                    }
+                }
+
+                const int status = static_cast<int>(request->StatusCode());
+
+                // Per the WHATWG fetch spec, only transport-level failures reject. A completed
+                // request with a non-2xx status (e.g. 404) still resolves with response.ok === false.
+                // A status of 0 indicates the transport never produced a response (network error).
+                if (result.has_error() || status == 0)
+                {
+                    // Reject with a TypeError carrying the normalized transport detail on `cause`
+                    // (built here, where the UrlRequest's ErrorString()/ErrorSymbol() are still in
+                    // scope) instead of throwing a constant string that discards them.
+                    deferred.Reject(BuildTransportError(env, *request, url, capturedStack).Value());
+                    co_return;
+                }
+
+                auto data = std::make_shared<ResponseData>();
+                data->statusCode = status;
+                data->statusText = std::string{request->StatusText()};
+                data->url = std::string{request->ResponseUrl()};
+                for (const auto& header : request->GetAllResponseHeaders())
+                {
+                    data->headers.emplace_back(header.first, header.second);
+                }
+                const auto responseBuffer = request->ResponseBuffer();
+                data->body.assign(responseBuffer.begin(), responseBuffer.end());
+
+                deferred.Resolve(BuildResponse(env, keys, data));
+            }
+            catch (...)
+            {
+                // A throw while settling (e.g. a JS exception while building the response) is
+                // surfaced as a promise rejection so await fetch(...) settles. Transport failures
+                // are already rejected above, so this only handles unexpected exceptions.
+                deferred.Reject(Napi::Error::New(env, std::current_exception()).Value());
+            }
+        }
     }
 
     namespace Fetch
@@ -348,7 +467,9 @@ namespace Babylon::Polyfills::Internal
         {
             static constexpr auto JS_FETCH_NAME = "fetch";
 
-            auto fetchFunction = Napi::Function::New(env, [](const Napi::CallbackInfo& info) -> Napi::Value {
+            auto keys = std::make_shared<const PropertyKeys>(env);
+
+            auto fetchFunction = Napi::Function::New(env, [keys](const Napi::CallbackInfo& info) -> Napi::Value {
                 Napi::Env env = info.Env();
                 const auto deferred = Napi::Promise::Deferred::New(env);
 
@@ -366,9 +487,9 @@ namespace Babylon::Polyfills::Internal
                     {
                         url = input.As<Napi::String>().Utf8Value();
                     }
-                    else if (input.IsObject() && input.As<Napi::Object>().Get("url").IsString())
+                    else if (input.IsObject() && input.As<Napi::Object>().Get(keys->url).IsString())
                     {
-                        url = input.As<Napi::Object>().Get("url").As<Napi::String>().Utf8Value();
+                        url = input.As<Napi::Object>().Get(keys->url).As<Napi::String>().Utf8Value();
                     }
                     else
                     {
@@ -384,13 +505,13 @@ namespace Babylon::Polyfills::Internal
                     {
                         const auto init = info[1].As<Napi::Object>();
 
-                        const auto methodValue = init.Get("method");
+                        const auto methodValue = init.Get(keys->method);
                         if (methodValue.IsString())
                         {
-                            method = ParseMethod(methodValue.As<Napi::String>().Utf8Value());
+                            method = ParseMethod(Napi::StringView{methodValue.As<Napi::String>()});
                         }
 
-                        const auto bodyValue = init.Get("body");
+                        const auto bodyValue = init.Get(keys->body);
                         if (bodyValue.IsString())
                         {
                             body = bodyValue.As<Napi::String>().Utf8Value();
@@ -400,8 +521,8 @@ namespace Babylon::Polyfills::Internal
                             throw std::runtime_error{"fetch: only string request bodies are supported"};
                         }
 
-                        headers = init.Get("headers");
-                        signal = init.Get("signal");
+                        headers = init.Get(keys->headers);
+                        signal = init.Get(keys->signal);
                     }
 
                     auto request = std::make_shared<UrlLib::UrlRequest>();
@@ -428,21 +549,21 @@ namespace Babylon::Polyfills::Internal
 
                         // Already aborted: reject synchronously with the signal's reason, never
                         // touching the transport.
-                        if (signalObject.Get("aborted").ToBoolean().Value())
+                        if (signalObject.Get(keys->aborted).ToBoolean().Value())
                         {
-                            deferred.Reject(GetAbortReason(env, signalObject));
+                            deferred.Reject(GetAbortReason(env, *keys, signalObject));
                             return deferred.Promise();
                         }
 
                         abortState = std::make_shared<AbortState>();
                         abortState->signal = Napi::Persistent(signalObject);
 
-                        Napi::Function listener = Napi::Function::New(env, [abortState, request, env](const Napi::CallbackInfo&) {
+                        Napi::Function listener = Napi::Function::New(env, [abortState, request, env, keys](const Napi::CallbackInfo&) {
                             if (!abortState->aborted)
                             {
                                 abortState->aborted = true;
-                                abortState->reason = Napi::Persistent(GetAbortReason(env, abortState->signal.Value()));
-                                // Cancel the in-flight transport; the completion continuation then
+                                abortState->reason = Napi::Persistent(GetAbortReason(env, *keys, abortState->signal.Value()));
+                                // Cancel the in-flight transport; the Send coroutine then
                                 // rejects with the AbortError instead of a transport TypeError.
                                 request->Abort();
                             }
@@ -451,74 +572,7 @@ namespace Babylon::Polyfills::Internal
                         signalObject.Get("addEventListener").As<Napi::Function>().Call(signalObject, {Napi::String::New(env, "abort"), listener});
                     }
 
-                    // arcana::task::then captures the scheduler by reference (see arcana task.h) and
-                    // invokes it on the worker thread when the request completes -- after this fetch()
-                    // call has returned. A stack-local scheduler would therefore dangle. Heap-allocate
-                    // it and co-own it from the continuation so it stays alive until the request finishes.
-                    auto scheduler = std::make_shared<JsRuntimeScheduler>(JsRuntime::GetFromJavaScript(env));
-                    request->SendAsync()
-                        .then(*scheduler, arcana::cancellation::none(),
-                            [deferred, request, env, url, capturedStack, abortState](const arcana::expected<void, std::exception_ptr>& result) {
-                                // The request has settled: stop listening for aborts (breaking the
-                                // listener <-> abortState ownership cycle) before deciding the outcome.
-                                if (abortState)
-                                {
-                                    if (!abortState->signal.IsEmpty() && !abortState->listener.IsEmpty())
-                                    {
-                                        Napi::Object signalObject = abortState->signal.Value();
-                                        signalObject.Get("removeEventListener").As<Napi::Function>().Call(signalObject, {Napi::String::New(env, "abort"), abortState->listener.Value()});
-                                    }
-                                    abortState->listener.Reset();
-                                    abortState->signal.Reset();
-
-                                    if (abortState->aborted)
-                                    {
-                                        // Per the fetch spec, an aborted request rejects with the
-                                        // signal's reason (an AbortError), not a network error.
-                                        deferred.Reject(abortState->reason.Value());
-                                        return;
-                                    }
-                                }
-
-                                const int status = static_cast<int>(request->StatusCode());
-
-                                // Per the WHATWG fetch spec, only transport-level failures reject. A completed
-                                // request with a non-2xx status (e.g. 404) still resolves with response.ok === false.
-                                // A status of 0 indicates the transport never produced a response (network error).
-                                if (result.has_error() || status == 0)
-                                {
-                                    // Reject with a TypeError carrying the normalized transport detail on `cause`
-                                    // (built here, where the UrlRequest's ErrorString()/ErrorSymbol() are still in
-                                    // scope) instead of throwing a constant string that discards them.
-                                    deferred.Reject(BuildTransportError(env, *request, url, capturedStack).Value());
-                                    return;
-                                }
-
-                                auto data = std::make_shared<ResponseData>();
-                                data->statusCode = status;
-                                data->statusText = std::string{request->StatusText()};
-                                data->url = std::string{request->ResponseUrl()};
-                                for (const auto& header : request->GetAllResponseHeaders())
-                                {
-                                    data->headers.emplace_back(header.first, header.second);
-                                }
-                                const auto responseBuffer = request->ResponseBuffer();
-                                data->body.assign(responseBuffer.begin(), responseBuffer.end());
-
-                                deferred.Resolve(BuildResponse(env, data));
-                            })
-                        .then(*scheduler, arcana::cancellation::none(),
-                            [deferred, env, scheduler](const arcana::expected<void, std::exception_ptr>& result) {
-                                // A throw from the continuation above (e.g. a JS exception while building the
-                                // response) lands here as an error result; surface it as a promise rejection so
-                                // await fetch(...) settles. Transport failures are already rejected above, so this
-                                // only handles unexpected exceptions. The scheduler is co-owned here so it
-                                // outlives the in-flight request.
-                                if (result.has_error())
-                                {
-                                    deferred.Reject(Napi::Error::New(env, result.error()).Value());
-                                }
-                            });
+                    Send(JsRuntimeScheduler{JsRuntime::GetFromJavaScript(env)}, deferred, std::move(request), env, std::move(url), capturedStack, std::move(abortState), keys);
                 }
                 catch (...)
                 {
@@ -542,6 +596,7 @@ namespace Babylon::Polyfills::Fetch
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::Fetch::Initialize"};
         Internal::Fetch::Initialize(env);
     }
 }
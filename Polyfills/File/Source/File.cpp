@@ -2,6 +2,7 @@
 #include "FileReader.h"
 
 #include <Babylon/Polyfills/File.h>
+#include <Babylon/StartupTrace.h>
 
 #include <chrono>
 #include <string>
@@ -179,6 +180,7 @@ namespace Babylon::Polyfills::File
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::File::Initialize"};
         Internal::File::Initialize(env);
         Internal::FileReader::Initialize(env);
     }
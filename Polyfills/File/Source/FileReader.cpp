@@ -1,5 +1,7 @@
 #include "FileReader.h"
 
+#include <Babylon/JsRuntime.h>
+
 #include <basen.hpp>
 
 #include <cstring>
@@ -12,6 +14,7 @@ namespace Babylon::Polyfills::Internal
     namespace
     {
         constexpr auto JS_FILE_READER_CONSTRUCTOR_NAME = "FileReader";
+        constexpr auto JS_FILE_READER_KEYS_NAME = "fileReaderKeys";
 
         // base-n's encode_b64 emits unpadded base64; data: URLs use the padded
         // RFC 4648 alphabet, so append the '=' run for the final partial group.
@@ -26,36 +29,6 @@ namespace Babylon::Polyfills::Internal
                 out.append(3 - remainder, '=');
             }
         }
-
-        Napi::Value MakeEvent(Napi::Env env, const Napi::Object& jsThis, const std::string& eventType)
-        {
-            // ProgressEvent contract: loaded/total reflect bytes processed. For
-            // one-shot reads we don't track interim progress — report the final
-            // byte count for both and leave lengthComputable=false.
-            double length = 0.0;
-            auto result = jsThis.Get("result");
-            if (result.IsArrayBuffer())
-            {
-                length = static_cast<double>(result.As<Napi::ArrayBuffer>().ByteLength());
-            }
-            else if (result.IsTypedArray())
-            {
-                length = static_cast<double>(result.As<Napi::TypedArray>().ByteLength());
-            }
-            else if (result.IsString())
-            {
-                length = static_cast<double>(result.As<Napi::String>().Utf8Value().size());
-            }
-
-            auto event = Napi::Object::New(env);
-            event.Set("type", Napi::String::New(env, eventType));
-            event.Set("target", jsThis);
-            event.Set("currentTarget", jsThis);
-            event.Set("lengthComputable", Napi::Boolean::New(env, false));
-            event.Set("loaded", Napi::Number::New(env, length));
-            event.Set("total", Napi::Number::New(env, length));
-            return event;
-        }
     }
 
     void FileReader::Initialize(Napi::Env env)
@@ -67,6 +40,11 @@ namespace Babylon::Polyfills::Internal
             return;
         }
 
+        // Owned by the native object, so the keys live as long as the env.
+        auto* keys = new PropertyKeys{env};
+        JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_FILE_READER_KEYS_NAME,
+            Napi::External<PropertyKeys>::New(env, keys, [](Napi::Env, PropertyKeys* keys) { delete keys; }));
+
         // Expose EMPTY/LOADING/DONE on both the constructor and the prototype
         // per the WHATWG FileAPI IDL `const` member exposure rule (see JsRH#173).
         Napi::Function func = DefineClass(
@@ -95,13 +73,30 @@ namespace Babylon::Polyfills::Internal
                 InstanceMethod("addEventListener", &FileReader::AddEventListener),
                 InstanceMethod("removeEventListener", &FileReader::RemoveEventListener),
                 InstanceMethod("dispatchEvent", &FileReader::DispatchEvent),
-            });
+            },
+            keys);
 
         global.Set(JS_FILE_READER_CONSTRUCTOR_NAME, func);
     }
 
+    FileReader::PropertyKeys::PropertyKeys(Napi::Env env)
+        : result{Napi::PropertyKey::New(env, "result")}
+        , error{Napi::PropertyKey::New(env, "error")}
+        , type{Napi::PropertyKey::New(env, "type")}
+        , target{Napi::PropertyKey::New(env, "target")}
+        , currentTarget{Napi::PropertyKey::New(env, "currentTarget")}
+        , lengthComputable{Napi::PropertyKey::New(env, "lengthComputable")}
+        , loaded{Napi::PropertyKey::New(env, "loaded")}
+        , total{Napi::PropertyKey::New(env, "total")}
+        , arrayBuffer{Napi::PropertyKey::New(env, "arrayBuffer")}
+        , then{Napi::PropertyKey::New(env, "then")}
+        , event{Napi::ObjectTemplate::New(env, {type, target, currentTarget, lengthComputable, loaded, total})}
+    {
+    }
+
     FileReader::FileReader(const Napi::CallbackInfo& info)
         : Napi::ObjectWrap<FileReader>{info}
+        , m_keys{*static_cast<const PropertyKeys*>(info.Data())}
     {
         // readyState and the on* handler slots are backed by plain C++ members.
         // result/error are boxed on a persistent holder object so the getters
@@ -109,8 +104,8 @@ namespace Babylon::Polyfills::Internal
         // rejecting them on the real N-API backends.
         auto env = info.Env();
         m_state = Napi::Persistent(Napi::Object::New(env));
-        m_state.Value().Set("result", env.Null());
-        m_state.Value().Set("error", env.Null());
+        m_state.Value().Set(m_keys.result, env.Null());
+        m_state.Value().Set(m_keys.error, env.Null());
     }
 
     void FileReader::ReadAsArrayBuffer(const Napi::CallbackInfo& info)
@@ -144,7 +139,7 @@ namespace Babylon::Polyfills::Internal
         m_readId++;
 
         m_readyState = DONE;
-        m_state.Value().Set("result", env.Null());
+        m_state.Value().Set(m_keys.result, env.Null());
         StoreError(Napi::Error::New(env, "FileReader aborted").Value());
 
         Dispatch(env, jsThis, "abort");
@@ -208,7 +203,7 @@ namespace Babylon::Polyfills::Internal
         }
 
         auto eventObj = info[0].As<Napi::Object>();
-        auto typeValue = eventObj.Get("type");
+        auto typeValue = eventObj.Get(m_keys.type);
         if (!typeValue.IsString())
         {
             return Napi::Boolean::New(env, false);
@@ -260,6 +255,36 @@ namespace Babylon::Polyfills::Internal
         }
     }
 
+    Napi::Value FileReader::MakeEvent(Napi::Env env, const Napi::Object& jsThis, const std::string& eventType) const
+    {
+        // ProgressEvent contract: loaded/total reflect bytes processed. For
+        // one-shot reads we don't track interim progress — report the final
+        // byte count for both and leave lengthComputable=false.
+        double length = 0.0;
+        auto result = jsThis.Get(m_keys.result);
+        if (result.IsArrayBuffer())
+        {
+            length = static_cast<double>(result.As<Napi::ArrayBuffer>().ByteLength());
+        }
+        else if (result.IsTypedArray())
+        {
+            length = static_cast<double>(result.As<Napi::TypedArray>().ByteLength());
+        }
+        else if (result.IsString())
+        {
+            length = static_cast<double>(result.As<Napi::String>().Utf8Value().size());
+        }
+
+        return m_keys.event.NewInstance({
+            Napi::String::New(env, eventType),
+            jsThis,
+            jsThis,
+            Napi::Boolean::New(env, false),
+            Napi::Number::New(env, length),
+            Napi::Number::New(env, length),
+        });
+    }
+
     void FileReader::StartRead(const Napi::CallbackInfo& info, ReadMode mode)
     {
         auto env = info.Env();
@@ -271,8 +296,8 @@ namespace Babylon::Polyfills::Internal
         }
 
         m_readyState = LOADING;
-        m_state.Value().Set("result", env.Null());
-        m_state.Value().Set("error", env.Null());
+        m_state.Value().Set(m_keys.result, env.Null());
+        m_state.Value().Set(m_keys.error, env.Null());
 
         // Mint a fresh id for this read. Abort()/restart bumps it to invalidate
         // a prior read's queued continuation.
@@ -298,7 +323,7 @@ namespace Babylon::Polyfills::Internal
         {
             auto sourceObj = source.As<Napi::Object>();
 
-            auto typeVal = sourceObj.Get("type");
+            auto typeVal = sourceObj.Get(m_keys.type);
             if (typeVal.IsString())
             {
                 auto t = typeVal.As<Napi::String>().Utf8Value();
@@ -308,7 +333,7 @@ namespace Babylon::Polyfills::Internal
                 }
             }
 
-            auto arrayBufferFn = sourceObj.Get("arrayBuffer");
+            auto arrayBufferFn = sourceObj.Get(m_keys.arrayBuffer);
             if (arrayBufferFn.IsFunction())
             {
                 promiseValue = arrayBufferFn.As<Napi::Function>().Call(sourceObj, {});
@@ -363,7 +388,7 @@ namespace Babylon::Polyfills::Internal
             });
 
         auto promiseObj = promiseValue.As<Napi::Object>();
-        promiseObj.Get("then").As<Napi::Function>().Call(promiseObj, {onResolve, onReject});
+        promiseObj.Get(m_keys.then).As<Napi::Function>().Call(promiseObj, {onResolve, onReject});
     }
 
     void FileReader::HandleReadResult(uint64_t myReadId, ReadMode mode, const std::string& contentType,
@@ -436,12 +461,12 @@ namespace Babylon::Polyfills::Internal
 
     Napi::Value FileReader::GetResult(const Napi::CallbackInfo&)
     {
-        return m_state.Value().Get("result");
+        return m_state.Value().Get(m_keys.result);
     }
 
     Napi::Value FileReader::GetError(const Napi::CallbackInfo&)
     {
-        return m_state.Value().Get("error");
+        return m_state.Value().Get(m_keys.error);
     }
 
     Napi::Value FileReader::GetOnHandler(const Napi::CallbackInfo& info)
@@ -472,12 +497,12 @@ namespace Babylon::Polyfills::Internal
 
     void FileReader::StoreResult(const Napi::Value& value)
     {
-        m_state.Value().Set("result", value.IsEmpty() ? value.Env().Null() : value);
+        m_state.Value().Set(m_keys.result, value.IsEmpty() ? value.Env().Null() : value);
     }
 
     void FileReader::StoreError(const Napi::Value& value)
     {
-        m_state.Value().Set("error", value.IsEmpty() ? value.Env().Null() : value);
+        m_state.Value().Set(m_keys.error, value.IsEmpty() ? value.Env().Null() : value);
     }
 
     void FileReader::HandleReadError(uint64_t myReadId, Napi::Object jsThis, const Napi::Value& error)
@@ -54,6 +54,7 @@ namespace Babylon::Polyfills::Internal
                               Napi::Object jsThis, const Napi::Value& bufValue);
         void HandleReadError(uint64_t myReadId, Napi::Object jsThis, const Napi::Value& error);
         void Dispatch(Napi::Env env, const Napi::Object& jsThis, const std::string& eventType);
+        Napi::Value MakeEvent(Napi::Env env, const Napi::Object& jsThis, const std::string& eventType) const;
 
         void StoreResult(const Napi::Value& value);
         void StoreError(const Napi::Value& value);
@@ -67,6 +68,27 @@ namespace Babylon::Polyfills::Internal
         uint64_t m_readId{0};
         std::unordered_map<std::string, std::vector<Napi::FunctionReference>> m_eventHandlerRefs;
 
+        // Property names read or written on every read and every dispatched
+        // event, plus the shape shared by every event object. Built once per
+        // env in Initialize and handed to every reader through the class data.
+        struct PropertyKeys
+        {
+            explicit PropertyKeys(Napi::Env env);
+
+            Napi::PropertyKey result;
+            Napi::PropertyKey error;
+            Napi::PropertyKey type;
+            Napi::PropertyKey target;
+            Napi::PropertyKey currentTarget;
+            Napi::PropertyKey lengthComputable;
+            Napi::PropertyKey loaded;
+            Napi::PropertyKey total;
+            Napi::PropertyKey arrayBuffer;
+            Napi::PropertyKey then;
+            Napi::ObjectTemplate event;
+        };
+        const PropertyKeys& m_keys;
+
         // readonly attribute state, surfaced through the getters above.
         int32_t m_readyState{EMPTY};
 
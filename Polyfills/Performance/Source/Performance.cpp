@@ -1,4 +1,5 @@
 #include <Babylon/Polyfills/Performance.h>
+#include <Babylon/StartupTrace.h>
 
 #include <napi/napi.h>
 #include <chrono>
@@ -22,6 +23,8 @@ namespace Babylon::Polyfills::Performance
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::Performance::Initialize"};
+
         Napi::HandleScope scope{env};
 
         // Initialize the start time
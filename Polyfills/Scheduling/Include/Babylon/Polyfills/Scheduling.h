@@ -3,7 +3,26 @@
 #include <napi/env.h>
 #include <Babylon/Api.h>
 
+#include <chrono>
+
 namespace Babylon::Polyfills::Scheduling
 {
+    // Timer throttling for hosts that are idle or in the background, to save
+    // CPU and battery. The default value turns throttling off.
+    struct Throttling
+    {
+        // Timeouts and intervals wait at least this long.
+        std::chrono::milliseconds MinimumDelay{0};
+
+        // Timers come due on multiples of this, so timers that are due close
+        // together, in this runtime or any other, fire on a single wakeup of the
+        // timer thread.
+        std::chrono::milliseconds Slack{0};
+    };
+
     void BABYLON_API Initialize(Napi::Env env);
+
+    // Applies to the timers set from then on, and to the next run of the
+    // intervals already set. Must be called on the JavaScript thread.
+    void BABYLON_API SetThrottling(Napi::Env env, Throttling throttling);
 }
@@ -0,0 +1,133 @@
+#include "ImmediateQueue.h"
+
+#include <algorithm>
+
+namespace Babylon::Polyfills::Internal
+{
+    namespace
+    {
+        constexpr auto JS_IMMEDIATE_QUEUE_NAME = "immediateQueue";
+
+        // Clears the immediate with the given id from a queue ordered by id.
+        template<typename QueueT>
+        bool ClearIn(QueueT& queue, int32_t id)
+        {
+            const auto it = std::lower_bound(queue.begin(), queue.end(), id, [](const auto& immediate, int32_t value) {
+                return immediate.Id < value;
+            });
+
+            if (it == queue.end() || it->Id != id)
+            {
+                return false;
+            }
+
+            it->Function.Reset();
+            it->Arguments.clear();
+            return true;
+        }
+    }
+
+    void ImmediateQueue::Initialize(Napi::Env env, Babylon::JsRuntime& runtime)
+    {
+        auto native = JsRuntime::NativeObject::GetFromJavaScript(env);
+        if (native.Get(JS_IMMEDIATE_QUEUE_NAME).IsUndefined())
+        {
+            auto* queue = new std::shared_ptr<ImmediateQueue>{std::make_shared<ImmediateQueue>(runtime)};
+            native.Set(JS_IMMEDIATE_QUEUE_NAME, Napi::External<std::shared_ptr<ImmediateQueue>>::New(env, queue, [](Napi::Env, std::shared_ptr<ImmediateQueue>* queue) { delete queue; }));
+        }
+    }
+
+    std::shared_ptr<ImmediateQueue> ImmediateQueue::GetFromJavaScript(Napi::Env env)
+    {
+        return *JsRuntime::NativeObject::GetFromJavaScript(env)
+                    .Get(JS_IMMEDIATE_QUEUE_NAME)
+                    .As<Napi::External<std::shared_ptr<ImmediateQueue>>>()
+                    .Data();
+    }
+
+    ImmediateQueue::ImmediateQueue(Babylon::JsRuntime& runtime)
+        : m_runtime{runtime}
+    {
+    }
+
+    ImmediateQueue::ImmediateId ImmediateQueue::Push(Napi::Function function, std::vector<Napi::Reference<Napi::Value>> arguments)
+    {
+        // Ids stay ascending within both queues, which Clear relies on.
+        if (m_lastId == INT32_MAX)
+        {
+            m_lastId = 0;
+        }
+
+        const ImmediateId id = ++m_lastId;
+        m_pending.push_back({id, Napi::Persistent(function), std::move(arguments)});
+        Schedule();
+        return id;
+    }
+
+    void ImmediateQueue::Clear(ImmediateId id)
+    {
+        if (!ClearIn(m_running, id))
+        {
+            ClearIn(m_pending, id);
+        }
+    }
+
+    void ImmediateQueue::Schedule()
+    {
+        if (!m_scheduled)
+        {
+            m_scheduled = true;
+            m_runtime.Dispatch([weakThis = weak_from_this()](Napi::Env env) {
+                if (auto self = weakThis.lock())
+                {
+                    self->Drain(env);
+                }
+            });
+        }
+    }
+
+    void ImmediateQueue::Drain(Napi::Env env)
+    {
+        m_scheduled = false;
+
+        // What is left over from a turn cut short by an exception runs first.
+        if (m_running.empty())
+        {
+            m_running.swap(m_pending);
+        }
+
+        while (!m_running.empty())
+        {
+            Napi::HandleScope scope{env};
+
+            Immediate immediate = std::move(m_running.front());
+            m_running.pop_front();
+            if (immediate.Function.IsEmpty())
+            {
+                continue;
+            }
+
+            std::vector<napi_value> arguments{};
+            arguments.reserve(immediate.Arguments.size());
+            for (const auto& argument : immediate.Arguments)
+            {
+                arguments.push_back(argument.Value());
+            }
+
+            try
+            {
+                immediate.Function.Call(arguments);
+            }
+            catch (...)
+            {
+                Schedule();
+                throw;
+            }
+        }
+
+        if (!m_pending.empty())
+        {
+            Schedule();
+        }
+    }
+}
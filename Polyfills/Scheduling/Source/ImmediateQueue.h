@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Babylon/JsRuntime.h>
+#include <napi/napi.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Babylon::Polyfills::Internal
+{
+    // Callbacks that run on the JavaScript thread on the next turn, without a
+    // round trip through a timer thread: backs setImmediate and MessagePort.
+    // Callbacks queued before a turn starts run together in one dispatch;
+    // callbacks they queue run in the next one.
+    class ImmediateQueue : public std::enable_shared_from_this<ImmediateQueue>
+    {
+    public:
+        using ImmediateId = int32_t;
+
+        // Creates the queue of the runtime running in `env`. Kept alive by the
+        // environment.
+        static void Initialize(Napi::Env env, Babylon::JsRuntime& runtime);
+        static std::shared_ptr<ImmediateQueue> GetFromJavaScript(Napi::Env env);
+
+        ImmediateQueue(Babylon::JsRuntime& runtime);
+
+        // Must be called on the JavaScript thread.
+        ImmediateId Push(Napi::Function function, std::vector<Napi::Reference<Napi::Value>> arguments = {});
+        void Clear(ImmediateId id);
+
+    private:
+        struct Immediate
+        {
+            ImmediateId Id;
+            Napi::FunctionReference Function;
+            std::vector<Napi::Reference<Napi::Value>> Arguments;
+        };
+
+        void Schedule();
+        void Drain(Napi::Env env);
+
+        Babylon::JsRuntime& m_runtime;
+        ImmediateId m_lastId{0};
+        bool m_scheduled{false};
+
+        // Queued for the next turn, and left to run in the current one. Both
+        // are ordered by id.
+        std::deque<Immediate> m_pending{};
+        std::deque<Immediate> m_running{};
+    };
+}
@@ -0,0 +1,295 @@
+#include "MessageChannel.h"
+
+namespace Babylon::Polyfills::Internal
+{
+    namespace
+    {
+        constexpr auto JS_MESSAGE_PORT_DELIVER_NAME = "messagePortDeliver";
+    }
+
+    void MessagePort::Initialize(Napi::Env env)
+    {
+        if (env.Global().Get(JS_MESSAGE_PORT_CONSTRUCTOR_NAME).IsUndefined())
+        {
+            // Shared by every port of the environment.
+            JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_MESSAGE_PORT_DELIVER_NAME, Napi::Function::New(env, &MessagePort::Deliver, "deliver"));
+
+            Napi::Function func = DefineClass(
+                env,
+                JS_MESSAGE_PORT_CONSTRUCTOR_NAME,
+                {
+                    InstanceMethod("postMessage", &MessagePort::PostMessage),
+                    InstanceMethod("start", &MessagePort::Start),
+                    InstanceMethod("close", &MessagePort::Close),
+                    InstanceAccessor("onmessage", &MessagePort::GetOnMessage, &MessagePort::SetOnMessage),
+                    InstanceMethod("addEventListener", &MessagePort::AddEventListener),
+                    InstanceMethod("removeEventListener", &MessagePort::RemoveEventListener),
+                });
+
+            env.Global().Set(JS_MESSAGE_PORT_CONSTRUCTOR_NAME, func);
+        }
+    }
+
+    MessagePort::MessagePort(const Napi::CallbackInfo& info)
+        : Napi::ObjectWrap<MessagePort>{info}
+        , m_queue{ImmediateQueue::GetFromJavaScript(info.Env())}
+        , m_deliver{Napi::Persistent(JsRuntime::NativeObject::GetFromJavaScript(info.Env()).Get(JS_MESSAGE_PORT_DELIVER_NAME).As<Napi::Function>())}
+    {
+    }
+
+    void MessagePort::Entangle(MessagePort& port1, MessagePort& port2)
+    {
+        port1.m_peer = Napi::Weak(port2.Value());
+        port2.m_peer = Napi::Weak(port1.Value());
+    }
+
+    void MessagePort::PostMessage(const Napi::CallbackInfo& info)
+    {
+        if (m_closed || m_peer.IsEmpty())
+        {
+            return;
+        }
+
+        const Napi::Object peer = m_peer.Value();
+        if (peer.IsEmpty())
+        {
+            return;
+        }
+
+        MessagePort::Unwrap(peer)->Enqueue(info[0]);
+    }
+
+    void MessagePort::Start(const Napi::CallbackInfo&)
+    {
+        if (m_started)
+        {
+            return;
+        }
+
+        m_started = true;
+        UpdateHeldByPeer();
+        while (!m_backlog.empty())
+        {
+            Post(m_backlog.front().Value());
+            m_backlog.pop_front();
+        }
+    }
+
+    void MessagePort::Close(const Napi::CallbackInfo&)
+    {
+        m_closed = true;
+        m_backlog.clear();
+
+        if (!m_peer.IsEmpty())
+        {
+            const Napi::Object peer = m_peer.Value();
+            if (!peer.IsEmpty())
+            {
+                MessagePort* port = MessagePort::Unwrap(peer);
+                port->m_peer.Reset();
+                port->m_heldByPeer = false;
+            }
+            m_peer.Reset();
+        }
+        m_heldByPeer = false;
+    }
+
+    Napi::Value MessagePort::GetOnMessage(const Napi::CallbackInfo&)
+    {
+        if (m_onmessage.IsEmpty())
+        {
+            return Env().Null();
+        }
+
+        return m_onmessage.Value();
+    }
+
+    void MessagePort::SetOnMessage(const Napi::CallbackInfo& info, const Napi::Value& value)
+    {
+        if (value.IsFunction())
+        {
+            m_onmessage = Napi::Persistent(value.As<Napi::Function>());
+
+            // Setting onmessage starts the port, unlike addEventListener.
+            Start(info);
+        }
+        else
+        {
+            m_onmessage.Reset();
+        }
+
+        UpdateHeldByPeer();
+    }
+
+    void MessagePort::AddEventListener(const Napi::CallbackInfo& info)
+    {
+        if (info[0].ToString().Utf8Value() != "message" || !info[1].IsFunction())
+        {
+            return;
+        }
+
+        const Napi::Function listener = info[1].As<Napi::Function>();
+        for (const auto& existing : m_listeners)
+        {
+            if (existing.Value() == listener)
+            {
+                return;
+            }
+        }
+
+        m_listeners.push_back(Napi::Persistent(listener));
+        UpdateHeldByPeer();
+    }
+
+    void MessagePort::RemoveEventListener(const Napi::CallbackInfo& info)
+    {
+        if (info[0].ToString().Utf8Value() != "message" || !info[1].IsFunction())
+        {
+            return;
+        }
+
+        const Napi::Function listener = info[1].As<Napi::Function>();
+        for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it)
+        {
+            if (it->Value() == listener)
+            {
+                m_listeners.erase(it);
+                break;
+            }
+        }
+
+        UpdateHeldByPeer();
+    }
+
+    void MessagePort::UpdateHeldByPeer()
+    {
+        const bool receiving = m_started && !m_closed && (!m_onmessage.IsEmpty() || !m_listeners.empty());
+        if (receiving == m_heldByPeer || m_peer.IsEmpty())
+        {
+            return;
+        }
+
+        const Napi::Object peer = m_peer.Value();
+        if (peer.IsEmpty())
+        {
+            return;
+        }
+
+        Napi::ObjectReference& reference = MessagePort::Unwrap(peer)->m_peer;
+        if (reference.IsEmpty())
+        {
+            return;
+        }
+
+        if (receiving)
+        {
+            reference.Ref();
+        }
+        else
+        {
+            reference.Unref();
+        }
+        m_heldByPeer = receiving;
+    }
+
+    void MessagePort::Enqueue(Napi::Value message)
+    {
+        if (m_closed)
+        {
+            return;
+        }
+
+        if (m_started)
+        {
+            Post(message);
+        }
+        else
+        {
+            m_backlog.push_back(Napi::Persistent(message));
+        }
+    }
+
+    void MessagePort::Post(Napi::Value message)
+    {
+        // The immediate holds the port as well as the message, so neither is
+        // collected before it is delivered.
+        std::vector<Napi::Reference<Napi::Value>> arguments{};
+        arguments.push_back(Napi::Persistent(Value().As<Napi::Value>()));
+        arguments.push_back(Napi::Persistent(message));
+        m_queue->Push(m_deliver.Value(), std::move(arguments));
+    }
+
+    void MessagePort::Deliver(const Napi::CallbackInfo& info)
+    {
+        MessagePort* port = MessagePort::Unwrap(info[0].As<Napi::Object>());
+        if (!port->m_closed)
+        {
+            port->Dispatch(info[1]);
+        }
+    }
+
+    void MessagePort::Dispatch(Napi::Value message)
+    {
+        Napi::Env env = Env();
+
+        Napi::Object event = Napi::Object::New(env);
+        event.Set("type", "message");
+        event.Set("data", message);
+        event.Set("target", Value());
+
+        // Copied first, since handlers may add or remove listeners.
+        std::vector<Napi::Function> handlers{};
+        handlers.reserve(m_listeners.size() + 1);
+        if (!m_onmessage.IsEmpty())
+        {
+            handlers.push_back(m_onmessage.Value());
+        }
+        for (const auto& listener : m_listeners)
+        {
+            handlers.push_back(listener.Value());
+        }
+
+        for (const auto& handler : handlers)
+        {
+            handler.Call(Value(), {event});
+        }
+    }
+
+    void MessageChannel::Initialize(Napi::Env env)
+    {
+        if (env.Global().Get(JS_MESSAGE_CHANNEL_CONSTRUCTOR_NAME).IsUndefined())
+        {
+            Napi::Function func = DefineClass(
+                env,
+                JS_MESSAGE_CHANNEL_CONSTRUCTOR_NAME,
+                {
+                    InstanceAccessor("port1", &MessageChannel::GetPort1, nullptr),
+                    InstanceAccessor("port2", &MessageChannel::GetPort2, nullptr),
+                });
+
+            env.Global().Set(JS_MESSAGE_CHANNEL_CONSTRUCTOR_NAME, func);
+        }
+    }
+
+    MessageChannel::MessageChannel(const Napi::CallbackInfo& info)
+        : Napi::ObjectWrap<MessageChannel>{info}
+    {
+        const Napi::Function portConstructor = info.Env().Global().Get(MessagePort::JS_MESSAGE_PORT_CONSTRUCTOR_NAME).As<Napi::Function>();
+        const Napi::Object port1 = portConstructor.New({});
+        const Napi::Object port2 = portConstructor.New({});
+        MessagePort::Entangle(*MessagePort::Unwrap(port1), *MessagePort::Unwrap(port2));
+
+        m_port1 = Napi::Persistent(port1);
+        m_port2 = Napi::Persistent(port2);
+    }
+
+    Napi::Value MessageChannel::GetPort1(const Napi::CallbackInfo&)
+    {
+        return m_port1.Value();
+    }
+
+    Napi::Value MessageChannel::GetPort2(const Napi::CallbackInfo&)
+    {
+        return m_port2.Value();
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "ImmediateQueue.h"
+
+#include <napi/napi.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Babylon::Polyfills::Internal
+{
+    // A pair of entangled ports, used by scheduler libraries to yield to the
+    // host without the minimum delay of setTimeout. Messages are delivered as
+    // immediates of the runtime, so they never leave the JavaScript thread.
+    // Messages are passed by reference rather than cloned. A port holds its
+    // peer strongly while the peer is started and has message handlers, so
+    // posting to a port that is still referenced always reaches the other
+    // side; otherwise it holds it weakly. Ports that both receive keep each
+    // other alive until one of them is closed.
+    class MessagePort final : public Napi::ObjectWrap<MessagePort>
+    {
+    public:
+        static constexpr auto JS_MESSAGE_PORT_CONSTRUCTOR_NAME = "MessagePort";
+
+        static void Initialize(Napi::Env env);
+        explicit MessagePort(const Napi::CallbackInfo& info);
+
+        static void Entangle(MessagePort& port1, MessagePort& port2);
+
+    private:
+        void PostMessage(const Napi::CallbackInfo& info);
+        void Start(const Napi::CallbackInfo& info);
+        void Close(const Napi::CallbackInfo& info);
+
+        Napi::Value GetOnMessage(const Napi::CallbackInfo& info);
+        void SetOnMessage(const Napi::CallbackInfo&, const Napi::Value& value);
+
+        void AddEventListener(const Napi::CallbackInfo& info);
+        void RemoveEventListener(const Napi::CallbackInfo& info);
+
+        // Queues `message` for delivery, or holds it until the port is started.
+        void Enqueue(Napi::Value message);
+        void Post(Napi::Value message);
+        static void Deliver(const Napi::CallbackInfo& info);
+        void Dispatch(Napi::Value message);
+
+        // Makes the peer's reference to this port strong while this port can
+        // receive messages, and weak again once it can't.
+        void UpdateHeldByPeer();
+
+        std::shared_ptr<ImmediateQueue> m_queue;
+        Napi::FunctionReference m_deliver;
+
+        Napi::ObjectReference m_peer;
+        bool m_heldByPeer{false};
+        bool m_started{false};
+        bool m_closed{false};
+        std::deque<Napi::Reference<Napi::Value>> m_backlog{};
+
+        Napi::FunctionReference m_onmessage;
+        std::vector<Napi::FunctionReference> m_listeners{};
+    };
+
+    class MessageChannel final : public Napi::ObjectWrap<MessageChannel>
+    {
+    public:
+        static constexpr auto JS_MESSAGE_CHANNEL_CONSTRUCTOR_NAME = "MessageChannel";
+
+        static void Initialize(Napi::Env env);
+        explicit MessageChannel(const Napi::CallbackInfo& info);
+
+    private:
+        Napi::Value GetPort1(const Napi::CallbackInfo& info);
+        Napi::Value GetPort2(const Napi::CallbackInfo& info);
+
+        Napi::ObjectReference m_port1;
+        Napi::ObjectReference m_port2;
+    };
+}
@@ -1,4 +1,5 @@
 #include "Scheduling.h"
+#include <Babylon/StartupTrace.h>
 
 namespace
 {
@@ -6,13 +7,13 @@ namespace
     constexpr auto JS_CLEAR_TIMEOUT_NAME = "clearTimeout";
     constexpr auto JS_SET_INTERVAL_NAME = "setInterval";
     constexpr auto JS_CLEAR_INTERVAL_NAME = "clearInterval";
+    constexpr auto JS_SET_IMMEDIATE_NAME = "setImmediate";
+    constexpr auto JS_CLEAR_IMMEDIATE_NAME = "clearImmediate";
+    constexpr auto JS_QUEUE_MICROTASK_NAME = "queueMicrotask";
 
     Napi::Value SetTimeout(const Napi::CallbackInfo& info, Babylon::Polyfills::Internal::TimeoutDispatcher& timeoutDispatcher, bool repeat)
     {
-        auto function =
-            info[0].IsFunction()
-                ? std::make_shared<Napi::FunctionReference>(Napi::Persistent(info[0].As<Napi::Function>()))
-                : std::shared_ptr<Napi::FunctionReference>{};
+        auto function = info[0].IsFunction() ? info[0].As<Napi::Function>() : Napi::Function{};
 
         auto delay = std::chrono::milliseconds{info[1].ToNumber().Int32Value()};
 
@@ -28,14 +29,76 @@ namespace
             timeoutDispatcher.Clear(timeoutId);
         }
     }
+
+    Napi::Value SetImmediate(const Napi::CallbackInfo& info, Babylon::Polyfills::Internal::ImmediateQueue& immediateQueue)
+    {
+        if (!info[0].IsFunction())
+        {
+            throw Napi::TypeError::New(info.Env(), "The callback must be a function");
+        }
+
+        std::vector<Napi::Reference<Napi::Value>> arguments{};
+        for (size_t i = 1; i < info.Length(); ++i)
+        {
+            arguments.push_back(Napi::Persistent(info[i]));
+        }
+
+        return Napi::Value::From(info.Env(), immediateQueue.Push(info[0].As<Napi::Function>(), std::move(arguments)));
+    }
+
+    void ClearImmediate(const Napi::CallbackInfo& info, Babylon::Polyfills::Internal::ImmediateQueue& immediateQueue)
+    {
+        const auto arg = info[0];
+        if (arg.IsNumber())
+        {
+            immediateQueue.Clear(arg.As<Napi::Number>().Int32Value());
+        }
+    }
+
+    // Receives the callback as the value the promise resolved to, so a single
+    // function serves every queueMicrotask call.
+    void RunMicrotask(const Napi::CallbackInfo& info, Babylon::JsRuntime& runtime)
+    {
+        try
+        {
+            info[0].As<Napi::Function>().Call({});
+        }
+        catch (const Napi::Error& error)
+        {
+            // Thrown from a dispatched callback so it reaches the host's unhandled
+            // exception handler, instead of silently rejecting a promise.
+            runtime.Dispatch([error](Napi::Env) {
+                throw error;
+            });
+        }
+    }
+
+    void QueueMicrotask(const Napi::CallbackInfo& info, const Napi::FunctionReference& runMicrotask)
+    {
+        if (!info[0].IsFunction())
+        {
+            throw Napi::TypeError::New(info.Env(), "The callback must be a function");
+        }
+
+        // Runs on the engine's own job queue, which AppRuntime drains after
+        // every dispatched callback.
+        auto deferred = Napi::Promise::Deferred::New(info.Env());
+        deferred.Resolve(info[0]);
+        const auto promise = deferred.Promise();
+        promise.Get("then").As<Napi::Function>().Call(promise, {runMicrotask.Value()});
+    }
 }
 
 namespace Babylon::Polyfills::Scheduling
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::Scheduling::Initialize"};
+
         auto global = env.Global();
-        auto timeoutDispatcher = std::make_shared<Internal::TimeoutDispatcher>(JsRuntime::GetFromJavaScript(env));
+        auto& runtime = JsRuntime::GetFromJavaScript(env);
+        Internal::TimeoutDispatcher::Initialize(env, runtime);
+        auto timeoutDispatcher = Internal::TimeoutDispatcher::GetFromJavaScript(env);
 
         if (global.Get(JS_SET_TIMEOUT_NAME).IsUndefined() && global.Get(JS_CLEAR_TIMEOUT_NAME).IsUndefined())
         {
@@ -70,5 +133,49 @@ namespace Babylon::Polyfills::Scheduling
                     },
                     JS_CLEAR_INTERVAL_NAME));
         }
+
+        Internal::ImmediateQueue::Initialize(env, runtime);
+        auto immediateQueue = Internal::ImmediateQueue::GetFromJavaScript(env);
+
+        if (global.Get(JS_SET_IMMEDIATE_NAME).IsUndefined() && global.Get(JS_CLEAR_IMMEDIATE_NAME).IsUndefined())
+        {
+            global.Set(JS_SET_IMMEDIATE_NAME,
+                Napi::Function::New(
+                    env, [immediateQueue](const Napi::CallbackInfo& info) {
+                        return SetImmediate(info, *immediateQueue);
+                    },
+                    JS_SET_IMMEDIATE_NAME));
+
+            global.Set(JS_CLEAR_IMMEDIATE_NAME,
+                Napi::Function::New(
+                    env, [immediateQueue](const Napi::CallbackInfo& info) {
+                        ClearImmediate(info, *immediateQueue);
+                    },
+                    JS_CLEAR_IMMEDIATE_NAME));
+        }
+
+        if (global.Get(JS_QUEUE_MICROTASK_NAME).IsUndefined())
+        {
+            auto runMicrotask = std::make_shared<Napi::FunctionReference>(Napi::Persistent(Napi::Function::New(
+                env, [&runtime](const Napi::CallbackInfo& info) {
+                    RunMicrotask(info, runtime);
+                },
+                "runMicrotask")));
+
+            global.Set(JS_QUEUE_MICROTASK_NAME,
+                Napi::Function::New(
+                    env, [runMicrotask](const Napi::CallbackInfo& info) {
+                        QueueMicrotask(info, *runMicrotask);
+                    },
+                    JS_QUEUE_MICROTASK_NAME));
+        }
+
+        Internal::MessagePort::Initialize(env);
+        Internal::MessageChannel::Initialize(env);
+    }
+
+    void BABYLON_API SetThrottling(Napi::Env env, Throttling throttling)
+    {
+        Internal::TimeoutDispatcher::GetFromJavaScript(env)->SetThrottling(throttling);
     }
 }
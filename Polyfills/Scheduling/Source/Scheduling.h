@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ImmediateQueue.h"
+#include "MessageChannel.h"
 #include "TimeoutDispatcher.h"
 
 #include <Babylon/JsRuntime.h>
@@ -1,198 +1,116 @@
 #include "TimeoutDispatcher.h"
 
-#include <cassert>
-#include <optional>
-
 namespace Babylon::Polyfills::Internal
 {
     namespace
     {
-        using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::microseconds>;
-
-        TimePoint Now()
-        {
-            return std::chrono::time_point_cast<std::chrono::microseconds, std::chrono::steady_clock>(std::chrono::steady_clock::now());
-        }
+        constexpr auto JS_TIMEOUT_DISPATCHER_NAME = "timeoutDispatcher";
     }
 
-    struct TimeoutDispatcher::Timeout
+    void TimeoutDispatcher::Initialize(Napi::Env env, Babylon::JsRuntime& runtime)
     {
-        TimeoutId id;
-
-        // Make this non-shared when JsRuntime::Dispatch supports it.
-        std::shared_ptr<Napi::FunctionReference> function;
-
-        TimePoint time;
-
-        std::optional<std::chrono::milliseconds> interval;
-
-        Timeout(TimeoutId id, std::shared_ptr<Napi::FunctionReference> function, TimePoint time, std::optional<std::chrono::milliseconds> interval)
-            : id{id}
-            , function{std::move(function)}
-            , time{time}
-            , interval{interval}
+        auto native = JsRuntime::NativeObject::GetFromJavaScript(env);
+        if (native.Get(JS_TIMEOUT_DISPATCHER_NAME).IsUndefined())
         {
+            auto* dispatcher = new std::shared_ptr<TimeoutDispatcher>{std::make_shared<TimeoutDispatcher>(runtime)};
+            native.Set(JS_TIMEOUT_DISPATCHER_NAME, Napi::External<std::shared_ptr<TimeoutDispatcher>>::New(env, dispatcher, [](Napi::Env, std::shared_ptr<TimeoutDispatcher>* dispatcher) { delete dispatcher; }));
         }
+    }
 
-        Timeout(const Timeout&) = delete;
-        Timeout(Timeout&&) = delete;
-    };
+    std::shared_ptr<TimeoutDispatcher> TimeoutDispatcher::GetFromJavaScript(Napi::Env env)
+    {
+        return *JsRuntime::NativeObject::GetFromJavaScript(env)
+                    .Get(JS_TIMEOUT_DISPATCHER_NAME)
+                    .As<Napi::External<std::shared_ptr<TimeoutDispatcher>>>()
+                    .Data();
+    }
 
     TimeoutDispatcher::TimeoutDispatcher(Babylon::JsRuntime& runtime)
         : m_runtime{runtime}
-        , m_thread{std::thread{&TimeoutDispatcher::ThreadFunction, this}}
+        , m_service{TimerService::Get()}
     {
     }
 
     TimeoutDispatcher::~TimeoutDispatcher()
     {
-        {
-            std::unique_lock<std::recursive_mutex> lk{m_mutex};
-            m_idMap.clear();
-            m_timeMap.clear();
-        }
-
-        m_shutdown = true;
-        m_condVariable.notify_one();
-        m_thread.join();
+        m_service->Remove(*this);
     }
 
-    TimeoutDispatcher::TimeoutId TimeoutDispatcher::Dispatch(std::shared_ptr<Napi::FunctionReference> function, std::chrono::milliseconds delay, bool repeat)
+    TimeoutDispatcher::TimeoutId TimeoutDispatcher::Dispatch(Napi::Function function, std::chrono::milliseconds delay, bool repeat)
     {
-        return DispatchImpl(function, delay, repeat, 0);
+        Napi::FunctionReference reference = function.IsEmpty() ? Napi::FunctionReference{} : Napi::Persistent(function);
+        return m_service->Add(*this, std::move(reference), delay, repeat, m_throttling);
     }
 
-    TimeoutDispatcher::TimeoutId TimeoutDispatcher::DispatchImpl(std::shared_ptr<Napi::FunctionReference> function, std::chrono::milliseconds delay, bool repeat, TimeoutId id)
+    void TimeoutDispatcher::Clear(TimeoutId id)
     {
-        if (delay.count() < 0)
-        {
-            delay = std::chrono::milliseconds{0};
-        }
-
-        std::unique_lock<std::recursive_mutex> lk{m_mutex};
-
-        if (id == 0)
-        {
-            id = NextTimeoutId();
-        }
-        const auto earliestTime = m_timeMap.empty() ? TimePoint::max() : m_timeMap.cbegin()->second->time;
-        const auto time = Now() + delay;
-        const auto result = m_idMap.insert({id, std::make_unique<Timeout>(id, std::move(function), time, repeat ? std::make_optional<std::chrono::milliseconds>(delay) : std::nullopt)});
-        m_timeMap.insert({time, result.first->second.get()});
-
-        if (time <= earliestTime)
-        {
-            m_condVariable.notify_one();
-        }
+        m_service->Clear(*this, id);
+    }
 
-        return id;
+    void TimeoutDispatcher::SetThrottling(Scheduling::Throttling throttling)
+    {
+        m_throttling = throttling;
     }
 
-    void TimeoutDispatcher::Clear(TimeoutId id)
+    void TimeoutDispatcher::Post(std::vector<TimerService::Due> due)
     {
-        std::unique_lock<std::recursive_mutex> lk{m_mutex};
-        const auto itId = m_idMap.find(id);
-        if (itId != m_idMap.end())
         {
-            const auto& timeout = itId->second;
-            const auto timeRange = m_timeMap.equal_range(timeout->time);
-
-            // Remove any pending entries that have not yet been dispatched.
-            for (auto itTime = timeRange.first; itTime != timeRange.second; itTime++)
+            std::scoped_lock lock{m_mutex};
+            m_due.insert(m_due.end(), due.begin(), due.end());
+            if (m_posted)
             {
-                if (itTime->second->id == id)
-                {
-                    m_timeMap.erase(itTime);
-                    break;
-                }
+                return;
             }
-
-            m_idMap.erase(itId);
+            m_posted = true;
         }
+
+        Schedule();
     }
 
-    TimeoutDispatcher::TimeoutId TimeoutDispatcher::NextTimeoutId()
+    void TimeoutDispatcher::Schedule()
     {
-        while (true)
-        {
-            ++m_lastTimeoutId;
-
-            if (m_lastTimeoutId <= 0)
-            {
-                m_lastTimeoutId = 1;
-            }
-
-            if (m_idMap.find(m_lastTimeoutId) == m_idMap.end())
+        m_runtime.Dispatch([weakThis = weak_from_this()](Napi::Env env) {
+            if (auto self = weakThis.lock())
             {
-                return m_lastTimeoutId;
+                self->Fire(env);
             }
-        }
+        });
     }
 
-    void TimeoutDispatcher::ThreadFunction()
+    void TimeoutDispatcher::Fire(Napi::Env env)
     {
-        while (!m_shutdown)
+        // One timer per dispatch, so the microtasks each callback queues run
+        // before the next timer fires, as in a browser. The rest of the batch
+        // is queued again up front, so it still fires if this callback throws.
+        std::optional<TimerService::Due> due{};
+        bool more{};
         {
-            std::unique_lock<std::recursive_mutex> lk{m_mutex};
-            TimePoint nextTimePoint{};
-
-            while (!m_timeMap.empty())
+            std::scoped_lock lock{m_mutex};
+            if (m_due.empty())
             {
-                nextTimePoint = m_timeMap.begin()->second->time;
-                if (nextTimePoint <= Now())
-                {
-                    break;
-                }
-
-                m_condVariable.wait_until(lk, nextTimePoint);
+                m_posted = false;
+                return;
             }
 
-            while (!m_timeMap.empty() && m_timeMap.begin()->second->time == nextTimePoint)
-            {
-                const auto id = m_timeMap.begin()->second->id;
-                m_timeMap.erase(m_timeMap.begin());
-                const auto repeat = m_idMap[id]->interval.has_value();
-                if (repeat)
-                {
-                    const auto timeout = std::move(m_idMap.extract(id).mapped());
-                    DispatchImpl(std::move(timeout->function), *timeout->interval, true, timeout->id);
-                }
-                CallFunction(id);
-            }
+            due.emplace(m_due.front());
+            m_due.erase(m_due.begin());
+            more = !m_due.empty();
+            m_posted = more;
+        }
 
-            while (!m_shutdown && m_timeMap.empty())
-            {
-                m_condVariable.wait(lk);
-            }
+        if (more)
+        {
+            Schedule();
         }
-    }
 
-    void TimeoutDispatcher::CallFunction(TimeoutId id)
-    {
-        m_runtime.Dispatch([id, this](Napi::Env) {
-            std::shared_ptr<Napi::FunctionReference> function{};
-            {
-                std::unique_lock<std::recursive_mutex> lk{m_mutex};
-                const auto it = m_idMap.find(id);
-                if (it != m_idMap.end())
-                {
-                    const auto repeat = it->second->interval.has_value();
-                    if (repeat)
-                    {
-                        function = it->second->function;
-                    }
-                    else
-                    {
-                        const auto timeout = std::move(m_idMap.extract(id).mapped());
-                        function = std::move(timeout->function);
-                    }
-                }
-            }
+        Napi::HandleScope scope{env};
 
-            if (function)
-            {
-                function->Call({});
-            }
-        });
+        // The local handle keeps the function alive even if the callback
+        // clears its own interval.
+        const Napi::Function function = m_service->Take(*due, m_throttling);
+        if (!function.IsEmpty())
+        {
+            function.Call({});
+        }
     }
 }
@@ -1,46 +1,72 @@
 #pragma once
 
+#include "TimerService.h"
+
 #include <Babylon/JsRuntime.h>
+#include <Babylon/Polyfills/Scheduling.h>
 #include <napi/napi.h>
 
-#include <atomic>
 #include <chrono>
-#include <condition_variable>
-#include <map>
-#include <unordered_map>
 #include <cstdint>
-#include <thread>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace Babylon::Polyfills::Internal
 {
-    class TimeoutDispatcher
+    // The timers of one runtime. They are kept by the process-wide
+    // TimerService, which hands the ones that expire back to be fired on the
+    // runtime's JavaScript thread.
+    //
+    // Expired timers fire one per dispatch, so that the microtasks of each
+    // run before the next. At most one such dispatch is queued on the runtime
+    // at a time; timers that expire before it runs wait behind it. Together with intervals
+    // staying out of the TimerService until they fire, this keeps a runtime
+    // that is suspended from piling up stale callbacks: on resume each expired
+    // timeout fires once and each interval fires once.
+    class TimeoutDispatcher : public std::enable_shared_from_this<TimeoutDispatcher>
     {
-        using TimeoutId = int32_t;
-        struct Timeout;
+        using TimeoutId = TimerService::TimeoutId;
 
     public:
+        // Creates the dispatcher of the runtime running in `env`. Kept alive by
+        // the environment.
+        static void Initialize(Napi::Env env, Babylon::JsRuntime& runtime);
+        static std::shared_ptr<TimeoutDispatcher> GetFromJavaScript(Napi::Env env);
+
         TimeoutDispatcher(Babylon::JsRuntime& runtime);
         ~TimeoutDispatcher();
 
-        TimeoutId Dispatch(std::shared_ptr<Napi::FunctionReference> function, std::chrono::milliseconds delay, bool repeat = false);
+        // `function` may be empty, in which case the timer fires without calling
+        // anything. Returns 0 if no more timers can be created.
+        TimeoutId Dispatch(Napi::Function function, std::chrono::milliseconds delay, bool repeat = false);
         void Clear(TimeoutId id);
 
+        // Must be called on the JavaScript thread.
+        void SetThrottling(Scheduling::Throttling throttling);
+
     private:
-        using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::microseconds>;
+        friend class TimerService;
 
-        TimeoutId DispatchImpl(std::shared_ptr<Napi::FunctionReference> function, std::chrono::milliseconds delay, bool repeat, TimeoutId id);
+        // Called by the TimerService's thread with the timers that expired,
+        // ordered by expiry and then creation order.
+        void Post(std::vector<TimerService::Due> due);
 
-        TimeoutId NextTimeoutId();
-        void ThreadFunction();
-        void CallFunction(TimeoutId id);
+        // Queues the dispatch that fires the next expired timer.
+        void Schedule();
+
+        void Fire(Napi::Env env);
 
         Babylon::JsRuntime& m_runtime;
-        std::recursive_mutex m_mutex{};
-        std::condition_variable_any m_condVariable{};
-        TimeoutId m_lastTimeoutId{0};
-        std::unordered_map<TimeoutId, std::unique_ptr<Timeout>> m_idMap;
-        std::multimap<TimePoint, Timeout*> m_timeMap;
-        std::atomic<bool> m_shutdown{false};
-        std::thread m_thread;
+        std::shared_ptr<TimerService> m_service;
+
+        // Only used on the JavaScript thread.
+        Scheduling::Throttling m_throttling{};
+
+        // Expired timers waiting for the queued dispatch to fire them in turn.
+        std::mutex m_mutex{};
+        std::vector<TimerService::Due> m_due{};
+        bool m_posted{false};
     };
 }
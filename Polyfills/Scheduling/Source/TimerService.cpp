@@ -0,0 +1,421 @@
+#include "TimerService.h"
+#include "TimeoutDispatcher.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <functional>
+
+namespace Babylon::Polyfills::Internal
+{
+    std::shared_ptr<TimerService> TimerService::Get()
+    {
+        static std::mutex mutex{};
+        static std::weak_ptr<TimerService> instance{};
+
+        std::scoped_lock lock{mutex};
+        auto service = instance.lock();
+        if (!service)
+        {
+            service = std::make_shared<TimerService>();
+            instance = service;
+        }
+        return service;
+    }
+
+    TimerService::TimerService()
+        : m_thread{std::thread{&TimerService::ThreadFunction, this}}
+    {
+    }
+
+    TimerService::~TimerService()
+    {
+        {
+            std::scoped_lock lock{m_mutex};
+            m_shutdown = true;
+        }
+
+        m_condVariable.notify_one();
+        m_thread.join();
+    }
+
+    TimerService::TimeoutId TimerService::Add(TimeoutDispatcher& owner, Napi::FunctionReference function, std::chrono::milliseconds delay, bool repeat, const Scheduling::Throttling& throttling)
+    {
+        if (delay.count() < 0)
+        {
+            delay = std::chrono::milliseconds{0};
+        }
+
+        std::unique_lock lock{m_mutex};
+
+        const uint32_t index = Allocate();
+        if (index == None)
+        {
+            return 0;
+        }
+
+        Timer& timer = m_timers[index];
+        timer.Owner = &owner;
+        timer.Function = std::move(function);
+        timer.Interval = std::max<Tick>(static_cast<Tick>(delay.count()), 1);
+        timer.Repeat = repeat;
+
+        const TimeoutId id = static_cast<TimeoutId>((timer.Generation << IndexBits) | index);
+        const bool wake = Arm(index, static_cast<Tick>(delay.count()), throttling);
+        lock.unlock();
+
+        if (wake)
+        {
+            m_condVariable.notify_one();
+        }
+
+        return id;
+    }
+
+    void TimerService::Clear(TimeoutDispatcher& owner, TimeoutId id)
+    {
+        if (id <= 0)
+        {
+            return;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(id) & (MaxTimers - 1);
+        const uint32_t generation = static_cast<uint32_t>(id) >> IndexBits;
+
+        std::scoped_lock lock{m_mutex};
+        if (index < m_timers.size() && m_timers[index].Generation == generation && m_timers[index].Owner == &owner)
+        {
+            Release(index);
+        }
+    }
+
+    void TimerService::Remove(TimeoutDispatcher& owner)
+    {
+        std::scoped_lock lock{m_mutex};
+        for (uint32_t index = 0; index < m_timers.size(); ++index)
+        {
+            if (m_timers[index].Owner == &owner)
+            {
+                Release(index);
+            }
+        }
+    }
+
+    Napi::Function TimerService::Take(const Due& due, const Scheduling::Throttling& throttling)
+    {
+        std::unique_lock lock{m_mutex};
+        Timer& timer = m_timers[due.Index];
+        if (timer.Generation != due.Generation)
+        {
+            // Cleared since it expired.
+            return {};
+        }
+
+        Napi::Function function{};
+        if (!timer.Function.IsEmpty())
+        {
+            function = timer.Function.Value();
+        }
+
+        bool wake = false;
+        if (!timer.Repeat)
+        {
+            Release(due.Index);
+        }
+        else if (timer.Slot == None)
+        {
+            // Rescheduled from now rather than from the expiry, so an interval
+            // that fell behind fires once instead of catching up.
+            wake = Arm(due.Index, timer.Interval, throttling);
+        }
+        lock.unlock();
+
+        if (wake)
+        {
+            m_condVariable.notify_one();
+        }
+
+        return function;
+    }
+
+    TimerService::Tick TimerService::CurrentTick() const
+    {
+        return static_cast<Tick>(std::chrono::floor<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+    bool TimerService::Arm(uint32_t index, Tick delay, const Scheduling::Throttling& throttling)
+    {
+        // The timer thread stops advancing the wheel while it is empty.
+        if (m_armed == 0)
+        {
+            m_currentTick = std::max(m_currentTick, CurrentTick());
+        }
+
+        if (throttling.MinimumDelay.count() > 0)
+        {
+            delay = std::max(delay, static_cast<Tick>(throttling.MinimumDelay.count()));
+        }
+
+        // Rounded up so the timer never fires before the delay has fully elapsed.
+        const auto elapsed = std::chrono::ceil<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start);
+        Tick expiry = static_cast<Tick>(elapsed.count()) + delay;
+
+        if (throttling.Slack.count() > 0)
+        {
+            const Tick slack = static_cast<Tick>(throttling.Slack.count());
+            expiry = (expiry + slack - 1) / slack * slack;
+        }
+
+        Timer& timer = m_timers[index];
+        timer.Expiry = expiry;
+        timer.Sequence = m_nextSequence++;
+        Insert(index);
+
+        return timer.Expiry < m_wakeTick;
+    }
+
+    uint32_t TimerService::Allocate()
+    {
+        if (m_freeList != None)
+        {
+            const uint32_t index = m_freeList;
+            m_freeList = m_timers[index].Next;
+            m_timers[index].Next = None;
+            return index;
+        }
+
+        if (m_timers.size() == MaxTimers)
+        {
+            return None;
+        }
+
+        m_timers.emplace_back();
+        return static_cast<uint32_t>(m_timers.size() - 1);
+    }
+
+    void TimerService::Release(uint32_t index)
+    {
+        Timer& timer = m_timers[index];
+        if (timer.Slot != None)
+        {
+            Unlink(index);
+        }
+
+        timer.Owner = nullptr;
+        timer.Function.Reset();
+        timer.Generation = timer.Generation + 1 == GenerationCount ? 1 : timer.Generation + 1;
+        timer.Next = m_freeList;
+        m_freeList = index;
+    }
+
+    void TimerService::Insert(uint32_t index)
+    {
+        Timer& timer = m_timers[index];
+        const Tick expiry = std::max(timer.Expiry, m_currentTick);
+        const Tick delta = expiry - m_currentTick;
+
+        uint32_t level = 0;
+        while (level + 1 < LevelCount && delta >= (Tick{1} << (SlotBits * (level + 1))))
+        {
+            ++level;
+        }
+
+        const uint32_t slot = static_cast<uint32_t>(expiry >> (SlotBits * level)) & (SlotCount - 1);
+        Slot& list = m_slots[level * SlotCount + slot];
+
+        timer.Slot = level * SlotCount + slot;
+        timer.Previous = list.Tail;
+        timer.Next = None;
+        if (list.Tail != None)
+        {
+            m_timers[list.Tail].Next = index;
+        }
+        else
+        {
+            list.Head = index;
+        }
+        list.Tail = index;
+
+        m_occupied[level] |= uint64_t{1} << slot;
+        ++m_armed;
+    }
+
+    void TimerService::Unlink(uint32_t index)
+    {
+        Timer& timer = m_timers[index];
+        Slot& list = m_slots[timer.Slot];
+
+        if (timer.Previous != None)
+        {
+            m_timers[timer.Previous].Next = timer.Next;
+        }
+        else
+        {
+            list.Head = timer.Next;
+        }
+
+        if (timer.Next != None)
+        {
+            m_timers[timer.Next].Previous = timer.Previous;
+        }
+        else
+        {
+            list.Tail = timer.Previous;
+        }
+
+        if (list.Head == None)
+        {
+            m_occupied[timer.Slot / SlotCount] &= ~(uint64_t{1} << (timer.Slot % SlotCount));
+        }
+
+        timer.Previous = None;
+        timer.Next = None;
+        timer.Slot = None;
+        --m_armed;
+    }
+
+    void TimerService::Cascade(uint32_t level, uint32_t slot)
+    {
+        Slot& list = m_slots[level * SlotCount + slot];
+        uint32_t index = list.Head;
+        list = {};
+        m_occupied[level] &= ~(uint64_t{1} << slot);
+
+        while (index != None)
+        {
+            const uint32_t next = m_timers[index].Next;
+            m_timers[index].Slot = None;
+            --m_armed;
+            Insert(index);
+            index = next;
+        }
+    }
+
+    void TimerService::Advance(Tick now, std::vector<Due>& due)
+    {
+        while (m_currentTick <= now)
+        {
+            if (m_armed == 0)
+            {
+                m_currentTick = now + 1;
+                break;
+            }
+
+            // Each time level 0 wraps around, the next slot of level 1 is moved
+            // down, and so on up the levels.
+            const uint32_t slot = static_cast<uint32_t>(m_currentTick) & (SlotCount - 1);
+            if (slot == 0)
+            {
+                for (uint32_t level = 1; level < LevelCount; ++level)
+                {
+                    const uint32_t upperSlot = static_cast<uint32_t>(m_currentTick >> (SlotBits * level)) & (SlotCount - 1);
+                    Cascade(level, upperSlot);
+                    if (upperSlot != 0)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            Slot& list = m_slots[slot];
+            while (list.Head != None)
+            {
+                const uint32_t index = list.Head;
+                Unlink(index);
+
+                // Intervals stay out of the wheel until their owner takes them.
+                Timer& timer = m_timers[index];
+                due.push_back({timer.Owner, index, timer.Generation, timer.Expiry, timer.Sequence});
+            }
+
+            // Skip the empty slots up to the next timer or the next cascade,
+            // whichever comes first.
+            const uint64_t ahead = slot + 1 < SlotCount ? m_occupied[0] & (~uint64_t{0} << (slot + 1)) : 0;
+            const Tick blockStart = m_currentTick - slot;
+            const Tick next = ahead != 0 ? blockStart + std::countr_zero(ahead) : blockStart + SlotCount;
+            m_currentTick = std::min(next, now + 1);
+        }
+    }
+
+    TimerService::Tick TimerService::NextEventTick() const
+    {
+        if (m_armed == 0)
+        {
+            return Never;
+        }
+
+        const uint32_t slot = static_cast<uint32_t>(m_currentTick) & (SlotCount - 1);
+        const Tick blockStart = m_currentTick - slot;
+        const uint64_t ahead = m_occupied[0] & (~uint64_t{0} << slot);
+        if (ahead != 0)
+        {
+            return blockStart + std::countr_zero(ahead);
+        }
+
+        // Level 0 slots behind the current one belong to the next block.
+        Tick next = m_occupied[0] != 0 ? blockStart + SlotCount + std::countr_zero(m_occupied[0]) : Never;
+
+        // A slot of an upper level is moved down at the first tick that is a
+        // multiple of the level's span and maps to that slot.
+        for (uint32_t level = 1; level < LevelCount; ++level)
+        {
+            if (m_occupied[level] == 0)
+            {
+                continue;
+            }
+
+            const uint32_t shift = SlotBits * level;
+            const Tick boundary = (m_currentTick + (Tick{1} << shift) - 1) >> shift;
+            const uint64_t rotated = std::rotr(m_occupied[level], static_cast<int>(boundary & (SlotCount - 1)));
+            next = std::min(next, (boundary + std::countr_zero(rotated)) << shift);
+        }
+
+        return next;
+    }
+
+    void TimerService::ThreadFunction()
+    {
+        std::unique_lock lock{m_mutex};
+        while (!m_shutdown)
+        {
+            m_wakeTick = 0;
+
+            std::vector<Due> due{};
+            Advance(CurrentTick(), due);
+            if (!due.empty())
+            {
+                std::sort(due.begin(), due.end(), [](const Due& a, const Due& b) {
+                    if (a.Owner != b.Owner)
+                    {
+                        return std::less<>{}(a.Owner, b.Owner);
+                    }
+                    return a.Expiry != b.Expiry ? a.Expiry < b.Expiry : a.Sequence < b.Sequence;
+                });
+
+                // Posted with the lock held, since that is what keeps an owner from
+                // being destroyed (see Remove) in the meantime. Posting only queues
+                // work on the owner's runtime.
+                auto begin = due.begin();
+                while (begin != due.end())
+                {
+                    auto end = std::find_if(begin, due.end(), [owner = begin->Owner](const Due& entry) {
+                        return entry.Owner != owner;
+                    });
+                    begin->Owner->Post({begin, end});
+                    begin = end;
+                }
+                continue;
+            }
+
+            m_wakeTick = NextEventTick();
+            if (m_wakeTick == Never)
+            {
+                m_condVariable.wait(lock);
+            }
+            else
+            {
+                m_condVariable.wait_until(lock, m_start + std::chrono::milliseconds{m_wakeTick});
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <Babylon/Polyfills/Scheduling.h>
+#include <napi/napi.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Babylon::Polyfills::Internal
+{
+    class TimeoutDispatcher;
+
+    // Process-wide timer thread shared by the TimeoutDispatchers of every
+    // runtime, so a process hosting many runtimes still has a single thread
+    // sleeping on timers.
+    //
+    // Timers are kept in a hierarchical timing wheel with millisecond ticks:
+    // level 0 has a slot per tick for the next 64 ticks, and each level above
+    // covers 64 times the span of the one below. Timers are moved down a level
+    // each time their slot comes around, so adding, clearing and expiring a
+    // timer are all O(1). Timer records are pooled, and the timers that come
+    // due when the thread wakes up are handed to each owner in one batch.
+    //
+    // An interval is taken out of the wheel when it comes due and put back
+    // once its owner takes it to run the callback, so an owner that can't run
+    // callbacks for a while (e.g. a suspended runtime) has at most one firing
+    // of each interval pending, and the thread doesn't keep waking up for it.
+    class TimerService
+    {
+    public:
+        using TimeoutId = int32_t;
+
+        struct Due
+        {
+            TimeoutDispatcher* Owner;
+            uint32_t Index;
+            uint32_t Generation;
+            uint64_t Expiry;
+            uint64_t Sequence;
+        };
+
+        // The running service, started if there is none. It stops once the last
+        // reference is released.
+        static std::shared_ptr<TimerService> Get();
+
+        TimerService();
+        ~TimerService();
+
+        TimerService(const TimerService&) = delete;
+        TimerService& operator=(const TimerService&) = delete;
+
+        // `function` may be empty, in which case the timer fires without calling
+        // anything. Returns 0 if no more timers can be created.
+        TimeoutId Add(TimeoutDispatcher& owner, Napi::FunctionReference function, std::chrono::milliseconds delay, bool repeat, const Scheduling::Throttling& throttling);
+        void Clear(TimeoutDispatcher& owner, TimeoutId id);
+
+        // Drops every timer of `owner`. Must be called on its JavaScript thread.
+        void Remove(TimeoutDispatcher& owner);
+
+        // Called on the owner's JavaScript thread for a timer it was handed.
+        // Returns the function to call, which is empty if the timer has been
+        // cleared since or has no function. One-shot timers are released, and
+        // intervals are put back in the wheel with the given throttling.
+        Napi::Function Take(const Due& due, const Scheduling::Throttling& throttling);
+
+    private:
+        using Tick = uint64_t;
+
+        static constexpr uint32_t SlotBits{6};
+        static constexpr uint32_t SlotCount{1 << SlotBits};
+        // Enough levels to cover the longest delay an int32 can hold.
+        static constexpr uint32_t LevelCount{6};
+        static constexpr uint32_t None{UINT32_MAX};
+        static constexpr Tick Never{UINT64_MAX};
+
+        // Ids hold the index of the timer record in their low bits and the
+        // record's generation in the high bits, so an id that outlives its timer
+        // doesn't match the record once it is reused.
+        static constexpr uint32_t IndexBits{22};
+        static constexpr uint32_t MaxTimers{1 << IndexBits};
+        static constexpr uint32_t GenerationCount{1u << (31 - IndexBits)};
+
+        struct Timer
+        {
+            TimeoutDispatcher* Owner{};
+            Napi::FunctionReference Function{};
+            Tick Expiry{};
+            // Breaks ties between timers that expire on the same tick.
+            uint64_t Sequence{};
+            // The delay the timer was set with, before any throttling.
+            Tick Interval{};
+            uint32_t Generation{1};
+            // Neighbors in the slot list (or the free list), and the slot the
+            // timer is in. Slot is None while the timer isn't in the wheel.
+            uint32_t Previous{None};
+            uint32_t Next{None};
+            uint32_t Slot{None};
+            bool Repeat{};
+        };
+
+        struct Slot
+        {
+            uint32_t Head{None};
+            uint32_t Tail{None};
+        };
+
+        Tick CurrentTick() const;
+
+        // Puts a timer in the wheel to expire `delay` ticks from now. Returns
+        // whether the timer thread needs waking up to honor it.
+        bool Arm(uint32_t index, Tick delay, const Scheduling::Throttling& throttling);
+
+        uint32_t Allocate();
+        void Release(uint32_t index);
+        void Insert(uint32_t index);
+        void Unlink(uint32_t index);
+
+        // Moves the timers in a slot of an upper level down to the levels below.
+        void Cascade(uint32_t level, uint32_t slot);
+        // Processes the ticks up to and including `now`, collecting the timers
+        // that expire.
+        void Advance(Tick now, std::vector<Due>& due);
+        // The first tick that needs processing, or Never when the wheel is empty.
+        Tick NextEventTick() const;
+
+        void ThreadFunction();
+
+        const std::chrono::steady_clock::time_point m_start{std::chrono::steady_clock::now()};
+
+        std::mutex m_mutex{};
+        std::condition_variable m_condVariable{};
+
+        std::vector<Timer> m_timers{};
+        uint32_t m_freeList{None};
+        std::array<Slot, SlotCount * LevelCount> m_slots{};
+        // Which slots of each level hold timers.
+        std::array<uint64_t, LevelCount> m_occupied{};
+        size_t m_armed{};
+        uint64_t m_nextSequence{};
+        // The next tick to process.
+        Tick m_currentTick{};
+        // The tick the timer thread is sleeping until, or 0 while it is awake.
+        Tick m_wakeTick{};
+
+        bool m_shutdown{false};
+        std::thread m_thread;
+    };
+}
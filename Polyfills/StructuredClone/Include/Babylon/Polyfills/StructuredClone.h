@@ -0,0 +1,43 @@
+#pragma once
+
+#include <napi/env.h>
+#include <Babylon/Api.h>
+
+#include <memory>
+
+namespace Babylon::Polyfills::StructuredClone
+{
+    // A value serialized with the structured clone algorithm. It holds no
+    // JavaScript values, so it can be moved to another thread and deserialized
+    // in a different runtime.
+    class SerializedValue
+    {
+    public:
+        class Impl;
+
+        SerializedValue();
+        explicit SerializedValue(std::unique_ptr<Impl> impl);
+        ~SerializedValue();
+
+        SerializedValue(SerializedValue&&) noexcept;
+        SerializedValue& operator=(SerializedValue&&) noexcept;
+
+        Impl& GetImpl() const;
+
+    private:
+        std::unique_ptr<Impl> m_impl;
+    };
+
+    // Defines the global structuredClone function.
+    void BABYLON_API Initialize(Napi::Env env);
+
+    // Serializes `value`. `transfer` is undefined or an array of ArrayBuffers to
+    // move into the result instead of copying them; they are detached where the
+    // engine supports it. Throws an error named DataCloneError for values that
+    // can't be cloned.
+    SerializedValue BABYLON_API Serialize(Napi::Value value, Napi::Value transfer);
+
+    // Recreates a serialized value in `env`. Each SerializedValue can only be
+    // deserialized once.
+    Napi::Value BABYLON_API Deserialize(Napi::Env env, SerializedValue value);
+}
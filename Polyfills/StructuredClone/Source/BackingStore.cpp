@@ -0,0 +1,167 @@
+#include "BackingStore.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace Babylon::Polyfills::Internal
+{
+    // The finalize hint of an exposed buffer. A buffer whose memory is stolen
+    // is still finalized once it is detached (on some engines long after, and
+    // on another thread), so the exposure records whether the memory is still
+    // its to free.
+    struct BackingStore::Exposure
+    {
+        std::byte* Data;
+        size_t Size;
+        bool Stolen;
+    };
+
+    namespace
+    {
+        // The memory of every exposed buffer that hasn't been stolen, by address.
+        struct Registry
+        {
+            std::mutex Mutex{};
+            std::unordered_map<const void*, void*> Exposures{};
+        };
+
+        Registry& GetRegistry()
+        {
+            static Registry registry{};
+            return registry;
+        }
+    }
+
+    std::unique_ptr<BackingStore> BackingStore::Copy(Napi::ArrayBuffer buffer)
+    {
+        const size_t size = buffer.ByteLength();
+        auto* data = size == 0 ? nullptr : static_cast<std::byte*>(std::malloc(size));
+        if (size != 0 && data == nullptr)
+        {
+            throw Napi::Error::New(buffer.Env(), "Out of memory cloning an ArrayBuffer");
+        }
+
+        if (size != 0)
+        {
+            std::memcpy(data, buffer.Data(), size);
+        }
+
+        return std::unique_ptr<BackingStore>{new BackingStore{data, size, nullptr}};
+    }
+
+    std::unique_ptr<BackingStore> BackingStore::Take(Napi::ArrayBuffer buffer)
+    {
+        auto contents = buffer.TakeContents();
+        if (!contents)
+        {
+            return nullptr;
+        }
+
+        return std::unique_ptr<BackingStore>{new BackingStore{std::move(contents)}};
+    }
+
+    std::unique_ptr<BackingStore> BackingStore::Steal(Napi::ArrayBuffer buffer)
+    {
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{registry.Mutex};
+
+        const auto it = registry.Exposures.find(buffer.Data());
+        if (it == registry.Exposures.end())
+        {
+            return nullptr;
+        }
+
+        auto* exposure = static_cast<Exposure*>(it->second);
+        if (exposure->Size != buffer.ByteLength())
+        {
+            return nullptr;
+        }
+
+        exposure->Stolen = true;
+        registry.Exposures.erase(it);
+        return std::unique_ptr<BackingStore>{new BackingStore{exposure->Data, exposure->Size, exposure}};
+    }
+
+    void BackingStore::Restore(std::unique_ptr<BackingStore> store)
+    {
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{registry.Mutex};
+
+        store->m_exposure->Stolen = false;
+        registry.Exposures[store->m_data] = store->m_exposure;
+
+        store->m_data = nullptr;
+        store->m_exposure = nullptr;
+    }
+
+    Napi::ArrayBuffer BackingStore::Expose(Napi::Env env, std::unique_ptr<BackingStore> store)
+    {
+        // Memory taken over from the engine goes back to it as it is, and is
+        // taken again if the new buffer is transferred.
+        if (store->m_contents)
+        {
+            store->m_data = nullptr;
+            return Napi::ArrayBuffer::New(env, std::move(store->m_contents));
+        }
+
+        if (store->m_size == 0)
+        {
+            return Napi::ArrayBuffer::New(env, 0);
+        }
+
+        auto* exposure = new Exposure{store->m_data, store->m_size, false};
+        {
+            auto& registry = GetRegistry();
+            std::scoped_lock lock{registry.Mutex};
+            registry.Exposures[exposure->Data] = exposure;
+        }
+        store->m_data = nullptr;
+
+        return Napi::ArrayBuffer::New(env, exposure->Data, exposure->Size, [](Napi::Env, void* data, Exposure* exposure) {
+            {
+                auto& registry = GetRegistry();
+                std::scoped_lock lock{registry.Mutex};
+                if (!exposure->Stolen)
+                {
+                    registry.Exposures.erase(data);
+                    std::free(data);
+                }
+            }
+
+            delete exposure;
+        },
+            exposure);
+    }
+
+    BackingStore::BackingStore(std::byte* data, size_t size, Exposure* exposure)
+        : m_data{data}
+        , m_size{size}
+        , m_exposure{exposure}
+    {
+    }
+
+    BackingStore::BackingStore(Napi::ArrayBuffer::Contents contents)
+        : m_data{static_cast<std::byte*>(contents.Data())}
+        , m_size{contents.ByteLength()}
+        , m_contents{std::move(contents)}
+        , m_exposure{nullptr}
+    {
+    }
+
+    BackingStore::~BackingStore()
+    {
+        // Memory stolen from a buffer that was never detached is still in use,
+        // and memory taken over from the engine is released with m_contents.
+        if (m_exposure == nullptr && !m_contents)
+        {
+            std::free(m_data);
+        }
+    }
+
+    void BackingStore::Detached()
+    {
+        m_exposure = nullptr;
+    }
+}
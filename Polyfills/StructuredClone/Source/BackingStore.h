@@ -0,0 +1,62 @@
+#pragma once
+
+#include <napi/napi.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace Babylon::Polyfills::Internal
+{
+    // The contents of an ArrayBuffer while it is held by a serialized value.
+    //
+    // Transferring a buffer takes its memory over from the engine where the
+    // engine allows it (V8), and deserializing wraps that memory in the new
+    // ArrayBuffer as it is. Elsewhere, deserializing hands the memory to the
+    // new ArrayBuffer instead of copying it, and remembers which buffers were
+    // created that way, so transferring one of them again moves the memory
+    // rather than copying it; other buffers are copied once when serialized.
+    class BackingStore
+    {
+    public:
+        // Copies the contents of `buffer`.
+        static std::unique_ptr<BackingStore> Copy(Napi::ArrayBuffer buffer);
+
+        // Detaches `buffer` and takes over its memory, or returns nullptr and
+        // leaves it untouched if the engine can't hand the memory over.
+        static std::unique_ptr<BackingStore> Take(Napi::ArrayBuffer buffer);
+
+        // Takes the memory of `buffer` if it was created by Expose, or returns
+        // nullptr. `buffer` must be detached right after; if that fails, the
+        // memory has to be given back with Restore.
+        static std::unique_ptr<BackingStore> Steal(Napi::ArrayBuffer buffer);
+        static void Restore(std::unique_ptr<BackingStore> store);
+
+        // Creates an ArrayBuffer in `env` that owns the memory of `store`.
+        static Napi::ArrayBuffer Expose(Napi::Env env, std::unique_ptr<BackingStore> store);
+
+        ~BackingStore();
+
+        BackingStore(const BackingStore&) = delete;
+        BackingStore& operator=(const BackingStore&) = delete;
+
+        // Called once the buffer the memory was stolen from is detached.
+        void Detached();
+
+    private:
+        struct Exposure;
+
+        BackingStore(std::byte* data, size_t size, Exposure* exposure);
+        explicit BackingStore(Napi::ArrayBuffer::Contents contents);
+
+        std::byte* m_data;
+        size_t m_size;
+
+        // Owns the memory when it was taken over from the engine; otherwise
+        // it comes from malloc.
+        Napi::ArrayBuffer::Contents m_contents;
+
+        // Set between Steal and Detached, while the memory is still reachable
+        // from the source buffer.
+        Exposure* m_exposure;
+    };
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "BackingStore.h"
+
+#include <Babylon/Polyfills/StructuredClone.h>
+#include <Babylon/SharedMemory.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Babylon::Polyfills::StructuredClone
+{
+    class SerializedValue::Impl
+    {
+    public:
+        struct BlobData
+        {
+            std::vector<std::byte> Data;
+            std::string Type;
+        };
+
+        // The records written by the Serializer.
+        std::vector<std::byte> Bytes{};
+
+        // ArrayBuffer contents, referenced by index from the records. The
+        // transferred buffers come first, in the order of the transfer list.
+        std::vector<std::unique_ptr<Internal::BackingStore>> Buffers{};
+
+        std::vector<BlobData> Blobs{};
+
+        // The memory behind SharedMemory views, which are shared rather than
+        // copied.
+        std::vector<std::shared_ptr<SharedMemory>> SharedMemories{};
+    };
+}
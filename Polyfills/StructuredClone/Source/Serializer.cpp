@@ -0,0 +1,653 @@
+#include "Serializer.h"
+
+#ifdef JSRUNTIMEHOST_POLYFILL_BLOB
+#include <Babylon/Polyfills/Blob.h>
+#endif
+
+#include <cstring>
+
+namespace Babylon::Polyfills::Internal
+{
+    namespace
+    {
+        enum class Tag : uint8_t
+        {
+            Undefined,
+            Null,
+            True,
+            False,
+            Number,
+            String,
+            Object,
+            Array,
+            Date,
+            RegExp,
+            Map,
+            Set,
+            Error,
+            ArrayBuffer,
+            TypedArray,
+            DataView,
+            Blob,
+            SharedMemory,
+            // An object that was already written, by id.
+            Reference,
+        };
+
+        const char* GetTypedArrayConstructorName(napi_typedarray_type type)
+        {
+            switch (type)
+            {
+                case napi_int8_array:
+                    return "Int8Array";
+                case napi_uint8_array:
+                    return "Uint8Array";
+                case napi_uint8_clamped_array:
+                    return "Uint8ClampedArray";
+                case napi_int16_array:
+                    return "Int16Array";
+                case napi_uint16_array:
+                    return "Uint16Array";
+                case napi_int32_array:
+                    return "Int32Array";
+                case napi_uint32_array:
+                    return "Uint32Array";
+                case napi_float32_array:
+                    return "Float32Array";
+                case napi_float64_array:
+                    return "Float64Array";
+                case napi_bigint64_array:
+                    return "BigInt64Array";
+                case napi_biguint64_array:
+                    return "BigUint64Array";
+                default:
+                    return nullptr;
+            }
+        }
+
+        bool IsInstanceOf(Napi::Object global, Napi::Object object, const char* constructorName)
+        {
+            const auto constructor = global.Get(constructorName);
+            return constructor.IsFunction() && object.InstanceOf(constructor.As<Napi::Function>());
+        }
+
+        Napi::Array ToArray(Napi::Object global, Napi::Value iterable)
+        {
+            const auto array = global.Get("Array").As<Napi::Object>();
+            return array.Get("from").As<Napi::Function>().Call(array, {iterable}).As<Napi::Array>();
+        }
+    }
+
+    Serializer::Serializer(Napi::Env env)
+        : m_env{env}
+        , m_global{env.Global()}
+        , m_impl{std::make_unique<SerializedValue::Impl>()}
+    {
+        const auto map = m_global.Get("Map").As<Napi::Function>();
+        const auto prototype = map.Get("prototype").As<Napi::Object>();
+        m_mapGet = prototype.Get("get").As<Napi::Function>();
+        m_mapSet = prototype.Get("set").As<Napi::Function>();
+        m_memory = map.New({});
+        m_transferIndices = map.New({});
+    }
+
+    SerializedValue Serializer::Serialize(Napi::Value value, Napi::Value transfer)
+    {
+        WriteTransferList(transfer);
+        WriteValue(value);
+
+        // Only once the whole value is written, so nothing is detached if
+        // part of it can't be cloned.
+        TransferBuffers();
+
+        return SerializedValue{std::move(m_impl)};
+    }
+
+    void Serializer::WriteTransferList(Napi::Value transfer)
+    {
+        if (transfer.IsUndefined() || transfer.IsNull())
+        {
+            return;
+        }
+
+        if (!transfer.IsArray())
+        {
+            throw Napi::TypeError::New(m_env, "The transfer list must be an array");
+        }
+
+        const auto list = transfer.As<Napi::Array>();
+        for (uint32_t i = 0; i < list.Length(); ++i)
+        {
+            const auto item = list.Get(i);
+            if (!item.IsArrayBuffer() || SharedMemory::GetFromJavaScript(item) != nullptr)
+            {
+                ThrowDataCloneError("Only ArrayBuffers that aren't shared can be transferred");
+            }
+
+            if (!Lookup(m_transferIndices, item).IsUndefined())
+            {
+                ThrowDataCloneError("An ArrayBuffer is listed more than once in the transfer list");
+            }
+
+            Remember(m_transferIndices, item, i);
+            m_transferList.push_back(item.As<Napi::ArrayBuffer>());
+        }
+
+        m_impl->Buffers.resize(m_transferList.size());
+    }
+
+    void Serializer::WriteValue(Napi::Value value)
+    {
+        switch (value.Type())
+        {
+            case napi_undefined:
+                WriteByte(static_cast<uint8_t>(Tag::Undefined));
+                break;
+            case napi_null:
+                WriteByte(static_cast<uint8_t>(Tag::Null));
+                break;
+            case napi_boolean:
+                WriteByte(static_cast<uint8_t>(value.As<Napi::Boolean>().Value() ? Tag::True : Tag::False));
+                break;
+            case napi_number:
+                WriteByte(static_cast<uint8_t>(Tag::Number));
+                WriteDouble(value.As<Napi::Number>().DoubleValue());
+                break;
+            case napi_string:
+                WriteByte(static_cast<uint8_t>(Tag::String));
+                WriteString(value);
+                break;
+            case napi_object:
+                WriteObject(value.As<Napi::Object>());
+                break;
+            case napi_function:
+                ThrowDataCloneError("Functions can't be cloned");
+            default:
+                ThrowDataCloneError("The value can't be cloned");
+        }
+    }
+
+    void Serializer::WriteObject(Napi::Object object)
+    {
+        const auto id = Lookup(m_memory, object);
+        if (!id.IsUndefined())
+        {
+            WriteByte(static_cast<uint8_t>(Tag::Reference));
+            WriteUint32(id.As<Napi::Number>().Uint32Value());
+            return;
+        }
+
+        Remember(m_memory, object, m_nextId++);
+
+        if (object.IsArrayBuffer() || object.IsSharedArrayBuffer())
+        {
+            // Views of SharedMemory are ArrayBuffers on engines that can't make
+            // them SharedArrayBuffers, so those are looked up first.
+            if (auto memory = SharedMemory::GetFromJavaScript(object))
+            {
+                WriteByte(static_cast<uint8_t>(Tag::SharedMemory));
+                WriteUint32(static_cast<uint32_t>(m_impl->SharedMemories.size()));
+                m_impl->SharedMemories.push_back(std::move(memory));
+            }
+            else if (object.IsArrayBuffer())
+            {
+                WriteArrayBuffer(object.As<Napi::ArrayBuffer>());
+            }
+            else
+            {
+                ThrowDataCloneError("Only SharedArrayBuffers created by the host can be cloned");
+            }
+        }
+        else if (object.IsTypedArray())
+        {
+            const auto array = object.As<Napi::TypedArray>();
+            if (GetTypedArrayConstructorName(array.TypedArrayType()) == nullptr)
+            {
+                ThrowDataCloneError("The typed array type can't be cloned");
+            }
+
+            WriteByte(static_cast<uint8_t>(Tag::TypedArray));
+            WriteByte(static_cast<uint8_t>(array.TypedArrayType()));
+            WriteUint64(array.ByteOffset());
+            WriteUint64(array.ElementLength());
+            WriteObject(array.ArrayBuffer());
+        }
+        else if (object.IsDataView())
+        {
+            const auto view = object.As<Napi::DataView>();
+            WriteByte(static_cast<uint8_t>(Tag::DataView));
+            WriteUint64(view.ByteOffset());
+            WriteUint64(view.ByteLength());
+            WriteObject(view.ArrayBuffer());
+        }
+        else if (object.IsPromise())
+        {
+            ThrowDataCloneError("Promises can't be cloned");
+        }
+        else if (IsInstanceOf(m_global, object, "Date"))
+        {
+            WriteByte(static_cast<uint8_t>(Tag::Date));
+            WriteDouble(object.Get("getTime").As<Napi::Function>().Call(object, {}).As<Napi::Number>().DoubleValue());
+        }
+        else if (IsInstanceOf(m_global, object, "RegExp"))
+        {
+            WriteByte(static_cast<uint8_t>(Tag::RegExp));
+            WriteString(object.Get("source").ToString());
+            WriteString(object.Get("flags").ToString());
+        }
+        else if (IsInstanceOf(m_global, object, "Map"))
+        {
+            const auto entries = ToArray(m_global, object);
+            WriteByte(static_cast<uint8_t>(Tag::Map));
+            WriteUint32(entries.Length());
+            for (uint32_t i = 0; i < entries.Length(); ++i)
+            {
+                const auto entry = entries.Get(i).As<Napi::Array>();
+                WriteValue(entry.Get(0u));
+                WriteValue(entry.Get(1u));
+            }
+        }
+        else if (IsInstanceOf(m_global, object, "Set"))
+        {
+            const auto values = ToArray(m_global, object);
+            WriteByte(static_cast<uint8_t>(Tag::Set));
+            WriteUint32(values.Length());
+            for (uint32_t i = 0; i < values.Length(); ++i)
+            {
+                WriteValue(values.Get(i));
+            }
+        }
+        else if (IsInstanceOf(m_global, object, "Error"))
+        {
+            WriteByte(static_cast<uint8_t>(Tag::Error));
+            WriteString(object.Get("name").ToString());
+            WriteString(object.Get("message").ToString());
+        }
+#ifdef JSRUNTIMEHOST_POLYFILL_BLOB
+        else if (SerializedValue::Impl::BlobData blob{}; Blob::TryGetData(object, blob.Data, blob.Type))
+        {
+            WriteByte(static_cast<uint8_t>(Tag::Blob));
+            WriteUint32(static_cast<uint32_t>(m_impl->Blobs.size()));
+            m_impl->Blobs.push_back(std::move(blob));
+        }
+#endif
+        else if (object.IsArray())
+        {
+            WriteByte(static_cast<uint8_t>(Tag::Array));
+            WriteUint32(object.As<Napi::Array>().Length());
+            WriteProperties(object);
+        }
+        else
+        {
+            WriteByte(static_cast<uint8_t>(Tag::Object));
+            WriteProperties(object);
+        }
+    }
+
+    void Serializer::WriteProperties(Napi::Object object)
+    {
+        const auto objectConstructor = m_global.Get("Object").As<Napi::Object>();
+        const auto keys = objectConstructor.Get("keys").As<Napi::Function>().Call(objectConstructor, {object}).As<Napi::Array>();
+
+        WriteUint32(keys.Length());
+        for (uint32_t i = 0; i < keys.Length(); ++i)
+        {
+            const auto key = keys.Get(i);
+            WriteString(key);
+            WriteValue(object.Get(key));
+        }
+    }
+
+    void Serializer::WriteArrayBuffer(Napi::ArrayBuffer buffer)
+    {
+        const auto transferIndex = Lookup(m_transferIndices, buffer);
+
+        uint32_t index{};
+        if (transferIndex.IsUndefined())
+        {
+            index = static_cast<uint32_t>(m_impl->Buffers.size());
+            m_impl->Buffers.push_back(BackingStore::Copy(buffer));
+        }
+        else
+        {
+            index = transferIndex.As<Napi::Number>().Uint32Value();
+        }
+
+        WriteByte(static_cast<uint8_t>(Tag::ArrayBuffer));
+        WriteUint32(index);
+    }
+
+    void Serializer::TransferBuffers()
+    {
+        for (size_t i = 0; i < m_transferList.size(); ++i)
+        {
+            auto buffer = m_transferList[i];
+
+            try
+            {
+                if (auto store = BackingStore::Take(buffer))
+                {
+                    m_impl->Buffers[i] = std::move(store);
+                    continue;
+                }
+            }
+            catch (const Napi::Error&)
+            {
+                ThrowDataCloneError("An ArrayBuffer in the transfer list can't be detached");
+            }
+
+            // The engine frees the memory as it detaches the buffer, so it is
+            // copied first unless it was exposed by an earlier Deserialize.
+            auto store = BackingStore::Steal(buffer);
+            const bool stolen = store != nullptr;
+            if (!stolen)
+            {
+                store = BackingStore::Copy(buffer);
+            }
+
+            bool detached{};
+            try
+            {
+                detached = buffer.TryDetach();
+            }
+            catch (const Napi::Error&)
+            {
+                if (stolen)
+                {
+                    BackingStore::Restore(std::move(store));
+                }
+                ThrowDataCloneError("An ArrayBuffer in the transfer list can't be detached");
+            }
+
+            if (stolen)
+            {
+                if (detached)
+                {
+                    store->Detached();
+                }
+                else
+                {
+                    // Engines that can't detach buffers leave the source
+                    // untouched and get a copy.
+                    BackingStore::Restore(std::move(store));
+                    store = BackingStore::Copy(buffer);
+                }
+            }
+
+            m_impl->Buffers[i] = std::move(store);
+        }
+    }
+
+    void Serializer::WriteByte(uint8_t value)
+    {
+        m_impl->Bytes.push_back(static_cast<std::byte>(value));
+    }
+
+    void Serializer::WriteUint32(uint32_t value)
+    {
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        m_impl->Bytes.insert(m_impl->Bytes.end(), bytes, bytes + sizeof(value));
+    }
+
+    void Serializer::WriteUint64(uint64_t value)
+    {
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        m_impl->Bytes.insert(m_impl->Bytes.end(), bytes, bytes + sizeof(value));
+    }
+
+    void Serializer::WriteDouble(double value)
+    {
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        m_impl->Bytes.insert(m_impl->Bytes.end(), bytes, bytes + sizeof(value));
+    }
+
+    void Serializer::WriteString(Napi::Value value)
+    {
+        // UTF-16, so strings holding unpaired surrogates round trip.
+        const std::u16string string = value.As<Napi::String>().Utf16Value();
+        WriteUint32(static_cast<uint32_t>(string.size()));
+
+        const auto* bytes = reinterpret_cast<const std::byte*>(string.data());
+        m_impl->Bytes.insert(m_impl->Bytes.end(), bytes, bytes + string.size() * sizeof(char16_t));
+    }
+
+    Napi::Value Serializer::Lookup(Napi::Object map, Napi::Value key) const
+    {
+        return m_mapGet.Call(map, {key});
+    }
+
+    void Serializer::Remember(Napi::Object map, Napi::Value key, uint32_t value) const
+    {
+        m_mapSet.Call(map, {key, Napi::Number::New(m_env, value)});
+    }
+
+    void Serializer::ThrowDataCloneError(const std::string& message) const
+    {
+        Napi::Error error = Napi::Error::New(m_env, message);
+        error.Value().Set("name", Napi::String::New(m_env, "DataCloneError"));
+        throw error;
+    }
+
+    Deserializer::Deserializer(Napi::Env env, SerializedValue::Impl& impl)
+        : m_env{env}
+        , m_global{env.Global()}
+        , m_impl{impl}
+    {
+    }
+
+    Napi::Value Deserializer::Deserialize()
+    {
+        return ReadValue();
+    }
+
+    Napi::Value Deserializer::ReadValue()
+    {
+        const auto tag = static_cast<Tag>(ReadByte());
+        switch (tag)
+        {
+            case Tag::Undefined:
+                return m_env.Undefined();
+            case Tag::Null:
+                return m_env.Null();
+            case Tag::True:
+                return Napi::Boolean::New(m_env, true);
+            case Tag::False:
+                return Napi::Boolean::New(m_env, false);
+            case Tag::Number:
+                return Napi::Number::New(m_env, ReadDouble());
+            case Tag::String:
+                return ReadString();
+            case Tag::Reference:
+                return m_objects.at(ReadUint32());
+            case Tag::TypedArray:
+            case Tag::DataView:
+                return ReadArrayBufferView(static_cast<uint8_t>(tag));
+            default:
+                break;
+        }
+
+        // The remaining tags are objects that get the next id. Objects that can
+        // contain other values are registered before reading them, so they can
+        // refer back to it.
+        Napi::Value result{};
+        const auto id = ReserveId();
+        switch (tag)
+        {
+            case Tag::Object:
+            {
+                auto object = Napi::Object::New(m_env);
+                m_objects[id] = object;
+                ReadProperties(object);
+                result = object;
+                break;
+            }
+            case Tag::Array:
+            {
+                auto array = Napi::Array::New(m_env, ReadUint32());
+                m_objects[id] = array;
+                ReadProperties(array);
+                result = array;
+                break;
+            }
+            case Tag::Date:
+            {
+                result = m_global.Get("Date").As<Napi::Function>().New({Napi::Number::New(m_env, ReadDouble())});
+                break;
+            }
+            case Tag::RegExp:
+            {
+                const auto source = ReadString();
+                const auto flags = ReadString();
+                result = m_global.Get("RegExp").As<Napi::Function>().New({source, flags});
+                break;
+            }
+            case Tag::Map:
+            {
+                auto map = m_global.Get("Map").As<Napi::Function>().New({});
+                m_objects[id] = map;
+                const auto set = map.Get("set").As<Napi::Function>();
+                const auto size = ReadUint32();
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    const auto key = ReadValue();
+                    const auto value = ReadValue();
+                    set.Call(map, {key, value});
+                }
+                result = map;
+                break;
+            }
+            case Tag::Set:
+            {
+                auto set = m_global.Get("Set").As<Napi::Function>().New({});
+                m_objects[id] = set;
+                const auto add = set.Get("add").As<Napi::Function>();
+                const auto size = ReadUint32();
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    add.Call(set, {ReadValue()});
+                }
+                result = set;
+                break;
+            }
+            case Tag::Error:
+            {
+                const auto name = ReadString();
+                auto error = Napi::Error::New(m_env, ReadString().Utf8Value()).Value();
+                error.Set("name", name);
+                result = error;
+                break;
+            }
+            case Tag::ArrayBuffer:
+            {
+                auto& store = m_impl.Buffers.at(ReadUint32());
+                result = BackingStore::Expose(m_env, std::move(store));
+                break;
+            }
+            case Tag::SharedMemory:
+            {
+                result = m_impl.SharedMemories.at(ReadUint32())->CreateView(m_env);
+                break;
+            }
+#ifdef JSRUNTIMEHOST_POLYFILL_BLOB
+            case Tag::Blob:
+            {
+                auto& blob = m_impl.Blobs.at(ReadUint32());
+                result = Blob::Create(m_env, std::move(blob.Data), std::move(blob.Type));
+                break;
+            }
+#endif
+            default:
+                throw Napi::Error::New(m_env, "Invalid serialized value");
+        }
+
+        m_objects[id] = result;
+        return result;
+    }
+
+    Napi::Value Deserializer::ReadArrayBufferView(uint8_t tag)
+    {
+        // The view gets its id before its buffer, but can only be created after.
+        const auto id = ReserveId();
+
+        Napi::Value result{};
+        if (static_cast<Tag>(tag) == Tag::TypedArray)
+        {
+            const auto type = static_cast<napi_typedarray_type>(ReadByte());
+            const auto byteOffset = ReadUint64();
+            const auto length = ReadUint64();
+            const auto buffer = ReadValue();
+
+            const auto constructor = m_global.Get(GetTypedArrayConstructorName(type)).As<Napi::Function>();
+            result = constructor.New({buffer, Napi::Number::New(m_env, static_cast<double>(byteOffset)), Napi::Number::New(m_env, static_cast<double>(length))});
+        }
+        else
+        {
+            const auto byteOffset = ReadUint64();
+            const auto byteLength = ReadUint64();
+            const auto buffer = ReadValue();
+
+            // Through the constructor rather than Napi::DataView, which only
+            // takes ArrayBuffers.
+            result = m_global.Get("DataView").As<Napi::Function>().New({buffer, Napi::Number::New(m_env, static_cast<double>(byteOffset)), Napi::Number::New(m_env, static_cast<double>(byteLength))});
+        }
+
+        m_objects[id] = result;
+        return result;
+    }
+
+    void Deserializer::ReadProperties(Napi::Object object)
+    {
+        const auto count = ReadUint32();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto key = ReadString();
+            object.Set(key, ReadValue());
+        }
+    }
+
+    uint8_t Deserializer::ReadByte()
+    {
+        return static_cast<uint8_t>(m_impl.Bytes.at(m_position++));
+    }
+
+    uint32_t Deserializer::ReadUint32()
+    {
+        uint32_t value{};
+        std::memcpy(&value, m_impl.Bytes.data() + m_position, sizeof(value));
+        m_position += sizeof(value);
+        return value;
+    }
+
+    uint64_t Deserializer::ReadUint64()
+    {
+        uint64_t value{};
+        std::memcpy(&value, m_impl.Bytes.data() + m_position, sizeof(value));
+        m_position += sizeof(value);
+        return value;
+    }
+
+    double Deserializer::ReadDouble()
+    {
+        double value{};
+        std::memcpy(&value, m_impl.Bytes.data() + m_position, sizeof(value));
+        m_position += sizeof(value);
+        return value;
+    }
+
+    Napi::String Deserializer::ReadString()
+    {
+        const auto length = ReadUint32();
+
+        std::u16string string(length, u'\0');
+        std::memcpy(string.data(), m_impl.Bytes.data() + m_position, length * sizeof(char16_t));
+        m_position += length * sizeof(char16_t);
+
+        return Napi::String::New(m_env, string);
+    }
+
+    uint32_t Deserializer::ReserveId()
+    {
+        m_objects.emplace_back();
+        return static_cast<uint32_t>(m_objects.size() - 1);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "SerializedValue.h"
+
+#include <napi/napi.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Babylon::Polyfills::Internal
+{
+    using StructuredClone::SerializedValue;
+
+    // Writes a value as a flat list of records, depth first. Each object is
+    // given an id in the order it is first reached, and later references to
+    // it are written as that id, which preserves shared references and cycles.
+    class Serializer
+    {
+    public:
+        explicit Serializer(Napi::Env env);
+
+        SerializedValue Serialize(Napi::Value value, Napi::Value transfer);
+
+    private:
+        void WriteTransferList(Napi::Value transfer);
+        void WriteValue(Napi::Value value);
+        void WriteObject(Napi::Object object);
+        void WriteProperties(Napi::Object object);
+        void WriteArrayBuffer(Napi::ArrayBuffer buffer);
+        void TransferBuffers();
+
+        void WriteByte(uint8_t value);
+        void WriteUint32(uint32_t value);
+        void WriteUint64(uint64_t value);
+        void WriteDouble(double value);
+        void WriteString(Napi::Value value);
+
+        // Look up and add entries of the JavaScript Maps below.
+        Napi::Value Lookup(Napi::Object map, Napi::Value key) const;
+        void Remember(Napi::Object map, Napi::Value key, uint32_t value) const;
+
+        [[noreturn]] void ThrowDataCloneError(const std::string& message) const;
+
+        Napi::Env m_env;
+        Napi::Object m_global;
+        Napi::Function m_mapGet;
+        Napi::Function m_mapSet;
+        // The id of each object written so far.
+        Napi::Object m_memory;
+        // The index of each buffer in the transfer list.
+        Napi::Object m_transferIndices;
+        std::vector<Napi::ArrayBuffer> m_transferList{};
+        uint32_t m_nextId{};
+        std::unique_ptr<SerializedValue::Impl> m_impl;
+    };
+
+    class Deserializer
+    {
+    public:
+        Deserializer(Napi::Env env, SerializedValue::Impl& impl);
+
+        Napi::Value Deserialize();
+
+    private:
+        Napi::Value ReadValue();
+        Napi::Value ReadArrayBufferView(uint8_t tag);
+        void ReadProperties(Napi::Object object);
+
+        uint8_t ReadByte();
+        uint32_t ReadUint32();
+        uint64_t ReadUint64();
+        double ReadDouble();
+        Napi::String ReadString();
+
+        // Reserves the id of the next object, for objects that are created
+        // after their contents are read.
+        uint32_t ReserveId();
+
+        Napi::Env m_env;
+        Napi::Object m_global;
+        SerializedValue::Impl& m_impl;
+        size_t m_position{};
+        std::vector<Napi::Value> m_objects{};
+    };
+}
@@ -0,0 +1,64 @@
+#include "Serializer.h"
+
+#include <Babylon/StartupTrace.h>
+
+namespace Babylon::Polyfills::Internal
+{
+    namespace
+    {
+        constexpr auto JS_STRUCTURED_CLONE_NAME = "structuredClone";
+
+        Napi::Value StructuredClone(const Napi::CallbackInfo& info)
+        {
+            Napi::Value transfer = info.Env().Undefined();
+            if (info[1].IsObject())
+            {
+                transfer = info[1].As<Napi::Object>().Get("transfer");
+            }
+
+            return Deserializer{info.Env(), Serializer{info.Env()}.Serialize(info[0], transfer).GetImpl()}.Deserialize();
+        }
+    }
+}
+
+namespace Babylon::Polyfills::StructuredClone
+{
+    SerializedValue::SerializedValue() = default;
+
+    SerializedValue::SerializedValue(std::unique_ptr<Impl> impl)
+        : m_impl{std::move(impl)}
+    {
+    }
+
+    SerializedValue::~SerializedValue() = default;
+
+    SerializedValue::SerializedValue(SerializedValue&&) noexcept = default;
+
+    SerializedValue& SerializedValue::operator=(SerializedValue&&) noexcept = default;
+
+    SerializedValue::Impl& SerializedValue::GetImpl() const
+    {
+        return *m_impl;
+    }
+
+    void BABYLON_API Initialize(Napi::Env env)
+    {
+        StartupTrace::Scope phase{env, "Polyfills::StructuredClone::Initialize"};
+
+        auto global = env.Global();
+        if (global.Get(Internal::JS_STRUCTURED_CLONE_NAME).IsUndefined())
+        {
+            global.Set(Internal::JS_STRUCTURED_CLONE_NAME, Napi::Function::New(env, Internal::StructuredClone, Internal::JS_STRUCTURED_CLONE_NAME));
+        }
+    }
+
+    SerializedValue BABYLON_API Serialize(Napi::Value value, Napi::Value transfer)
+    {
+        return Internal::Serializer{value.Env()}.Serialize(value, transfer);
+    }
+
+    Napi::Value BABYLON_API Deserialize(Napi::Env env, SerializedValue value)
+    {
+        return Internal::Deserializer{env, value.GetImpl()}.Deserialize();
+    }
+}
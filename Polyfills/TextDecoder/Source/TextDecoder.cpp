@@ -1,4 +1,5 @@
 #include <Babylon/Polyfills/TextDecoder.h>
+#include <Babylon/StartupTrace.h>
 
 #include <napi/napi.h>
 #include <cstring>
@@ -125,6 +126,7 @@ namespace Babylon::Polyfills::TextDecoder
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::TextDecoder::Initialize"};
         ::TextDecoder::Initialize(env);
     }
 }
@@ -1,4 +1,5 @@
 #include <Babylon/Polyfills/TextEncoder.h>
+#include <Babylon/StartupTrace.h>
 
 #include <napi/napi.h>
 
@@ -67,6 +68,7 @@ namespace Babylon::Polyfills::TextEncoder
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::TextEncoder::Initialize"};
         ::TextEncoder::Initialize(env);
     }
 }
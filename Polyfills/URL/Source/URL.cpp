@@ -2,6 +2,7 @@
 #include <sstream>
 #include <regex>
 #include <optional>
+#include <Babylon/StartupTrace.h>
 
 // NOTE: This is a platform agnostic implementation created with a lot of help from AI :)
 //       In the future, we may want to consider using platform-specific URL parsing APIs instead.
@@ -533,11 +534,13 @@ namespace Babylon::Polyfills::Internal
 
     void URL::SetHash(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        std::string hash = value.As<Napi::String>();
+        const Napi::StringView hashView{value.As<Napi::String>()};
+        const std::string_view hash = hashView;
         // Ensure hash starts with # if non-empty
         if (!hash.empty() && hash[0] != '#')
         {
-            m_hash = "#" + hash;
+            m_hash = "#";
+            m_hash += hash;
         }
         else
         {
@@ -547,10 +550,11 @@ namespace Babylon::Polyfills::Internal
 
     void URL::SetHost(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        std::string host = value.As<Napi::String>();
+        const Napi::StringView hostView{value.As<Napi::String>()};
+        const std::string_view host = hostView;
         // Parse host into hostname and port
         size_t colonPos = host.find(':');
-        if (colonPos != std::string::npos)
+        if (colonPos != std::string_view::npos)
         {
             m_hostname = host.substr(0, colonPos);
             m_port = host.substr(colonPos + 1);
@@ -583,11 +587,13 @@ namespace Babylon::Polyfills::Internal
 
     void URL::SetPathname(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        std::string pathname = value.As<Napi::String>();
+        const Napi::StringView pathnameView{value.As<Napi::String>()};
+        const std::string_view pathname = pathnameView;
         // Ensure pathname starts with / if we have a host
         if (!m_hostname.empty() && !pathname.empty() && pathname[0] != '/')
         {
-            m_pathname = "/" + pathname;
+            m_pathname = "/";
+            m_pathname += pathname;
         }
         else
         {
@@ -602,11 +608,13 @@ namespace Babylon::Polyfills::Internal
 
     void URL::SetProtocol(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        std::string protocol = value.As<Napi::String>();
+        const Napi::StringView protocolView{value.As<Napi::String>()};
+        const std::string_view protocol = protocolView;
         // Ensure protocol ends with :
         if (!protocol.empty() && protocol.back() != ':')
         {
-            m_protocol = protocol + ":";
+            m_protocol = protocol;
+            m_protocol += ':';
         }
         else
         {
@@ -616,7 +624,8 @@ namespace Babylon::Polyfills::Internal
 
     void URL::SetSearch(const Napi::CallbackInfo& info, const Napi::Value& value)
     {
-        std::string search = value.As<Napi::String>();
+        const Napi::StringView searchView{value.As<Napi::String>()};
+        const std::string_view search = searchView;
         
         // Normalize the search string (ensure it starts with ? if non-empty)
         std::string searchWithoutQuestion;
@@ -718,6 +727,7 @@ namespace Babylon::Polyfills::URL
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::URL::Initialize"};
         Internal::URL::Initialize(env);
         Internal::URLSearchParams::Initialize(env);
     }
@@ -1,5 +1,6 @@
 #include "WebSocket.h"
 #include <Babylon/JsRuntime.h>
+#include <Babylon/StartupTrace.h>
 
 namespace Babylon::Polyfills::Internal
 {
@@ -356,6 +357,7 @@ namespace Babylon::Polyfills::WebSocket
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::WebSocket::Initialize"};
         Internal::WebSocket::Initialize(env);
     }
 }
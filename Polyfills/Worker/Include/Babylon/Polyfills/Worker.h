@@ -0,0 +1,16 @@
+#pragma once
+
+#include <napi/env.h>
+#include <Babylon/Api.h>
+
+#include <functional>
+
+namespace Babylon::Polyfills::Worker
+{
+    // Sets up the environment of each worker, on the worker's JavaScript thread,
+    // before its script is loaded. This usually initializes the same polyfills
+    // as the parent, including Worker itself to allow nested workers.
+    using EnvironmentInitializer = std::function<void(Napi::Env)>;
+
+    void BABYLON_API Initialize(Napi::Env env, EnvironmentInitializer initializer);
+}
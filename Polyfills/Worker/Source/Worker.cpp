@@ -0,0 +1,477 @@
+#include "Worker.h"
+
+#include <Babylon/StartupTrace.h>
+
+namespace Babylon::Polyfills::Internal
+{
+    namespace
+    {
+        constexpr auto JS_WORKER_INITIALIZER_NAME = "workerInitializer";
+        constexpr auto JS_WORKER_LISTENERS_NAME = "workerListeners";
+        constexpr auto JS_WORKER_RELEASER_NAME = "workerReleaser";
+
+        // Serializes the arguments of postMessage(message, transfer), where
+        // `transfer` is either the transfer list or an object holding it.
+        std::shared_ptr<StructuredClone::SerializedValue> Serialize(const Napi::CallbackInfo& info)
+        {
+            Napi::Value transfer = info[1];
+            if (transfer.IsObject() && !transfer.IsArray())
+            {
+                transfer = transfer.As<Napi::Object>().Get("transfer");
+            }
+
+            return std::make_shared<StructuredClone::SerializedValue>(StructuredClone::Serialize(info[0], transfer));
+        }
+    }
+
+    void Worker::Initialize(Napi::Env env, Polyfills::Worker::EnvironmentInitializer initializer)
+    {
+        if (env.Global().Get(JS_WORKER_CONSTRUCTOR_NAME).IsUndefined())
+        {
+            auto* data = new Polyfills::Worker::EnvironmentInitializer{std::move(initializer)};
+            JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_WORKER_INITIALIZER_NAME,
+                Napi::External<Polyfills::Worker::EnvironmentInitializer>::New(env, data, [](Napi::Env, Polyfills::Worker::EnvironmentInitializer* data) { delete data; }));
+
+            Napi::Function func = DefineClass(
+                env,
+                JS_WORKER_CONSTRUCTOR_NAME,
+                {
+                    InstanceMethod("postMessage", &Worker::PostMessage),
+                    InstanceMethod("terminate", &Worker::Terminate),
+                    InstanceAccessor("onmessage", &Worker::GetOnMessage, &Worker::SetOnMessage),
+                    InstanceAccessor("onerror", &Worker::GetOnError, &Worker::SetOnError),
+                    InstanceMethod("addEventListener", &Worker::AddEventListener),
+                    InstanceMethod("removeEventListener", &Worker::RemoveEventListener),
+                });
+
+            env.Global().Set(JS_WORKER_CONSTRUCTOR_NAME, func);
+        }
+    }
+
+    Worker::Worker(const Napi::CallbackInfo& info)
+        : Napi::ObjectWrap<Worker>{info}
+        , m_channel{std::make_shared<Channel>(JsRuntime::GetFromJavaScript(info.Env()), *this)}
+        , m_scope{std::make_shared<Scope>()}
+        , m_releaser{Releaser::GetFromJavaScript(info.Env())}
+    {
+        const std::string url = info[0].ToString().Utf8Value();
+        const Polyfills::Worker::EnvironmentInitializer initializer = *JsRuntime::NativeObject::GetFromJavaScript(info.Env())
+                                                                            .Get(JS_WORKER_INITIALIZER_NAME)
+                                                                            .As<Napi::External<Polyfills::Worker::EnvironmentInitializer>>()
+                                                                            .Data();
+
+        AppRuntime::Options options{};
+        options.UnhandledExceptionHandler = [channel = m_channel, scope = m_scope](const Napi::Error& error) {
+            // ScriptLoader stops at a script that throws, so this is also how
+            // the scope learns that the script is done.
+            scope->Start();
+
+            channel->Post([message = error.Message()](Worker& worker) {
+                worker.DispatchError(message);
+            });
+        };
+
+        m_runtime = std::make_unique<AppRuntime>(std::move(options));
+        m_runtime->Dispatch([initializer, scope = m_scope, channel = m_channel](Napi::Env env) {
+            if (initializer)
+            {
+                initializer(env);
+            }
+
+            Scope::Initialize(env, scope, channel);
+        });
+
+        m_loader = std::make_unique<ScriptLoader>(*m_runtime);
+        m_loader->LoadScript(url);
+        m_loader->Dispatch([scope = m_scope](Napi::Env) {
+            scope->Start();
+        });
+
+        m_selfReference = Napi::Persistent(info.This().As<Napi::Object>());
+    }
+
+    Worker::~Worker()
+    {
+        m_channel->Disconnect();
+        ReleaseRuntime();
+    }
+
+    void Worker::PostMessage(const Napi::CallbackInfo& info)
+    {
+        if (!m_runtime)
+        {
+            return;
+        }
+
+        m_runtime->Dispatch([scope = m_scope, message = Serialize(info)](Napi::Env) {
+            scope->Post(message);
+        });
+    }
+
+    void Worker::Terminate(const Napi::CallbackInfo&)
+    {
+        Stop();
+    }
+
+    Napi::Value Worker::GetOnMessage(const Napi::CallbackInfo&)
+    {
+        if (m_onmessage.IsEmpty())
+        {
+            return Env().Null();
+        }
+
+        return m_onmessage.Value();
+    }
+
+    void Worker::SetOnMessage(const Napi::CallbackInfo&, const Napi::Value& value)
+    {
+        if (value.IsFunction())
+        {
+            m_onmessage = Napi::Persistent(value.As<Napi::Function>());
+        }
+        else
+        {
+            m_onmessage.Reset();
+        }
+    }
+
+    Napi::Value Worker::GetOnError(const Napi::CallbackInfo&)
+    {
+        if (m_onerror.IsEmpty())
+        {
+            return Env().Null();
+        }
+
+        return m_onerror.Value();
+    }
+
+    void Worker::SetOnError(const Napi::CallbackInfo&, const Napi::Value& value)
+    {
+        if (value.IsFunction())
+        {
+            m_onerror = Napi::Persistent(value.As<Napi::Function>());
+        }
+        else
+        {
+            m_onerror.Reset();
+        }
+    }
+
+    void Worker::AddEventListener(const Napi::CallbackInfo& info)
+    {
+        const std::string type = info[0].ToString().Utf8Value();
+        if ((type != "message" && type != "error") || !info[1].IsFunction())
+        {
+            return;
+        }
+
+        const Napi::Function listener = info[1].As<Napi::Function>();
+        for (const auto& existing : m_listeners)
+        {
+            if (existing.Type == type && existing.Function.Value() == listener)
+            {
+                return;
+            }
+        }
+
+        m_listeners.push_back({type, Napi::Persistent(listener)});
+    }
+
+    void Worker::RemoveEventListener(const Napi::CallbackInfo& info)
+    {
+        const std::string type = info[0].ToString().Utf8Value();
+        if (!info[1].IsFunction())
+        {
+            return;
+        }
+
+        const Napi::Function listener = info[1].As<Napi::Function>();
+        for (auto it = m_listeners.begin(); it != m_listeners.end(); ++it)
+        {
+            if (it->Type == type && it->Function.Value() == listener)
+            {
+                m_listeners.erase(it);
+                break;
+            }
+        }
+    }
+
+    void Worker::DispatchMessage(Message message)
+    {
+        Napi::Env env = Env();
+
+        Napi::Object event = Napi::Object::New(env);
+        event.Set("type", "message");
+        event.Set("data", StructuredClone::Deserialize(env, std::move(*message)));
+        event.Set("target", Value());
+
+        DispatchEvent("message", event);
+    }
+
+    void Worker::DispatchError(const std::string& message)
+    {
+        Napi::Env env = Env();
+
+        Napi::Object event = Napi::Object::New(env);
+        event.Set("type", "error");
+        event.Set("message", message);
+        event.Set("target", Value());
+
+        DispatchEvent("error", event);
+    }
+
+    void Worker::DispatchEvent(const std::string& type, Napi::Object event)
+    {
+        const Napi::FunctionReference& handler = type == "message" ? m_onmessage : m_onerror;
+
+        // Copied first, since handlers may add or remove listeners.
+        std::vector<Napi::Function> handlers{};
+        handlers.reserve(m_listeners.size() + 1);
+        if (!handler.IsEmpty())
+        {
+            handlers.push_back(handler.Value());
+        }
+        for (const auto& listener : m_listeners)
+        {
+            if (listener.Type == type)
+            {
+                handlers.push_back(listener.Function.Value());
+            }
+        }
+
+        for (const auto& function : handlers)
+        {
+            function.Call(Value(), {event});
+        }
+    }
+
+    void Worker::Stop()
+    {
+        m_channel->Disconnect();
+        ReleaseRuntime();
+
+        // Last, since releasing it may let the Worker be collected.
+        m_selfReference.Reset();
+    }
+
+    void Worker::ReleaseRuntime()
+    {
+        m_loader.reset();
+        if (m_runtime)
+        {
+            m_runtime->Terminate();
+            m_releaser->Release(std::move(m_runtime));
+        }
+    }
+
+    std::shared_ptr<Worker::Releaser> Worker::Releaser::GetFromJavaScript(Napi::Env env)
+    {
+        auto native = JsRuntime::NativeObject::GetFromJavaScript(env);
+        if (native.Get(JS_WORKER_RELEASER_NAME).IsUndefined())
+        {
+            auto* releaser = new std::shared_ptr<Releaser>{std::make_shared<Releaser>()};
+            native.Set(JS_WORKER_RELEASER_NAME, Napi::External<std::shared_ptr<Releaser>>::New(env, releaser, [](Napi::Env, std::shared_ptr<Releaser>* releaser) { delete releaser; }));
+        }
+
+        return *native.Get(JS_WORKER_RELEASER_NAME).As<Napi::External<std::shared_ptr<Releaser>>>().Data();
+    }
+
+    void Worker::Releaser::Release(std::unique_ptr<Babylon::AppRuntime> runtime)
+    {
+        // Forgets the runtimes that are gone by now.
+        std::erase_if(m_pending, [](const std::future<void>& pending) {
+            return pending.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+        });
+
+        m_pending.push_back(std::async(std::launch::async, [runtime = std::move(runtime)]() mutable {
+            runtime.reset();
+        }));
+    }
+
+    Worker::Channel::Channel(Babylon::JsRuntime& parent, Worker& target)
+        : m_parent{parent}
+        , m_target{&target}
+    {
+    }
+
+    void Worker::Channel::Post(std::function<void(Worker&)> callback)
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_target == nullptr)
+        {
+            return;
+        }
+
+        m_parent.Dispatch([self = shared_from_this(), callback = std::move(callback)](Napi::Env) {
+            Worker* target{};
+            {
+                std::scoped_lock lock{self->m_mutex};
+                target = self->m_target;
+            }
+
+            if (target != nullptr)
+            {
+                callback(*target);
+            }
+        });
+    }
+
+    void Worker::Channel::Disconnect()
+    {
+        std::scoped_lock lock{m_mutex};
+        m_target = nullptr;
+    }
+
+    void Worker::Scope::Initialize(Napi::Env env, const std::shared_ptr<Scope>& scope, const std::shared_ptr<Channel>& channel)
+    {
+        scope->m_runtime = &JsRuntime::GetFromJavaScript(env);
+
+        // Listeners are kept in the environment rather than in the Scope, which
+        // outlives it.
+        JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_WORKER_LISTENERS_NAME, Napi::Array::New(env));
+
+        auto global = env.Global();
+        global.Set("self", global);
+
+        global.Set("postMessage", Napi::Function::New(
+                                      env, [channel](const Napi::CallbackInfo& info) {
+                                          channel->Post([message = Serialize(info)](Worker& worker) {
+                                              worker.DispatchMessage(message);
+                                          });
+                                      },
+                                      "postMessage"));
+
+        global.Set("close", Napi::Function::New(
+                                env, [channel](const Napi::CallbackInfo&) {
+                                    channel->Post([](Worker& worker) {
+                                        worker.Stop();
+                                    });
+                                },
+                                "close"));
+
+        global.Set("addEventListener", Napi::Function::New(
+                                           env, [](const Napi::CallbackInfo& info) {
+                                               if (info[0].ToString().Utf8Value() != "message" || !info[1].IsFunction())
+                                               {
+                                                   return;
+                                               }
+
+                                               auto listeners = JsRuntime::NativeObject::GetFromJavaScript(info.Env()).Get(JS_WORKER_LISTENERS_NAME).As<Napi::Array>();
+                                               for (uint32_t i = 0; i < listeners.Length(); ++i)
+                                               {
+                                                   if (listeners.Get(i) == info[1])
+                                                   {
+                                                       return;
+                                                   }
+                                               }
+
+                                               listeners.Set(listeners.Length(), info[1]);
+                                           },
+                                           "addEventListener"));
+
+        global.Set("removeEventListener", Napi::Function::New(
+                                              env, [](const Napi::CallbackInfo& info) {
+                                                  if (info[0].ToString().Utf8Value() != "message" || !info[1].IsFunction())
+                                                  {
+                                                      return;
+                                                  }
+
+                                                  auto native = JsRuntime::NativeObject::GetFromJavaScript(info.Env());
+                                                  const auto listeners = native.Get(JS_WORKER_LISTENERS_NAME).As<Napi::Array>();
+                                                  auto remaining = Napi::Array::New(info.Env());
+                                                  for (uint32_t i = 0; i < listeners.Length(); ++i)
+                                                  {
+                                                      if (listeners.Get(i) != info[1])
+                                                      {
+                                                          remaining.Set(remaining.Length(), listeners.Get(i));
+                                                      }
+                                                  }
+
+                                                  native.Set(JS_WORKER_LISTENERS_NAME, remaining);
+                                              },
+                                              "removeEventListener"));
+    }
+
+    void Worker::Scope::Post(Message message)
+    {
+        m_pending.push_back(std::move(message));
+        if (m_started && m_pending.size() == 1)
+        {
+            Schedule();
+        }
+    }
+
+    void Worker::Scope::Start()
+    {
+        if (m_started || m_runtime == nullptr)
+        {
+            return;
+        }
+
+        m_started = true;
+        if (!m_pending.empty())
+        {
+            Schedule();
+        }
+    }
+
+    void Worker::Scope::Schedule()
+    {
+        m_runtime->Dispatch([self = shared_from_this()](Napi::Env env) {
+            self->Drain(env);
+        });
+    }
+
+    void Worker::Scope::Drain(Napi::Env env)
+    {
+        Message message = std::move(m_pending.front());
+        m_pending.pop_front();
+
+        // Scheduled before delivering, so the rest still arrive if a handler
+        // throws.
+        if (!m_pending.empty())
+        {
+            Schedule();
+        }
+
+        Dispatch(env, std::move(message));
+    }
+
+    void Worker::Scope::Dispatch(Napi::Env env, Message message)
+    {
+        auto global = env.Global();
+
+        Napi::Object event = Napi::Object::New(env);
+        event.Set("type", "message");
+        event.Set("data", StructuredClone::Deserialize(env, std::move(*message)));
+        event.Set("target", global);
+
+        // Copied first, since handlers may add or remove listeners.
+        std::vector<Napi::Function> handlers{};
+        const auto onmessage = global.Get("onmessage");
+        if (onmessage.IsFunction())
+        {
+            handlers.push_back(onmessage.As<Napi::Function>());
+        }
+
+        const auto listeners = JsRuntime::NativeObject::GetFromJavaScript(env).Get(JS_WORKER_LISTENERS_NAME).As<Napi::Array>();
+        for (uint32_t i = 0; i < listeners.Length(); ++i)
+        {
+            handlers.push_back(listeners.Get(i).As<Napi::Function>());
+        }
+
+        for (const auto& handler : handlers)
+        {
+            handler.Call(global, {event});
+        }
+    }
+}
+
+namespace Babylon::Polyfills::Worker
+{
+    void BABYLON_API Initialize(Napi::Env env, EnvironmentInitializer initializer)
+    {
+        StartupTrace::Scope phase{env, "Polyfills::Worker::Initialize"};
+        Internal::Worker::Initialize(env, std::move(initializer));
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Babylon/AppRuntime.h>
+#include <Babylon/JsRuntime.h>
+#include <Babylon/Polyfills/StructuredClone.h>
+#include <Babylon/Polyfills/Worker.h>
+#include <Babylon/ScriptLoader.h>
+#include <napi/napi.h>
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Babylon::Polyfills::Internal
+{
+    // Runs a script in an AppRuntime of its own, so it gets a thread of its
+    // own. Messages cross between the runtimes as structured clones, and
+    // ArrayBuffers in a message's transfer list are moved rather than copied.
+    class Worker final : public Napi::ObjectWrap<Worker>
+    {
+        // Shared so the callbacks carrying it stay copyable. Deserialized once.
+        using Message = std::shared_ptr<StructuredClone::SerializedValue>;
+
+    public:
+        static constexpr auto JS_WORKER_CONSTRUCTOR_NAME = "Worker";
+
+        static void Initialize(Napi::Env env, Polyfills::Worker::EnvironmentInitializer initializer);
+        explicit Worker(const Napi::CallbackInfo& info);
+        ~Worker();
+
+    private:
+        // Lets the worker's thread reach the Worker for as long as it exists.
+        class Channel : public std::enable_shared_from_this<Channel>
+        {
+        public:
+            Channel(Babylon::JsRuntime& parent, Worker& target);
+
+            // Runs `callback` on the parent's JavaScript thread, unless the
+            // Worker has been terminated or destroyed by then.
+            void Post(std::function<void(Worker&)> callback);
+            void Disconnect();
+
+        private:
+            std::mutex m_mutex{};
+            Babylon::JsRuntime& m_parent;
+            Worker* m_target;
+        };
+
+        // Destroys the runtimes of stopped workers on threads of their own, so
+        // the parent's JavaScript thread, which may be running a finalizer,
+        // never waits for a worker's thread to wind down. Shared by the Workers
+        // of an environment, and waits for the runtimes still being destroyed
+        // once the last of them and the environment are gone.
+        class Releaser
+        {
+        public:
+            static std::shared_ptr<Releaser> GetFromJavaScript(Napi::Env env);
+
+            // Must be called on the parent's JavaScript thread.
+            void Release(std::unique_ptr<Babylon::AppRuntime> runtime);
+
+        private:
+            std::vector<std::future<void>> m_pending{};
+        };
+
+        // The globals of the worker's environment, and the messages sent to it.
+        // Only used on the worker's thread.
+        class Scope : public std::enable_shared_from_this<Scope>
+        {
+        public:
+            static void Initialize(Napi::Env env, const std::shared_ptr<Scope>& scope, const std::shared_ptr<Channel>& channel);
+
+            // Delivers `message` in a dispatch of its own, once the worker's
+            // script has run.
+            void Post(Message message);
+
+            // Called once the worker's script has run, or failed to.
+            void Start();
+
+        private:
+            void Schedule();
+            void Drain(Napi::Env env);
+            void Dispatch(Napi::Env env, Message message);
+
+            Babylon::JsRuntime* m_runtime{};
+            bool m_started{false};
+            std::deque<Message> m_pending{};
+        };
+
+        void PostMessage(const Napi::CallbackInfo& info);
+        void Terminate(const Napi::CallbackInfo& info);
+
+        Napi::Value GetOnMessage(const Napi::CallbackInfo& info);
+        void SetOnMessage(const Napi::CallbackInfo&, const Napi::Value& value);
+        Napi::Value GetOnError(const Napi::CallbackInfo& info);
+        void SetOnError(const Napi::CallbackInfo&, const Napi::Value& value);
+
+        void AddEventListener(const Napi::CallbackInfo& info);
+        void RemoveEventListener(const Napi::CallbackInfo& info);
+
+        void DispatchMessage(Message message);
+        void DispatchError(const std::string& message);
+        void DispatchEvent(const std::string& type, Napi::Object event);
+
+        // Stops the worker's runtime, aborting the script it is running, and
+        // destroys it without waiting.
+        void Stop();
+        void ReleaseRuntime();
+
+        std::shared_ptr<Channel> m_channel;
+        std::shared_ptr<Scope> m_scope;
+        std::shared_ptr<Releaser> m_releaser;
+        std::unique_ptr<Babylon::AppRuntime> m_runtime{};
+        std::unique_ptr<Babylon::ScriptLoader> m_loader{};
+
+        Napi::FunctionReference m_onmessage;
+        Napi::FunctionReference m_onerror;
+
+        struct Listener
+        {
+            std::string Type;
+            Napi::FunctionReference Function;
+        };
+        std::vector<Listener> m_listeners{};
+
+        // Keeps the Worker alive while its runtime runs, since the worker may
+        // still post messages to it. Released once the worker is stopped.
+        Napi::ObjectReference m_selfReference{};
+    };
+}
@@ -1,7 +1,10 @@
 #include "XMLHttpRequest.h"
 #include <Babylon/JsRuntime.h>
 #include <Babylon/Polyfills/XMLHttpRequest.h>
+#include <Babylon/StartupTrace.h>
+#include <TaskAwaiter.h>
 #include <arcana/tracing/trace_region.h>
+#include <optional>
 #include <sstream>
 
 namespace Babylon::Polyfills::Internal
@@ -290,43 +293,43 @@ namespace Babylon::Polyfills::Internal
             }
         }
 
+        // Keep the JS wrapper (and therefore this C++ object) alive for the
+        // duration of the asynchronous request. The coroutine below uses `this`
+        // when the request settles; without an anchor, GC may collect the
+        // wrapper while the request is in flight (e.g. once the requesting
+        // script drops its reference) and the coroutine would then resume on a
+        // freed `this`. The anchor is a parameter of the coroutine, so it is
+        // released automatically once the request settles and the coroutine
+        // finishes -- no member self-reference to clear. (Mirrors FileReader's
+        // anchor.)
+        SendRequest(std::make_shared<Napi::ObjectReference>(Napi::Persistent(info.This().As<Napi::Object>())));
+    }
+
+    Coroutine XMLHttpRequest::SendRequest([[maybe_unused]] std::shared_ptr<Napi::ObjectReference> anchor)
+    {
         std::string traceName = (std::ostringstream{} << "XMLHttpRequest::Send [" << m_url << "]").str();
         auto sendRegion = std::make_optional<arcana::trace_region>(traceName.c_str());
 
-        // Keep the JS wrapper (and therefore this C++ object) alive for the
-        // duration of the asynchronous request. The continuation below captures
-        // `this` raw and dereferences members when the request settles; without
-        // an anchor, GC may collect the wrapper while the request is in flight
-        // (e.g. once the requesting script drops its reference) and the
-        // continuation would then run on a freed `this`. The anchor lives in a
-        // shared_ptr owned by the continuation lambda, so it is released
-        // automatically once the request settles and the lambda is destroyed --
-        // no member self-reference to clear. (Mirrors FileReader's anchor.)
-        auto anchor = std::make_shared<Napi::ObjectReference>(Napi::Persistent(info.This().As<Napi::Object>()));
-
-        m_request.SendAsync()
-            .then(arcana::inline_scheduler, arcana::cancellation::none(), [sendRegion{std::move(sendRegion)}]() mutable {
-                sendRegion.reset();
-            })
-            .then(m_runtimeScheduler, arcana::cancellation::none(), [this, anchor{std::move(anchor)}](const arcana::expected<void, std::exception_ptr>& result) {
-                // Run on every outcome -- transport exception OR underlying request succeeded but ended in a non-2xx
-                // status (e.g. a missing local file on UWP, where UrlLib silently retains status 0). The previous
-                // success-only continuation here skipped readyState=Done / loadend / error and let the JS observer
-                // hang.
-                const auto statusCode = arcana::underlying_cast(m_request.StatusCode());
-                const bool failed = result.has_error() || statusCode < 200 || statusCode >= 300;
-
-                SetReadyState(ReadyState::Done);
-                if (failed)
-                {
-                    RaiseEvent(EventType::Error);
-                }
-                RaiseEvent(EventType::LoadEnd);
+        const auto result = co_await TaskAwaiter{m_runtimeScheduler, m_request.SendAsync()};
+        sendRegion.reset();
 
-                // Assume the XMLHttpRequest will only be used for a single request and clear the event handlers.
-                // Single use seems to be the standard pattern, and we need to release our strong refs to event handlers.
-                m_eventHandlerRefs.clear();
-            });
+        // Run on every outcome -- transport exception OR underlying request succeeded but ended in a non-2xx
+        // status (e.g. a missing local file on UWP, where UrlLib silently retains status 0). The previous
+        // success-only continuation here skipped readyState=Done / loadend / error and let the JS observer
+        // hang.
+        const auto statusCode = arcana::underlying_cast(m_request.StatusCode());
+        const bool failed = result.has_error() || statusCode < 200 || statusCode >= 300;
+
+        SetReadyState(ReadyState::Done);
+        if (failed)
+        {
+            RaiseEvent(EventType::Error);
+        }
+        RaiseEvent(EventType::LoadEnd);
+
+        // Assume the XMLHttpRequest will only be used for a single request and clear the event handlers.
+        // Single use seems to be the standard pattern, and we need to release our strong refs to event handlers.
+        m_eventHandlerRefs.clear();
     }
 
     void XMLHttpRequest::SetReadyState(ReadyState readyState)
@@ -355,6 +358,7 @@ namespace Babylon::Polyfills::XMLHttpRequest
 {
     void BABYLON_API Initialize(Napi::Env env)
     {
+        StartupTrace::Scope phase{env, "Polyfills::XMLHttpRequest::Initialize"};
         Internal::XMLHttpRequest::Initialize(env);
     }
 }
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <Babylon/Coroutine.h>
 #include <Babylon/JsRuntimeScheduler.h>
 
 #include <napi/napi.h>
 #include <UrlLib/UrlLib.h>
 
+#include <memory>
 #include <unordered_map>
 
 namespace Babylon::Polyfills::Internal
@@ -44,6 +46,10 @@ namespace Babylon::Polyfills::Internal
         void Open(const Napi::CallbackInfo& info);
         void Send(const Napi::CallbackInfo& info);
 
+        // Sends the request and raises the completion events on the JavaScript
+        // thread once it settles. `anchor` keeps the JS wrapper alive meanwhile.
+        Coroutine SendRequest(std::shared_ptr<Napi::ObjectReference> anchor);
+
         void SetReadyState(ReadyState readyState);
         void RaiseEvent(const char* eventType);
 
@@ -541,24 +541,41 @@ describe("setTimeout", function () {
         trailingCodeExecuted = true;
     });
 
-    // See https://github.com/BabylonJS/JsRuntimeHost/issues/9
-    // it("should call the given functions in the correct order", function (done) {
-    //     const called = [];
-    //     for (let i = 9; i >= 0; i--) {
-    //         setTimeout(() => {
-    //             called.push(i);
-    //             if (called.length === 10) {
-    //                 try {
-    //                     expect(called).to.deep.equal([0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
-    //                     done();
-    //                 }
-    //                 catch (e) {
-    //                     done(e);
-    //                 }
-    //             }
-    //         }, i * 10);
-    //     }
-    // });
+    it("should call the given functions in the correct order", function (done) {
+        const called = [];
+        for (let i = 9; i >= 0; i--) {
+            setTimeout(() => {
+                called.push(i);
+                if (called.length === 10) {
+                    try {
+                        expect(called).to.deep.equal([0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+                        done();
+                    }
+                    catch (e) {
+                        done(e);
+                    }
+                }
+            }, i * 10);
+        }
+    });
+
+    it("should call functions with the same delay in the order they were set", function (done) {
+        const called = [];
+        for (let i = 0; i < 10; i++) {
+            setTimeout(() => {
+                called.push(i);
+                if (called.length === 10) {
+                    try {
+                        expect(called).to.deep.equal([0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+                        done();
+                    }
+                    catch (e) {
+                        done(e);
+                    }
+                }
+            }, 5);
+        }
+    });
 });
 
 describe("clearTimeout", function () {
@@ -641,6 +658,292 @@ describe("clearInterval", function () {
     });
 });
 
+describe("queueMicrotask", function () {
+    this.timeout(5000);
+
+    it("should run the callback before the next task", function (done) {
+        const called: string[] = [];
+        setTimeout(() => {
+            try {
+                expect(called).to.deep.equal(["sync", "microtask"]);
+                done();
+            }
+            catch (e) {
+                done(e);
+            }
+        }, 0);
+        queueMicrotask(() => called.push("microtask"));
+        called.push("sync");
+    });
+
+    it("should run callbacks in the order they were queued", function (done) {
+        const called: number[] = [];
+        queueMicrotask(() => called.push(0));
+        Promise.resolve().then(() => called.push(1));
+        queueMicrotask(() => {
+            called.push(2);
+            try {
+                expect(called).to.deep.equal([0, 1, 2]);
+                done();
+            }
+            catch (e) {
+                done(e);
+            }
+        });
+    });
+});
+
+describe("setImmediate", function () {
+    this.timeout(5000);
+
+    it("should call the function after the current task with the given arguments", function (done) {
+        let trailingCodeExecuted = false;
+        setImmediate((a: number, b: string) => {
+            try {
+                expect(trailingCodeExecuted).to.be.true;
+                expect(a).to.equal(1);
+                expect(b).to.equal("two");
+                done();
+            }
+            catch (e) {
+                done(e);
+            }
+        }, 1, "two");
+        trailingCodeExecuted = true;
+    });
+
+    it("should call functions in the order they were set", function (done) {
+        const called: number[] = [];
+        for (let i = 0; i < 5; i++) {
+            setImmediate(() => {
+                called.push(i);
+                if (called.length === 5) {
+                    try {
+                        expect(called).to.deep.equal([0, 1, 2, 3, 4]);
+                        done();
+                    }
+                    catch (e) {
+                        done(e);
+                    }
+                }
+            });
+        }
+    });
+
+    it("should be stopped by clearImmediate", function (done) {
+        const id = setImmediate(() => {
+            done(new Error("Immediate was not cleared"));
+        });
+        clearImmediate(id);
+        setTimeout(done, 50);
+    });
+});
+
+describe("MessageChannel", function () {
+    this.timeout(5000);
+
+    it("should deliver messages to the other port in order", function (done) {
+        const channel = new MessageChannel();
+        const received: number[] = [];
+        channel.port1.onmessage = (event: MessageEvent) => {
+            received.push(event.data);
+            if (received.length === 3) {
+                try {
+                    expect(received).to.deep.equal([1, 2, 3]);
+                    done();
+                }
+                catch (e) {
+                    done(e);
+                }
+            }
+        };
+        channel.port2.postMessage(1);
+        channel.port2.postMessage(2);
+        channel.port2.postMessage(3);
+    });
+
+    it("should deliver messages after the current task", function (done) {
+        const channel = new MessageChannel();
+        let trailingCodeExecuted = false;
+        channel.port2.addEventListener("message", () => {
+            try {
+                expect(trailingCodeExecuted).to.be.true;
+                done();
+            }
+            catch (e) {
+                done(e);
+            }
+        });
+        channel.port2.start();
+        channel.port1.postMessage(null);
+        trailingCodeExecuted = true;
+    });
+
+    it("should not deliver messages once closed", function (done) {
+        const channel = new MessageChannel();
+        channel.port1.onmessage = () => done(new Error("Message was delivered to a closed port"));
+        channel.port2.postMessage("message");
+        channel.port1.close();
+        setTimeout(done, 50);
+    });
+});
+
+describe("structuredClone", function () {
+    it("should clone plain values", function () {
+        const value = { number: 1, string: "two", array: [true, null, undefined], nested: { three: 3 } };
+        const clone = structuredClone(value);
+        expect(clone).to.not.equal(value);
+        expect(clone.nested).to.not.equal(value.nested);
+        expect(clone).to.deep.equal(value);
+    });
+
+    it("should preserve shared references and cycles", function () {
+        const shared = { name: "shared" };
+        const value: any = { first: shared, second: shared };
+        value.self = value;
+        const clone = structuredClone(value);
+        expect(clone.first).to.equal(clone.second);
+        expect(clone.self).to.equal(clone);
+    });
+
+    it("should clone Dates, RegExps, Maps and Sets", function () {
+        const date = new Date(2020, 1, 2);
+        const clone = structuredClone({ date, regexp: /a+b/gi, map: new Map([["key", { value: 1 }]]), set: new Set([1, "two"]) });
+        expect(clone.date).to.be.instanceOf(Date);
+        expect(clone.date.getTime()).to.equal(date.getTime());
+        expect(clone.regexp).to.be.instanceOf(RegExp);
+        expect(clone.regexp.source).to.equal("a+b");
+        expect(clone.regexp.flags).to.equal("gi");
+        expect(clone.map).to.be.instanceOf(Map);
+        expect(clone.map.get("key")).to.deep.equal({ value: 1 });
+        expect(clone.set).to.be.instanceOf(Set);
+        expect(Array.from(clone.set)).to.deep.equal([1, "two"]);
+    });
+
+    it("should clone typed arrays that share a buffer", function () {
+        const buffer = new ArrayBuffer(8);
+        const bytes = new Uint8Array(buffer);
+        const words = new Uint16Array(buffer, 2, 2);
+        bytes.set([1, 2, 3, 4, 5, 6, 7, 8]);
+        const clone = structuredClone({ bytes, words });
+        expect(clone.bytes.buffer).to.not.equal(buffer);
+        expect(clone.bytes.buffer).to.equal(clone.words.buffer);
+        expect(clone.words.byteOffset).to.equal(2);
+        expect(clone.words.length).to.equal(2);
+        clone.bytes[0] = 42;
+        expect(bytes[0]).to.equal(1);
+    });
+
+    it("should clone Blobs", async function () {
+        const clone = structuredClone(new Blob(["hello"], { type: "text/plain" }));
+        expect(clone).to.be.instanceOf(Blob);
+        expect(clone.type).to.equal("text/plain");
+        expect(await clone.text()).to.equal("hello");
+    });
+
+    it("should throw a DataCloneError for functions", function () {
+        try {
+            structuredClone({ callback: () => {} });
+            expect.fail("structuredClone should have thrown");
+        }
+        catch (e: any) {
+            expect(e.name).to.equal("DataCloneError");
+        }
+    });
+
+    it("should move transferred ArrayBuffers", function () {
+        const buffer = new Uint8Array([1, 2, 3]).buffer;
+        const clone = structuredClone(buffer, { transfer: [buffer] });
+        expect(Array.from(new Uint8Array(clone))).to.deep.equal([1, 2, 3]);
+
+        // Engines without ArrayBuffer.prototype.transfer can't detach the source.
+        if (typeof (ArrayBuffer.prototype as any).transfer === "function") {
+            expect(buffer.byteLength).to.equal(0);
+        }
+    });
+
+    it("should transfer a received ArrayBuffer again", function () {
+        const buffer = new Uint8Array([4, 5, 6]).buffer;
+        const first = structuredClone(buffer, { transfer: [buffer] });
+        const second = structuredClone(first, { transfer: [first] });
+        expect(Array.from(new Uint8Array(second))).to.deep.equal([4, 5, 6]);
+
+        if (typeof (ArrayBuffer.prototype as any).transfer === "function") {
+            expect(first.byteLength).to.equal(0);
+        }
+    });
+});
+
+describe("Worker", function () {
+    this.timeout(5000);
+
+    it("should exchange messages with the worker", function (done) {
+        const worker = new Worker("app:///Scripts/worker.js");
+        worker.onmessage = (event: MessageEvent) => {
+            try {
+                expect(event.data).to.deep.equal({ echo: [1, "two", { three: 3 }], hasSelf: true });
+                done();
+            }
+            catch (e) {
+                done(e);
+            }
+            finally {
+                worker.terminate();
+            }
+        };
+        worker.postMessage({ command: "echo", value: [1, "two", { three: 3 }] });
+    });
+
+    it("should report errors thrown in the worker and keep running", function (done) {
+        const worker = new Worker("app:///Scripts/worker.js");
+        let errorMessage = "";
+        worker.addEventListener("error", (event: any) => {
+            errorMessage = event.message;
+        });
+        worker.onmessage = (event: MessageEvent) => {
+            try {
+                expect(errorMessage).to.contain("worker failure");
+                expect(event.data.echo).to.equal("still running");
+                done();
+            }
+            catch (e) {
+                done(e);
+            }
+            finally {
+                worker.terminate();
+            }
+        };
+        worker.postMessage({ command: "throw", value: "worker failure" });
+        worker.postMessage({ command: "echo", value: "still running" });
+    });
+
+    it("should transfer ArrayBuffers to and from the worker", function (done) {
+        const worker = new Worker("app:///Scripts/worker.js");
+        const buffer = new Uint8Array([1, 2, 3]).buffer;
+        worker.onmessage = (event: MessageEvent) => {
+            try {
+                expect(Array.from(new Uint8Array(event.data.echo))).to.deep.equal([2, 2, 3]);
+                done();
+            }
+            catch (e) {
+                done(e);
+            }
+            finally {
+                worker.terminate();
+            }
+        };
+        worker.postMessage({ command: "transferBack", value: buffer }, [buffer]);
+    });
+
+    it("should not deliver messages once terminated", function (done) {
+        const worker = new Worker("app:///Scripts/worker.js");
+        worker.onmessage = () => done(new Error("Message was delivered after terminate"));
+        worker.postMessage({ command: "delayedEcho", value: "late" });
+        setTimeout(() => worker.terminate(), 0);
+        setTimeout(done, 100);
+    });
+});
+
 // Websocket
 if (hostPlatform !== "Unix") {
     describe("WebSocket", function () {
@@ -0,0 +1,22 @@
+// Runs in a Worker for the Worker tests.
+onmessage = function (event) {
+    switch (event.data.command) {
+        case "echo":
+            postMessage({ echo: event.data.value, hasSelf: self === globalThis });
+            break;
+        case "throw":
+            throw new Error(event.data.value);
+        case "delayedEcho":
+            setTimeout(() => postMessage({ echo: event.data.value }), 10);
+            break;
+        case "transferBack": {
+            const buffer = event.data.value;
+            new Uint8Array(buffer)[0] += 1;
+            postMessage({ echo: buffer }, [buffer]);
+            break;
+        }
+        case "close":
+            close();
+            break;
+    }
+};
@@ -1,6 +1,9 @@
 #include "Shared.h"
 #include <Babylon/AppRuntime.h>
+#include <Babylon/AppRuntimePool.h>
+#include <Babylon/JsRuntimeScheduler.h>
 #include <Babylon/ScriptLoader.h>
+#include <Babylon/SharedMemory.h>
 #include <Babylon/Polyfills/AbortController.h>
 #include <Babylon/Polyfills/Console.h>
 #include <Babylon/Polyfills/Performance.h>
@@ -13,14 +16,57 @@
 #include <Babylon/Polyfills/File.h>
 #include <Babylon/Polyfills/TextDecoder.h>
 #include <Babylon/Polyfills/TextEncoder.h>
+#include <Babylon/Polyfills/StructuredClone.h>
+#include <Babylon/Polyfills/Worker.h>
+#include <TaskAwaiter.h>
 #include <gtest/gtest.h>
 #include <arcana/threading/blocking_concurrent_queue.h>
+#include <arcana/threading/task.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <cstdlib>
 #include <future>
 #include <iostream>
+#include <new>
+#include <optional>
+#include <stdexcept>
 #include <thread>
+#include <utility>
+
+namespace
+{
+    // Heap allocations made through operator new while counting is on, on any
+    // thread, for the allocation benchmarks.
+    std::atomic<bool> g_countAllocations{};
+    std::atomic<size_t> g_allocations{};
+}
+
+void* operator new(std::size_t size)
+{
+    if (g_countAllocations.load(std::memory_order_relaxed))
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* data = std::malloc(size == 0 ? 1 : size))
+    {
+        return data;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* data) noexcept
+{
+    std::free(data);
+}
+
+void operator delete(void* data, std::size_t) noexcept
+{
+    std::free(data);
+}
 
 namespace
 {
@@ -90,6 +136,12 @@ TEST(JavaScript, All)
         Babylon::Polyfills::File::Initialize(env);
         Babylon::Polyfills::TextDecoder::Initialize(env);
         Babylon::Polyfills::TextEncoder::Initialize(env);
+        Babylon::Polyfills::StructuredClone::Initialize(env);
+        Babylon::Polyfills::Worker::Initialize(env, [](Napi::Env env) {
+            Babylon::Polyfills::Scheduling::Initialize(env);
+            Babylon::Polyfills::Blob::Initialize(env);
+            Babylon::Polyfills::StructuredClone::Initialize(env);
+        });
 
         auto setExitCodeCallback = Napi::Function::New(
             env, [&exitCodePromise](const Napi::CallbackInfo& info) {
@@ -182,6 +234,119 @@ TEST(Console, CaptureCurrentJsStack)
     EXPECT_FALSE(logStack.empty()) << "console.log path must capture a non-empty JS stack";
 }
 
+TEST(Scheduling, TimersFireInEveryRuntime)
+{
+    // Runtimes share one timer thread; each must still get its own timers back.
+    constexpr size_t count = 4;
+    std::array<std::optional<Babylon::AppRuntime>, count> runtimes{};
+    std::array<std::optional<Babylon::ScriptLoader>, count> loaders{};
+    std::array<std::promise<int32_t>, count> results{};
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        runtimes[i].emplace();
+        runtimes[i]->Dispatch([&result = results[i]](Napi::Env env) {
+            Babylon::Polyfills::Scheduling::Initialize(env);
+
+            env.Global().Set("done", Napi::Function::New(env, [&result](const Napi::CallbackInfo& info) {
+                result.set_value(info[0].As<Napi::Number>().Int32Value());
+            }));
+        });
+
+        loaders[i].emplace(*runtimes[i]);
+        loaders[i]->Eval(
+            "let fired = 0;"
+            "for (let i = 0; i < 10; ++i) { setTimeout(() => { if (++fired === 10) { done(fired); } }, i); }"
+            "clearTimeout(setTimeout(() => { fired = -100; }, 5));",
+            "");
+    }
+
+    for (auto& result : results)
+    {
+        auto future = result.get_future();
+        ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+        EXPECT_EQ(future.get(), 10);
+    }
+}
+
+TEST(Scheduling, SuspendedRuntimeCoalescesIntervals)
+{
+    // An interval that comes due many times while the runtime is suspended
+    // fires once on resume instead of once per missed period.
+    Babylon::AppRuntime runtime{};
+    std::promise<int32_t> result{};
+
+    runtime.Dispatch([&result](Napi::Env env) {
+        Babylon::Polyfills::Scheduling::Initialize(env);
+
+        env.Global().Set("done", Napi::Function::New(env, [&result](const Napi::CallbackInfo& info) {
+            result.set_value(info[0].As<Napi::Number>().Int32Value());
+        }));
+    });
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("let ticks = 0; setInterval(() => { ++ticks; }, 5);", "");
+
+    runtime.Suspend();
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+    loader.Eval("done(ticks);", "");
+    runtime.Resume();
+
+    auto future = result.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_LE(future.get(), 2);
+}
+
+TEST(Scheduling, ThrottlingClampsDelays)
+{
+    Babylon::AppRuntime runtime{};
+    std::promise<void> fired{};
+
+    runtime.Dispatch([&fired](Napi::Env env) {
+        Babylon::Polyfills::Scheduling::Initialize(env);
+        Babylon::Polyfills::Scheduling::SetThrottling(env, {std::chrono::milliseconds{200}, std::chrono::milliseconds{50}});
+
+        env.Global().Set("done", Napi::Function::New(env, [&fired](const Napi::CallbackInfo&) {
+            fired.set_value();
+        }));
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("setTimeout(() => done(), 0);", "");
+
+    auto future = fired.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{200});
+}
+
+TEST(Scheduling, MicrotasksRunBetweenTimers)
+{
+    // Timers that expire together still each get their microtasks drained
+    // before the next one fires.
+    Babylon::AppRuntime runtime{};
+    std::promise<std::string> result{};
+
+    runtime.Dispatch([&result](Napi::Env env) {
+        Babylon::Polyfills::Scheduling::Initialize(env);
+
+        env.Global().Set("done", Napi::Function::New(env, [&result](const Napi::CallbackInfo& info) {
+            result.set_value(info[0].As<Napi::String>().Utf8Value());
+        }));
+    });
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval(
+        "let order = '';"
+        "setTimeout(() => { order += 'a'; Promise.resolve().then(() => { order += 'b'; }); }, 0);"
+        "setTimeout(() => { order += 'c'; done(order); }, 0);",
+        "");
+
+    auto future = result.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_EQ(future.get(), "abc");
+}
+
 TEST(AppRuntime, DestroyDoesNotDeadlock)
 {
     // Regression test verifying AppRuntime destruction doesn't deadlock.
@@ -403,6 +568,1123 @@ TEST(NodeApi, GetValueStringUtf16HandlesZeroBufsize)
 }
 #endif
 
+#if defined(JSRUNTIMEHOST_POOLED_ALLOCATOR)
+TEST(AppRuntime, PooledAllocatorCountsArrayBufferAllocations)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<void> allocated;
+    runtime.Dispatch([&allocated](Napi::Env env) {
+        for (int i = 0; i < 100; ++i)
+        {
+            Napi::HandleScope scope{env};
+            Napi::ArrayBuffer::New(env, 1024);
+        }
+        allocated.set_value();
+    });
+    allocated.get_future().wait();
+
+    const auto statistics = runtime.GetAllocatorStatistics();
+    EXPECT_GE(statistics.Allocations, 100u);
+    EXPECT_GE(statistics.PeakBytesInUse, 1024u);
+    EXPECT_GE(statistics.PeakBytesInUse, statistics.BytesInUse);
+}
+#endif
+
+TEST(AppRuntime, EngineTuningOptionsStillRunScripts)
+{
+    // The process-wide V8 settings (V8Flags, EnableJIT) are left alone so they
+    // don't leak into the other tests.
+    Babylon::AppRuntime::Options options{};
+    options.InitialHeapSize = 4 * 1024 * 1024;
+    options.MaxHeapSize = 256 * 1024 * 1024;
+    options.GCThreshold = 1024 * 1024;
+    options.MaxStackSize = 512 * 1024;
+    Babylon::AppRuntime runtime{options};
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("globalThis.tuned = Array.from({ length: 1000 }, (_, i) => i).reduce((a, b) => a + b);", "");
+
+    std::promise<int32_t> result;
+    loader.Dispatch([&result](Napi::Env env) {
+        result.set_value(env.Global().Get("tuned").As<Napi::Number>().Int32Value());
+    });
+    EXPECT_EQ(result.get_future().get(), 499500);
+}
+
+#if defined(JSRUNTIMEHOST_MAX_STACK_SIZE)
+TEST(AppRuntime, MaxStackSizeLimitsRecursionDepth)
+{
+    // Recurses until the engine throws its stack overflow error and returns how
+    // deep it got.
+    const auto measureDepth = [](const Babylon::AppRuntime::Options& options) {
+        Babylon::AppRuntime runtime{options};
+
+        Babylon::ScriptLoader loader{runtime};
+        loader.Eval(
+            "globalThis.depth = 0;"
+            "const recurse = () => { ++globalThis.depth; recurse(); };"
+            "try { recurse(); } catch (e) { globalThis.overflowed = true; }",
+            "");
+
+        std::promise<std::pair<bool, int32_t>> result;
+        loader.Dispatch([&result](Napi::Env env) {
+            result.set_value({env.Global().Get("overflowed").ToBoolean(), env.Global().Get("depth").As<Napi::Number>().Int32Value()});
+        });
+        return result.get_future().get();
+    };
+
+    const auto [defaultOverflowed, defaultDepth] = measureDepth({});
+
+    Babylon::AppRuntime::Options limited{};
+    limited.MaxStackSize = 64 * 1024;
+    const auto [limitedOverflowed, limitedDepth] = measureDepth(limited);
+
+    EXPECT_TRUE(defaultOverflowed);
+    EXPECT_TRUE(limitedOverflowed);
+    EXPECT_GT(limitedDepth, 0);
+    EXPECT_LT(limitedDepth, defaultDepth);
+}
+#endif
+
+TEST(AppRuntime, NotifyMemoryPressureKeepsRuntimeUsable)
+{
+    Babylon::AppRuntime runtime{};
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("globalThis.kept = { value: 42 }; for (let i = 0; i < 1000; ++i) { new ArrayBuffer(1024); }", "");
+
+    runtime.NotifyMemoryPressure(Babylon::AppRuntime::MemoryPressureLevel::Moderate);
+    runtime.NotifyMemoryPressure(Babylon::AppRuntime::MemoryPressureLevel::Critical);
+
+    std::promise<int32_t> result;
+    loader.Dispatch([&result](Napi::Env env) {
+        result.set_value(env.Global().Get("kept").As<Napi::Object>().Get("value").As<Napi::Number>().Int32Value());
+    });
+    EXPECT_EQ(result.get_future().get(), 42);
+}
+
+#if defined(JSRUNTIMEHOST_GC_EVENTS)
+TEST(AppRuntime, GCEventsAreRecorded)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::atomic<int> starts{0};
+    const uint32_t subscription = runtime.SubscribeToGCEvents([&starts](const Babylon::AppRuntime::GCEvent& event) {
+        if (event.Phase == Babylon::AppRuntime::GCPhase::Start)
+        {
+            ++starts;
+        }
+    });
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("for (let i = 0; i < 10000; ++i) { ({ garbage: [i] }); }", "");
+    runtime.NotifyMemoryPressure(Babylon::AppRuntime::MemoryPressureLevel::Critical);
+
+    // Runs after the collection requested above.
+    std::promise<void> collected;
+    loader.Dispatch([&collected](Napi::Env) {
+        collected.set_value();
+    });
+    collected.get_future().wait();
+
+    runtime.UnsubscribeFromGCEvents(subscription);
+
+    const auto statistics = runtime.GetGCStatistics();
+    EXPECT_GT(starts.load(), 0);
+    EXPECT_GE(statistics.Collections, static_cast<uint64_t>(starts.load()));
+    EXPECT_GE(statistics.TotalPause, statistics.LongestPause);
+}
+#endif
+
+TEST(AppRuntime, RequestInterruptRunsWhenIdle)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<bool> ran;
+    runtime.RequestInterrupt([&ran](Napi::Env env) {
+        ran.set_value(env.Global().IsObject());
+    });
+    EXPECT_TRUE(ran.get_future().get());
+}
+
+#if defined(JSRUNTIMEHOST_SCRIPT_INTERRUPTS)
+TEST(AppRuntime, RequestInterruptPreemptsRunningScript)
+{
+    Babylon::AppRuntime runtime{};
+
+    // The interrupt only records that it ran; it doesn't touch the heap of the
+    // script it preempted. The script spins until it sees the flag, which isn't
+    // reset, so the interrupt may also run before the loop starts.
+    std::atomic<bool> interruptRan{false};
+    runtime.Dispatch([&interruptRan](Napi::Env env) {
+        env.Global().Set("interruptRan", Napi::Function::New(env, [&interruptRan](const Napi::CallbackInfo& info) {
+            return Napi::Boolean::New(info.Env(), interruptRan.load());
+        }));
+    });
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("while (!interruptRan()) {}", "");
+
+    std::promise<void> interrupted;
+    runtime.RequestInterrupt([&interruptRan, &interrupted](Napi::Env) {
+        interruptRan = true;
+        interrupted.set_value();
+    });
+    ASSERT_EQ(interrupted.get_future().wait_for(std::chrono::seconds{10}), std::future_status::ready);
+
+    std::promise<void> finished;
+    loader.Dispatch([&finished](Napi::Env) {
+        finished.set_value();
+    });
+    finished.get_future().wait();
+}
+
+TEST(AppRuntime, TerminateAbortsRunningScript)
+{
+    // Destroying the runtime after Terminate doesn't wait for the script,
+    // which never returns on its own.
+    std::optional<Babylon::AppRuntime> runtime{std::in_place};
+
+    std::promise<void> started;
+    runtime->Dispatch([&started](Napi::Env env) {
+        env.Global().Set("started", Napi::Function::New(env, [&started](const Napi::CallbackInfo&) {
+            started.set_value();
+        }));
+    });
+
+    {
+        Babylon::ScriptLoader loader{*runtime};
+        loader.Eval("started(); while (true) {}", "");
+    }
+    ASSERT_EQ(started.get_future().wait_for(std::chrono::seconds{10}), std::future_status::ready);
+
+    runtime->Terminate();
+    runtime.reset();
+}
+#endif
+
+TEST(AppRuntime, WatchdogReportsLongTasks)
+{
+    // Startup work may be reported too, so only the longest task is checked.
+    // Reports arrive on the JavaScript thread.
+    std::chrono::nanoseconds longest{};
+    bool terminated{false};
+
+    Babylon::AppRuntime::Options options{};
+    options.LongTaskThreshold = std::chrono::milliseconds{10};
+    options.LongTaskHandler = [&longest, &terminated](const Babylon::AppRuntime::LongTask& task) {
+        longest = std::max(longest, task.Duration);
+        terminated = terminated || task.Terminated;
+    };
+    Babylon::AppRuntime runtime{options};
+
+    runtime.Dispatch([](Napi::Env) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    });
+
+    // The report for the sleeping task is made before this runs.
+    std::promise<void> reported;
+    runtime.Dispatch([&reported](Napi::Env) {
+        reported.set_value();
+    });
+    reported.get_future().wait();
+
+    EXPECT_GE(longest, std::chrono::milliseconds{50});
+    EXPECT_FALSE(terminated);
+}
+
+#if defined(JSRUNTIMEHOST_SCRIPT_TERMINATION)
+TEST(AppRuntime, WatchdogTerminatesRunawayScript)
+{
+    std::promise<bool> terminated;
+    std::atomic<int> errors{0};
+
+    Babylon::AppRuntime::Options options{};
+    options.LongTaskThreshold = std::chrono::milliseconds{20};
+    options.ExecutionTimeLimit = std::chrono::milliseconds{100};
+    options.LongTaskHandler = [&terminated](const Babylon::AppRuntime::LongTask& task) {
+        if (task.Terminated)
+        {
+            terminated.set_value(true);
+        }
+    };
+    options.UnhandledExceptionHandler = [&errors](const Napi::Error&) {
+        ++errors;
+    };
+    Babylon::AppRuntime runtime{options};
+
+    // A failed eval stalls the loader's chain, so it gets a loader of its own.
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("while (true) {}", "");
+
+    ASSERT_EQ(terminated.get_future().wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_EQ(errors.load(), 1);
+
+    // Script runs normally afterwards.
+    std::promise<int32_t> result;
+    runtime.Dispatch([&result](Napi::Env env) {
+        auto parseInt = env.Global().Get("parseInt").As<Napi::Function>();
+        result.set_value(parseInt.Call({Napi::String::New(env, "42")}).As<Napi::Number>().Int32Value());
+    });
+    EXPECT_EQ(result.get_future().get(), 42);
+}
+#endif
+
+TEST(AppRuntime, DispatchMetricsRecordEachCallback)
+{
+    Babylon::AppRuntime::Options options{};
+    options.EnableDispatchMetrics = true;
+    Babylon::AppRuntime runtime{options};
+
+    constexpr int count = 20;
+    for (int i = 0; i < count; ++i)
+    {
+        runtime.Dispatch([](Napi::Env) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        });
+    }
+
+    std::promise<void> done;
+    runtime.Dispatch([&done](Napi::Env) {
+        done.set_value();
+    });
+    done.get_future().wait();
+
+    const auto metrics = runtime.GetDispatchMetrics();
+    EXPECT_GE(metrics.Execution.Count, static_cast<uint64_t>(count));
+    EXPECT_EQ(metrics.QueueLatency.Count, metrics.Execution.Count);
+    EXPECT_GE(metrics.Execution.Max, std::chrono::milliseconds{1});
+    EXPECT_LE(metrics.Execution.Percentile(50), metrics.Execution.Percentile(99));
+    EXPECT_LE(metrics.Execution.Percentile(99), metrics.Execution.Max);
+    EXPECT_GE(metrics.MaxQueueDepth, 1u);
+    EXPECT_EQ(metrics.QueueDepth, 0u);
+}
+
+TEST(AppRuntime, StartupReportListsEachPhase)
+{
+    Babylon::AppRuntime runtime{};
+    runtime.Dispatch([](Napi::Env env) {
+        Babylon::Polyfills::URL::Initialize(env);
+    });
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("globalThis.started = true;", "startup.js");
+
+    std::promise<void> done;
+    loader.Dispatch([&done](Napi::Env) {
+        done.set_value();
+    });
+    done.get_future().wait();
+
+    const auto report = runtime.GetStartupReport();
+    const auto find = [&report](const char* name) {
+        return std::find_if(report.begin(), report.end(), [name](const Babylon::StartupTrace::Phase& phase) {
+            return phase.Name == name;
+        });
+    };
+
+    const auto context = find("AppRuntime::CreateContext");
+    const auto jsRuntime = find("JsRuntime::CreateForJavaScript");
+    const auto url = find("Polyfills::URL::Initialize");
+    const auto eval = find("ScriptLoader::Eval");
+    ASSERT_NE(context, report.end());
+    ASSERT_NE(jsRuntime, report.end());
+    ASSERT_NE(url, report.end());
+    ASSERT_NE(eval, report.end());
+
+    // The report is ordered by start time, which follows the order the phases ran in.
+    EXPECT_LT(context, jsRuntime);
+    EXPECT_LT(jsRuntime, url);
+    EXPECT_LT(url, eval);
+    EXPECT_EQ(eval->Detail, "startup.js");
+}
+
+TEST(AppRuntime, IdleGCLeavesRuntimeUsable)
+{
+    Babylon::AppRuntime::Options options{};
+    options.IdleGCInterval = std::chrono::milliseconds{5};
+    options.IdleGCBudget = std::chrono::milliseconds{5};
+    Babylon::AppRuntime runtime{options};
+
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("globalThis.kept = { value: 42 }; for (let i = 0; i < 1000; ++i) { ({ garbage: [i] }); }", "");
+
+    // Give the idle watcher several intervals to collect between dispatches.
+    for (int i = 0; i < 3; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+        std::promise<int32_t> result;
+        loader.Dispatch([&result](Napi::Env env) {
+            result.set_value(env.Global().Get("kept").As<Napi::Object>().Get("value").As<Napi::Number>().Int32Value());
+        });
+        EXPECT_EQ(result.get_future().get(), 42);
+    }
+}
+
+#if defined(JSRUNTIMEHOST_NEAR_HEAP_LIMIT_CALLBACK)
+TEST(AppRuntime, NearHeapLimitCallbackCanRaiseLimit)
+{
+    std::atomic<int> calls{0};
+
+    Babylon::AppRuntime::Options options{};
+    options.MaxHeapSize = 32 * 1024 * 1024;
+    options.NearHeapLimitCallback = [&calls](size_t currentLimit, size_t) {
+        ++calls;
+        return currentLimit * 2;
+    };
+    Babylon::AppRuntime runtime{options};
+
+    // Retains well over 32 MiB on every engine.
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval("globalThis.kept = []; for (let i = 0; i < 100; ++i) { kept.push(new Array(100000).fill(i)); }", "");
+
+    std::promise<uint32_t> length;
+    loader.Dispatch([&length](Napi::Env env) {
+        length.set_value(env.Global().Get("kept").As<Napi::Array>().Length());
+    });
+    EXPECT_EQ(length.get_future().get(), 100u);
+    EXPECT_GT(calls.load(), 0);
+}
+#endif
+
+TEST(AppRuntimePool, LeasesWarmRuntimesAndRecyclesThem)
+{
+    Babylon::AppRuntimePool::Options options{};
+    options.Size = 2;
+    options.MaxLeasesPerRuntime = 2;
+    options.Initialize = [](Babylon::AppRuntime& runtime, std::function<void()> ready) {
+        runtime.Dispatch([ready = std::move(ready)](Napi::Env env) {
+            env.Global().Set("warm", true);
+            ready();
+        });
+    };
+    options.Reset = [](Napi::Env env) {
+        env.Global().Delete("leftover");
+    };
+
+    Babylon::AppRuntimePool pool{options};
+
+    // Each lease sees an initialized runtime without what earlier leases left.
+    for (int i = 0; i < 5; ++i)
+    {
+        auto lease = pool.Acquire();
+        std::promise<bool> clean;
+        lease.Dispatch([&clean](Napi::Env env) {
+            clean.set_value(env.Global().Get("warm").ToBoolean() && env.Global().Get("leftover").IsUndefined());
+            env.Global().Set("leftover", true);
+        });
+        EXPECT_TRUE(clean.get_future().get());
+    }
+
+    std::array<std::promise<bool>, 8> dispatched{};
+    for (auto& promise : dispatched)
+    {
+        pool.Dispatch([&promise](Napi::Env env) {
+            promise.set_value(env.Global().Get("warm").ToBoolean());
+        });
+    }
+    for (auto& promise : dispatched)
+    {
+        EXPECT_TRUE(promise.get_future().get());
+    }
+
+    const auto statistics = pool.GetStatistics();
+    EXPECT_EQ(statistics.Acquisitions, 5u);
+    EXPECT_GE(statistics.Hits, 1u);
+    EXPECT_GE(statistics.Retired, 2u);
+    EXPECT_GE(statistics.WarmUps, 3u);
+    EXPECT_GE(statistics.LongestWarmUp.count(), 0);
+    EXPECT_EQ(statistics.Leased, 0u);
+}
+
+TEST(AppRuntimePool, DispatchLeavesLeasedRuntimesAlone)
+{
+    // The first runtime to start fails to initialize; the pool drops it and
+    // starts another for the next Acquire.
+    std::atomic<int> initialized{0};
+    Babylon::AppRuntimePool::Options options{};
+    options.Size = 0;
+    options.MaxSize = 2;
+    options.Initialize = [&initialized](Babylon::AppRuntime& runtime, std::function<void()> ready) {
+        if (initialized++ == 0)
+        {
+            throw std::runtime_error{"Initialize failed"};
+        }
+        runtime.Dispatch([ready = std::move(ready)](Napi::Env) { ready(); });
+    };
+
+    Babylon::AppRuntimePool pool{options};
+    EXPECT_THROW(pool.Acquire(), std::runtime_error);
+
+    auto lease = pool.Acquire();
+    std::promise<void> marked;
+    lease.Dispatch([&marked](Napi::Env env) {
+        env.Global().Set("leased", true);
+        marked.set_value();
+    });
+    marked.get_future().get();
+
+    // Runs on a runtime started for it rather than on the leased one.
+    std::promise<bool> onLeased;
+    pool.Dispatch([&onLeased](Napi::Env env) {
+        onLeased.set_value(env.Global().Get("leased").ToBoolean());
+    });
+    EXPECT_FALSE(onLeased.get_future().get());
+    EXPECT_EQ(pool.GetStatistics().Leased, 1u);
+}
+
+TEST(AppRuntime, ContextsShareTheEngineButNotGlobals)
+{
+    if (!Babylon::AppRuntime::SupportsContexts())
+    {
+        GTEST_SKIP() << "The engine can't host several contexts";
+    }
+
+    Babylon::AppRuntime runtime{};
+    auto first = runtime.CreateContext();
+    auto second = runtime.CreateContext();
+
+    std::promise<std::thread::id> firstThread;
+    first->Dispatch([&firstThread](Napi::Env env) {
+        env.Global().Set("value", 42);
+        firstThread.set_value(std::this_thread::get_id());
+    });
+
+    std::promise<std::string> seen;
+    second->Dispatch([&seen, &first](Napi::Env secondEnv) {
+        const std::string inSecond = secondEnv.Global().Get("value").IsUndefined() ? "undefined" : "defined";
+        first->Dispatch([&seen, inSecond](Napi::Env firstEnv) {
+            seen.set_value(inSecond + "," + firstEnv.Global().Get("value").ToString().Utf8Value());
+        });
+    });
+
+    std::promise<bool> primary;
+    std::promise<std::thread::id> primaryThread;
+    runtime.Dispatch([&primary, &primaryThread](Napi::Env env) {
+        primary.set_value(env.Global().Get("value").IsUndefined());
+        primaryThread.set_value(std::this_thread::get_id());
+    });
+
+    EXPECT_EQ(seen.get_future().get(), "undefined,42");
+    EXPECT_TRUE(primary.get_future().get());
+    EXPECT_EQ(firstThread.get_future().get(), primaryThread.get_future().get());
+}
+
+TEST(AppRuntime, ContextCanOutliveTheRuntime)
+{
+    if (!Babylon::AppRuntime::SupportsContexts())
+    {
+        GTEST_SKIP() << "The engine can't host several contexts";
+    }
+
+    auto runtime = std::make_unique<Babylon::AppRuntime>();
+    auto context = runtime->CreateContext();
+
+    std::promise<void> created;
+    context->Dispatch([&created](Napi::Env) {
+        created.set_value();
+    });
+    created.get_future().wait();
+
+    runtime.reset();
+
+    bool called{};
+    context->Dispatch([&called](Napi::Env) {
+        called = true;
+    });
+    context.reset();
+
+    EXPECT_FALSE(called);
+}
+
+namespace
+{
+    // Hops from the calling thread to the JavaScript thread, then awaits a
+    // resolved and a rejected promise there.
+    Babylon::Coroutine AwaitOnJavaScriptThread(Babylon::JsRuntime& runtime, std::promise<std::thread::id>& thread, std::promise<std::string>& result)
+    {
+        const Napi::Env env = co_await Babylon::JsRuntimeScheduler{runtime};
+        thread.set_value(std::this_thread::get_id());
+
+        const auto promiseConstructor = env.Global().Get("Promise").As<Napi::Object>();
+        const auto resolved = promiseConstructor.Get("resolve").As<Napi::Function>().Call(promiseConstructor, {Napi::Number::New(env, 42)}).As<Napi::Promise>();
+        std::string value = (co_await resolved).ToString().Utf8Value();
+
+        const auto rejected = promiseConstructor.Get("reject").As<Napi::Function>().Call(promiseConstructor, {Napi::Error::New(env, "nope").Value()}).As<Napi::Promise>();
+        try
+        {
+            co_await rejected;
+        }
+        catch (const Napi::Error& error)
+        {
+            value += "," + error.Message();
+        }
+
+        result.set_value(value);
+    }
+
+    // Throws before its first suspension, or once resumed on the JavaScript
+    // thread, with `anchor` in its frame.
+    Babylon::Coroutine ThrowFromCoroutine(Babylon::JsRuntime& runtime, [[maybe_unused]] std::shared_ptr<int> anchor, bool suspendFirst)
+    {
+        if (!suspendFirst)
+        {
+            throw std::runtime_error{"thrown before suspending"};
+        }
+
+        co_await Babylon::JsRuntimeScheduler{runtime};
+        throw std::runtime_error{"thrown once resumed"};
+    }
+
+    // Waits for `task` like fetch and XMLHttpRequest wait for their request.
+    Babylon::Coroutine AwaitTask(Babylon::JsRuntimeScheduler scheduler, arcana::task<void, std::exception_ptr> task, std::promise<void>& done)
+    {
+        co_await Babylon::TaskAwaiter{scheduler, std::move(task)};
+        done.set_value();
+    }
+
+    // Average heap allocations per call of `run`, which is handed a promise to
+    // fulfill once done.
+    template<typename RunT>
+    double CountAllocations(int iterations, RunT run)
+    {
+        size_t total{};
+        for (int i = 0; i < iterations; ++i)
+        {
+            std::promise<void> done;
+            auto finished = done.get_future();
+
+            g_allocations = 0;
+            g_countAllocations = true;
+            run(done);
+            finished.wait();
+            g_countAllocations = false;
+            total += g_allocations;
+        }
+        return static_cast<double>(total) / iterations;
+    }
+}
+
+TEST(JsRuntime, CoroutineHopsToJavaScriptThreadAndAwaitsPromises)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<Babylon::JsRuntime*> jsRuntime;
+    std::promise<std::thread::id> jsThread;
+    runtime.Dispatch([&jsRuntime, &jsThread](Napi::Env env) {
+        jsRuntime.set_value(&Babylon::JsRuntime::GetFromJavaScript(env));
+        jsThread.set_value(std::this_thread::get_id());
+    });
+
+    std::promise<std::thread::id> resumedOn;
+    std::promise<std::string> result;
+    AwaitOnJavaScriptThread(*jsRuntime.get_future().get(), resumedOn, result);
+
+    EXPECT_EQ(resumedOn.get_future().get(), jsThread.get_future().get());
+    EXPECT_EQ(result.get_future().get(), "42,nope");
+}
+
+TEST(JsRuntime, CoroutineFreesItselfWhenAnExceptionEscapes)
+{
+    std::promise<std::string> unhandled;
+    Babylon::AppRuntime::Options options{};
+    options.UnhandledExceptionHandler = [&unhandled](const Napi::Error& error) {
+        unhandled.set_value(error.Message());
+    };
+    Babylon::AppRuntime runtime{options};
+
+    std::promise<Babylon::JsRuntime*> jsRuntime;
+    runtime.Dispatch([&jsRuntime](Napi::Env env) {
+        jsRuntime.set_value(&Babylon::JsRuntime::GetFromJavaScript(env));
+    });
+    auto& js = *jsRuntime.get_future().get();
+
+    auto beforeSuspending = std::make_shared<int>();
+    const std::weak_ptr<int> beforeSuspendingFrame = beforeSuspending;
+    EXPECT_NO_THROW(ThrowFromCoroutine(js, std::move(beforeSuspending), false));
+    EXPECT_TRUE(beforeSuspendingFrame.expired());
+
+    // Rethrown as a Napi::Error from the dispatched callback that resumed it,
+    // once its frame is gone.
+    auto onceResumed = std::make_shared<int>();
+    const std::weak_ptr<int> onceResumedFrame = onceResumed;
+    ThrowFromCoroutine(js, std::move(onceResumed), true);
+    EXPECT_EQ(unhandled.get_future().get(), "thrown once resumed");
+    EXPECT_TRUE(onceResumedFrame.expired());
+}
+
+TEST(JsRuntime, CoroutineAllocatesLessThanContinuations)
+{
+    // Benchmarks what a request costs to wait for on the native side, the way
+    // fetch did it with continuations and does it now as a coroutine.
+    constexpr int Iterations{100};
+
+    Babylon::AppRuntime runtime{};
+
+    std::promise<Babylon::JsRuntime*> jsRuntime;
+    runtime.Dispatch([&jsRuntime](Napi::Env env) {
+        jsRuntime.set_value(&Babylon::JsRuntime::GetFromJavaScript(env));
+    });
+    auto& js = *jsRuntime.get_future().get();
+
+    const double continuations = CountAllocations(Iterations, [&js](std::promise<void>& done) {
+        arcana::task_completion_source<void, std::exception_ptr> request;
+
+        // A co-owned scheduler, the settling continuation, and one more to
+        // catch what it throws.
+        auto scheduler = std::make_shared<Babylon::JsRuntimeScheduler>(js);
+        request.as_task()
+            .then(*scheduler, arcana::cancellation::none(), [](const arcana::expected<void, std::exception_ptr>&) {
+            })
+            .then(*scheduler, arcana::cancellation::none(), [scheduler, &done](const arcana::expected<void, std::exception_ptr>&) {
+                done.set_value();
+            });
+
+        request.complete();
+    });
+
+    const double coroutine = CountAllocations(Iterations, [&js](std::promise<void>& done) {
+        arcana::task_completion_source<void, std::exception_ptr> request;
+        AwaitTask(Babylon::JsRuntimeScheduler{js}, request.as_task(), done);
+        request.complete();
+    });
+
+    std::cout << "Allocations per request: " << continuations << " with continuations, " << coroutine << " as a coroutine" << std::endl;
+    RecordProperty("ContinuationAllocations", std::to_string(continuations));
+    RecordProperty("CoroutineAllocations", std::to_string(coroutine));
+    EXPECT_LT(coroutine, continuations);
+}
+
+TEST(NodeApi, PropertyKeyRoundTrips)
+{
+    // Keyed access must observe exactly the same properties as named access,
+    // and a key must stay usable across dispatches for the life of the env.
+    Babylon::AppRuntime runtime{};
+
+    // Only touched on the JS thread; the second dispatch releases it there.
+    Napi::PropertyKey key;
+    std::promise<bool> roundTrips;
+    std::promise<bool> reusable;
+
+    runtime.Dispatch([&key, &roundTrips](Napi::Env env) {
+        key = Napi::PropertyKey::New(env, "answer");
+
+        auto object = Napi::Object::New(env);
+        const bool missingBefore = !object.Has(key);
+        object.Set(key, Napi::Number::New(env, 42));
+
+        roundTrips.set_value(
+            missingBefore &&
+            object.Has("answer") &&
+            object.Has(key) &&
+            object.Get(key).As<Napi::Number>().Int32Value() == 42 &&
+            key.Value().Utf8Value() == "answer");
+    });
+
+    runtime.Dispatch([&key, &reusable](Napi::Env env) {
+        auto object = Napi::Object::New(env);
+        object.Set("answer", Napi::String::New(env, "forty-two"));
+        reusable.set_value(object.Get(key).As<Napi::String>().Utf8Value() == "forty-two");
+        key = {};
+    });
+
+    EXPECT_TRUE(roundTrips.get_future().get());
+    EXPECT_TRUE(reusable.get_future().get());
+}
+
+TEST(NodeApi, SetManyGetManyMatchKeysByPosition)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<bool> matches;
+
+    runtime.Dispatch([&matches](Napi::Env env) {
+        const auto a = Napi::PropertyKey::New(env, "a");
+        const auto b = Napi::PropertyKey::New(env, "b");
+        const auto c = Napi::PropertyKey::New(env, "c");
+
+        auto object = Napi::Object::New(env);
+        object.SetMany({a, b, c}, {Napi::Number::New(env, 1), Napi::String::New(env, "two"), Napi::Boolean::New(env, true)});
+
+        const auto values = object.GetMany({c, a, b});
+        matches.set_value(
+            values.size() == 3 &&
+            values[0].As<Napi::Boolean>().Value() &&
+            values[1].As<Napi::Number>().Int32Value() == 1 &&
+            values[2].As<Napi::String>().Utf8Value() == "two" &&
+            object.Get("b").As<Napi::String>().Utf8Value() == "two");
+    });
+
+    EXPECT_TRUE(matches.get_future().get());
+}
+
+TEST(NodeApi, ObjectTemplateInstancesHaveTemplateKeys)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<bool> matches;
+
+    runtime.Dispatch([&matches](Napi::Env env) {
+        const auto x = Napi::PropertyKey::New(env, "x");
+        const auto y = Napi::PropertyKey::New(env, "y");
+        const auto point = Napi::ObjectTemplate::New(env, {x, y});
+
+        const Napi::Object first = point.NewInstance({Napi::Number::New(env, 1), Napi::Number::New(env, 2)});
+        const Napi::Object second = point.NewInstance({Napi::Number::New(env, 3), Napi::Number::New(env, 4)});
+
+        const auto keys = first.GetPropertyNames();
+        matches.set_value(
+            point.Size() == 2 &&
+            keys.Length() == 2 &&
+            keys.Get(0u).As<Napi::String>().Utf8Value() == "x" &&
+            keys.Get(1u).As<Napi::String>().Utf8Value() == "y" &&
+            first.Get(y).As<Napi::Number>().Int32Value() == 2 &&
+            second.Get(x).As<Napi::Number>().Int32Value() == 3);
+    });
+
+    EXPECT_TRUE(matches.get_future().get());
+}
+
+#if !defined(JSRUNTIMEHOST_NAPI_ENGINE_JSI)
+TEST(NodeApi, ExternalStringLatin1KeepsContentAndFinalizesCopies)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<bool> matches;
+
+    runtime.Dispatch([&matches](Napi::Env env) {
+        // Latin-1 "café", with a byte above 0x7F to catch UTF-8 misinterpretation.
+        static char latin1[] = "caf\xe9";
+        static bool finalized{};
+        finalized = false;
+
+        napi_value value{};
+        bool copied{};
+        const napi_status status = node_api_create_external_string_latin1(
+            env, latin1, 4, [](napi_env, void*, void*) { finalized = true; }, nullptr, &value, &copied);
+
+        matches.set_value(
+            status == napi_ok &&
+            (!copied || finalized) &&
+            Napi::String{env, value}.Utf8Value() == "caf\xc3\xa9");
+    });
+
+    EXPECT_TRUE(matches.get_future().get());
+}
+#endif
+
+#if !defined(JSRUNTIMEHOST_NAPI_ENGINE_JSI)
+TEST(NodeApi, Latin1RoundTripsNonAsciiBytes)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<bool> matches;
+
+    runtime.Dispatch([&matches](Napi::Env env) {
+        // Bytes above 0x7F must come back as single Latin-1 bytes, not UTF-8.
+        const std::string expected{"na\xefve caf\xe9 \xff"};
+
+        napi_value value{};
+        size_t length{};
+        std::string actual(expected.size() + 1, '\0');
+        size_t copied{};
+        const bool ok =
+            napi_create_string_latin1(env, expected.data(), expected.size(), &value) == napi_ok &&
+            napi_get_value_string_latin1(env, value, nullptr, 0, &length) == napi_ok &&
+            napi_get_value_string_latin1(env, value, actual.data(), actual.size(), &copied) == napi_ok;
+        actual.resize(copied);
+
+        matches.set_value(ok && length == expected.size() && actual == expected);
+    });
+
+    EXPECT_TRUE(matches.get_future().get());
+}
+#endif
+
+TEST(NodeApi, StringViewMatchesUtf8Value)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<bool> matches;
+
+    runtime.Dispatch([&matches](Napi::Env env) {
+        // Short ASCII, short non-ASCII, and longer than the view's inline buffer.
+        const std::string shortAscii{"content-type"};
+        const std::string shortUtf8{"caf\xc3\xa9 \xe2\x82\xac"};
+        const std::string longUtf8 = std::string(300, 'x') + shortUtf8;
+
+        bool allMatch = true;
+        for (const auto& expected : {shortAscii, shortUtf8, longUtf8})
+        {
+            const Napi::StringView view{Napi::String::New(env, expected)};
+            allMatch = allMatch && view.Value() == expected && view.Size() == expected.size();
+        }
+
+        matches.set_value(allMatch);
+    });
+
+    EXPECT_TRUE(matches.get_future().get());
+}
+
+#if !defined(JSRUNTIMEHOST_NAPI_ENGINE_JSI)
+TEST(NodeApi, Utf16RoundTripsAcrossVectorBlocks)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<bool> matches;
+
+    runtime.Dispatch([&matches](Napi::Env env) {
+        // Non-ASCII code units placed on and around 16/32-unit block boundaries,
+        // plus a surrogate pair, between long ASCII runs.
+        std::u16string expected(100, u'a');
+        expected[15] = u'\u00e9';
+        expected[31] = u'\u20ac';
+        expected[32] = u'\u4e2d';
+        expected[63] = u'\xd83d';
+        expected[64] = u'\xde00';
+
+        const auto utf16 = Napi::String::New(env, expected).Utf16Value();
+        const auto utf8 = Napi::String::New(env, expected).Utf8Value();
+        const auto fromUtf8 = Napi::String::New(env, utf8).Utf16Value();
+
+        matches.set_value(utf16 == expected && fromUtf8 == expected && utf8.size() == 95 + 2 + 3 + 3 + 4);
+    });
+
+    EXPECT_TRUE(matches.get_future().get());
+}
+
+TEST(SharedMemory, ViewsShareBytesAcrossRuntimes)
+{
+    // Each runtime gets its own view, but they are all over the same bytes, and
+    // structuredClone passes the memory on instead of copying it.
+    Babylon::AppRuntime writer{};
+    Babylon::AppRuntime reader{};
+
+    std::shared_ptr<Babylon::SharedMemory> memory;
+    std::promise<void> written;
+    std::promise<bool> read;
+
+    writer.Dispatch([&memory, &written](Napi::Env env) {
+        memory = Babylon::SharedMemory::Create(env, 16);
+        const auto array = env.Global().Get("Int32Array").As<Napi::Function>().New({memory->CreateView(env)});
+        array.Set(0u, Napi::Number::New(env, 42));
+        written.set_value();
+    });
+    written.get_future().wait();
+
+    reader.Dispatch([&memory, &read](Napi::Env env) {
+        Babylon::Polyfills::StructuredClone::Initialize(env);
+
+        const auto view = memory->CreateView(env);
+        const auto array = env.Global().Get("Int32Array").As<Napi::Function>().New({view});
+        const auto clone = env.Global().Get("structuredClone").As<Napi::Function>().Call({array}).As<Napi::TypedArray>();
+
+        read.set_value(
+            array.Get(0u).As<Napi::Number>().Int32Value() == 42 &&
+            Babylon::SharedMemory::GetFromJavaScript(view) == memory &&
+            Babylon::SharedMemory::GetFromJavaScript(clone.ArrayBuffer()) == memory);
+    });
+
+    EXPECT_TRUE(read.get_future().get());
+    EXPECT_EQ(reinterpret_cast<const int32_t*>(memory->Data())[0], 42);
+    EXPECT_EQ(memory->ByteLength(), 16u);
+}
+
+TEST(SharedMemory, AtomicsNotifyWakesWaiterInAnotherRuntime)
+{
+    Babylon::AppRuntime waiter{};
+    Babylon::AppRuntime notifier{};
+
+    std::shared_ptr<Babylon::SharedMemory> memory;
+    std::promise<bool> shared;
+    std::promise<std::string> waited;
+    std::promise<int32_t> woken;
+
+    waiter.Dispatch([&memory, &shared, &waited](Napi::Env env) {
+        memory = Babylon::SharedMemory::Create(env, 8);
+        env.Global().Set("memory", memory->CreateView(env));
+        env.Global().Set("done", Napi::Function::New(env, [&waited](const Napi::CallbackInfo& info) {
+            waited.set_value(info[0].ToString().Utf8Value());
+        }));
+        shared.set_value(env.Global().Get("memory").IsSharedArrayBuffer());
+    });
+
+    if (!shared.get_future().get())
+    {
+        GTEST_SKIP() << "The engine exposes shared memory as ArrayBuffers, which can't be waited on";
+    }
+
+    notifier.Dispatch([&memory, &woken](Napi::Env env) {
+        env.Global().Set("memory", memory->CreateView(env));
+        env.Global().Set("done", Napi::Function::New(env, [&woken](const Napi::CallbackInfo& info) {
+            woken.set_value(info[0].As<Napi::Number>().Int32Value());
+        }));
+    });
+
+    Babylon::ScriptLoader waiterLoader{waiter};
+    waiterLoader.Eval("done(Atomics.wait(new Int32Array(memory), 1, 0, 10000));", "");
+
+    // Notifies until the waiter is actually waiting, so the wake isn't lost.
+    Babylon::ScriptLoader notifierLoader{notifier};
+    notifierLoader.Eval(R"(
+        const array = new Int32Array(memory);
+        const end = Date.now() + 10000;
+        let count = 0;
+        while (count === 0 && Date.now() < end) {
+            count = Atomics.notify(array, 1);
+        }
+        done(count);
+    )", "");
+
+    EXPECT_EQ(woken.get_future().get(), 1);
+    EXPECT_EQ(waited.get_future().get(), "ok");
+}
+
+// Benchmark, run explicitly with --gtest_also_run_disabled_tests.
+TEST(NodeApi, DISABLED_StringTranscodingThroughput)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<void> done;
+
+    runtime.Dispatch([&done](Napi::Env env) {
+        constexpr size_t length = 1 << 20;
+        constexpr int iterations = 20;
+        using clock = std::chrono::steady_clock;
+
+        const auto report = [](const char* name, clock::duration elapsed) {
+            const double seconds = std::chrono::duration<double>(elapsed).count();
+            std::cout << name << ": " << (iterations * length / seconds / (1 << 20)) << " MiB/s" << std::endl;
+        };
+
+        std::u16string ascii(length, u'x');
+        std::u16string mixed(length, u'x');
+        for (size_t i = 0; i < length; i += 64)
+        {
+            mixed[i] = u'\u00e9';
+        }
+
+        for (const auto& [name, text] : {std::pair{"ascii", &ascii}, std::pair{"mixed", &mixed}})
+        {
+            auto start = clock::now();
+            for (int i = 0; i < iterations; ++i)
+            {
+                Napi::HandleScope scope{env};
+                Napi::String::New(env, *text);
+            }
+            report((std::string{"create utf16 "} + name).c_str(), clock::now() - start);
+
+            const auto value = Napi::String::New(env, *text);
+            start = clock::now();
+            for (int i = 0; i < iterations; ++i)
+            {
+                value.Utf16Value();
+            }
+            report((std::string{"read utf16 "} + name).c_str(), clock::now() - start);
+        }
+
+        done.set_value();
+    });
+
+    done.get_future().wait();
+}
+#endif
+
+// Benchmark, run explicitly with --gtest_also_run_disabled_tests.
+TEST(NodeApi, DISABLED_ObjectTemplateVersusSet)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<void> done;
+
+    runtime.Dispatch([&done](Napi::Env env) {
+        constexpr int iterations = 100000;
+        using clock = std::chrono::steady_clock;
+
+        const auto a = Napi::PropertyKey::New(env, "a");
+        const auto b = Napi::PropertyKey::New(env, "b");
+        const auto c = Napi::PropertyKey::New(env, "c");
+        const auto d = Napi::PropertyKey::New(env, "d");
+        const auto shape = Napi::ObjectTemplate::New(env, {a, b, c, d});
+
+        const auto value = Napi::Number::New(env, 1);
+
+        auto start = clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            Napi::HandleScope scope{env};
+            auto object = Napi::Object::New(env);
+            object.Set("a", value);
+            object.Set("b", value);
+            object.Set("c", value);
+            object.Set("d", value);
+        }
+        const auto setTime = clock::now() - start;
+
+        start = clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            Napi::HandleScope scope{env};
+            shape.NewInstance({value, value, value, value});
+        }
+        const auto templateTime = clock::now() - start;
+
+        std::cout << "Object::New + Set: " << std::chrono::duration_cast<std::chrono::microseconds>(setTime).count() << "us, "
+                  << "ObjectTemplate::NewInstance: " << std::chrono::duration_cast<std::chrono::microseconds>(templateTime).count() << "us"
+                  << " (" << iterations << " objects)" << std::endl;
+
+        done.set_value();
+    });
+
+    done.get_future().wait();
+}
+
+// Benchmark, run explicitly with --gtest_also_run_disabled_tests.
+TEST(Scheduling, DISABLED_TimerStorm)
+{
+    Babylon::AppRuntime runtime{};
+
+    std::promise<std::string> done;
+
+    runtime.Dispatch([&done](Napi::Env env) {
+        Babylon::Polyfills::Scheduling::Initialize(env);
+
+        env.Global().Set("done", Napi::Function::New(env, [&done](const Napi::CallbackInfo& info) {
+            done.set_value(info[0].ToString().Utf8Value());
+        }));
+    });
+
+    // Debounce- and tween-like load: long timers that are mostly cleared
+    // before they fire, then a burst of short ones.
+    Babylon::ScriptLoader loader{runtime};
+    loader.Eval(R"(
+        const count = 50000;
+        const start = Date.now();
+        let fired = 0;
+        let pending = 0;
+        for (let i = 0; i < count; ++i) {
+            const id = setTimeout(() => {}, 1000 + i % 100);
+            if (i % 2 === 0) {
+                clearTimeout(id);
+            }
+        }
+        const scheduled = Date.now();
+        for (let i = 0; i < count; ++i) {
+            ++pending;
+            setTimeout(() => {
+                ++fired;
+                if (--pending === 0) {
+                    done(`${count} timers set and half cleared in ${scheduled - start}ms, ${fired} short timers fired after ${Date.now() - start}ms`);
+                }
+            }, i % 50);
+        }
+    )", "");
+
+    std::cout << "Timer storm: " << done.get_future().get() << std::endl;
+}
+
 int RunTests()
 {
     testing::InitGoogleTest();